@@ -0,0 +1,234 @@
+/// \file Atlas.c
+/// \author Paolo Mazzon
+#include "VK2D/Atlas.h"
+#include "VK2D/Texture.h"
+#include "VK2D/Image.h"
+#include "VK2D/Renderer.h"
+#include "VK2D/LogicalDevice.h"
+#include "VK2D/Validation.h"
+#include "VK2D/Util.h"
+#include "VK2D/Opaque.h"
+#include "VK2D/stb_image.h"
+#include <malloc.h>
+#include <stdlib.h>
+#include <string.h>
+
+unsigned char* _vk2dMapFile(const char *filename, uint32_t *size, void **mapping);
+void _vk2dUnmapFile(unsigned char *data, void *mapping);
+
+// Gap in pixels left around every packed image so linear filtering can't bleed neighbours in
+#define VK2D_ATLAS_PADDING 1
+
+// A decoded source image waiting to be packed
+typedef struct VK2DAtlasSource {
+	void *pixels; ///< Decoded RGBA pixels, NULL if the image failed to load
+	int w;        ///< Width of the image in pixels
+	int h;        ///< Height of the image in pixels
+	int x;        ///< X the packer placed this image at in the atlas
+	int y;        ///< Y the packer placed this image at in the atlas
+	uint32_t index; ///< Which input slot this image came from
+} VK2DAtlasSource;
+
+static int _vk2dAtlasCompareHeight(const void *left, const void *right) {
+	return ((VK2DAtlasSource*)right)->h - ((VK2DAtlasSource*)left)->h;
+}
+
+// Shelf-packs the sources (which must be sorted tallest-first so shelves waste little
+// space) into an atlas of the given width, returning the height used
+static uint32_t _vk2dAtlasPack(VK2DAtlasSource *sources, uint32_t count, uint32_t width) {
+	uint32_t shelfX = 0;
+	uint32_t shelfY = 0;
+	uint32_t shelfHeight = 0;
+	uint32_t i;
+	for (i = 0; i < count; i++) {
+		if (sources[i].pixels == NULL)
+			continue;
+		uint32_t w = sources[i].w + VK2D_ATLAS_PADDING;
+		uint32_t h = sources[i].h + VK2D_ATLAS_PADDING;
+		if (shelfX + w > width) {
+			shelfY += shelfHeight;
+			shelfX = 0;
+			shelfHeight = 0;
+		}
+		sources[i].x = shelfX;
+		sources[i].y = shelfY;
+		shelfX += w;
+		if (h > shelfHeight)
+			shelfHeight = h;
+	}
+	return shelfY + shelfHeight;
+}
+
+// Packs the decoded sources, composites them into one image and wraps it in a texture,
+// freeing each source's pixels along the way (but not the sources array itself)
+static VK2DAtlas _vk2dAtlasBuild(VK2DAtlasSource *sources, uint32_t count) {
+	VK2DAtlas out = NULL;
+	uint32_t totalArea = 0;
+	uint32_t widest = 0;
+	uint32_t i;
+
+	for (i = 0; i < count; i++) {
+		if (sources[i].pixels != NULL) {
+			totalArea += (sources[i].w + VK2D_ATLAS_PADDING) * (sources[i].h + VK2D_ATLAS_PADDING);
+			if ((uint32_t)sources[i].w + VK2D_ATLAS_PADDING > widest)
+				widest = sources[i].w + VK2D_ATLAS_PADDING;
+		}
+	}
+
+	if (totalArea != 0) {
+		// Power-of-two width roughly as large as the square root of the total area so
+		// the atlas comes out near-square, but never narrower than the widest image
+		uint32_t width = 1;
+		while (width < widest || width * width < totalArea)
+			width *= 2;
+
+		qsort(sources, count, sizeof(VK2DAtlasSource), _vk2dAtlasCompareHeight);
+		uint32_t height = _vk2dAtlasPack(sources, count, width);
+
+		out = malloc(sizeof(struct VK2DAtlas_t));
+		VK2DAtlasEntry *entries = calloc(count, sizeof(VK2DAtlasEntry));
+		uint8_t *pixels = calloc(1, (size_t)width * height * 4);
+
+		if (vk2dPointerCheck(out) && vk2dPointerCheck(entries) && vk2dPointerCheck(pixels)) {
+			for (i = 0; i < count; i++) {
+				if (sources[i].pixels == NULL)
+					continue;
+				int row;
+				for (row = 0; row < sources[i].h; row++)
+					memcpy(&pixels[(((size_t)sources[i].y + row) * width + sources[i].x) * 4],
+						   &((uint8_t*)sources[i].pixels)[(size_t)row * sources[i].w * 4],
+						   (size_t)sources[i].w * 4);
+				entries[sources[i].index].xInTex = sources[i].x;
+				entries[sources[i].index].yInTex = sources[i].y;
+				entries[sources[i].index].texWidth = sources[i].w;
+				entries[sources[i].index].texHeight = sources[i].h;
+			}
+
+			VK2DImage image = vk2dImageFromPixels(vk2dRendererGetDevice(), pixels, width, height, true);
+			VK2DTexture tex = image == NULL ? NULL : vk2dTextureLoadFromImage(image);
+			if (tex != NULL) {
+				tex->imgHandled = true;
+				out->tex = tex;
+				out->entries = entries;
+				out->entryCount = count;
+			} else {
+				if (image != NULL)
+					vk2dImageFree(image);
+				vk2dLogMessage("Failed to create atlas texture of size %ix%i.", width, height);
+				free(entries);
+				free(out);
+				out = NULL;
+			}
+		} else {
+			free(entries);
+			free(out);
+			out = NULL;
+		}
+		free(pixels);
+	} else {
+		vk2dLogMessage("No images could be loaded for the atlas.");
+	}
+
+	for (i = 0; i < count; i++)
+		if (sources[i].pixels != NULL)
+			stbi_image_free(sources[i].pixels);
+
+	return out;
+}
+
+VK2DAtlas vk2dAtlasLoad(const char **filenames, uint32_t count) {
+	VK2DAtlas out = NULL;
+
+	if (vk2dRendererGetPointer() != NULL) {
+		VK2DAtlasSource *sources = calloc(count, sizeof(VK2DAtlasSource));
+
+		if (vk2dPointerCheck(sources) && count != 0) {
+			uint32_t i;
+			for (i = 0; i < count; i++) {
+				uint32_t size;
+				void *mapping;
+				void *data = _vk2dMapFile(filenames[i], &size, &mapping);
+				int channels;
+				if (data != NULL) {
+					sources[i].pixels = stbi_load_from_memory(data, size, &sources[i].w, &sources[i].h, &channels, 4);
+					_vk2dUnmapFile(data, mapping);
+				}
+				if (sources[i].pixels == NULL)
+					vk2dLogMessage("Failed to load image \"%s\" for atlas.", filenames[i]);
+				sources[i].index = i;
+			}
+			out = _vk2dAtlasBuild(sources, count);
+		}
+		free(sources);
+	} else {
+		vk2dLogMessage("Renderer is not initialized");
+	}
+
+	return out;
+}
+
+VK2DAtlas vk2dAtlasFrom(VK2DAssetLoad *assets, uint32_t count) {
+	VK2DAtlas out = NULL;
+
+	if (vk2dRendererGetPointer() != NULL) {
+		VK2DAtlasSource *sources = calloc(count, sizeof(VK2DAtlasSource));
+
+		if (vk2dPointerCheck(sources) && count != 0) {
+			uint32_t i;
+			for (i = 0; i < count; i++) {
+				int channels;
+				if (assets[i].type == VK2D_ASSET_TYPE_TEXTURE_FILE) {
+					uint32_t size;
+					void *mapping;
+					void *data = _vk2dMapFile(assets[i].Load.filename, &size, &mapping);
+					if (data != NULL) {
+						sources[i].pixels = stbi_load_from_memory(data, size, &sources[i].w, &sources[i].h, &channels, 4);
+						_vk2dUnmapFile(data, mapping);
+					}
+					if (sources[i].pixels == NULL)
+						vk2dLogMessage("Failed to load image \"%s\" for atlas.", assets[i].Load.filename);
+				} else if (assets[i].type == VK2D_ASSET_TYPE_TEXTURE_MEMORY) {
+					sources[i].pixels = stbi_load_from_memory(assets[i].Load.data, assets[i].Load.size, &sources[i].w, &sources[i].h, &channels, 4);
+					if (sources[i].pixels == NULL)
+						vk2dLogMessage("Failed to load image from data of size %i for atlas.", assets[i].Load.size);
+				}
+				sources[i].index = i;
+			}
+			out = _vk2dAtlasBuild(sources, count);
+		}
+		free(sources);
+	} else {
+		vk2dLogMessage("Renderer is not initialized");
+	}
+
+	return out;
+}
+
+VK2DTexture vk2dAtlasGetTexture(VK2DAtlas atlas) {
+	return atlas->tex;
+}
+
+VK2DAtlasEntry vk2dAtlasGetEntry(VK2DAtlas atlas, uint32_t index) {
+	if (index < atlas->entryCount)
+		return atlas->entries[index];
+	vk2dLogMessage("Atlas entry %i is out of range, atlas only has %i entries.", index, atlas->entryCount);
+	VK2DAtlasEntry entry = {0};
+	return entry;
+}
+
+uint32_t vk2dAtlasGetEntryCount(VK2DAtlas atlas) {
+	return atlas->entryCount;
+}
+
+void vk2dAtlasDraw(VK2DAtlas atlas, uint32_t index, float x, float y) {
+	VK2DAtlasEntry entry = vk2dAtlasGetEntry(atlas, index);
+	vk2dRendererDrawTexture(atlas->tex, x, y, 1, 1, 0, 0, 0, entry.xInTex, entry.yInTex, entry.texWidth, entry.texHeight);
+}
+
+void vk2dAtlasFree(VK2DAtlas atlas) {
+	if (atlas != NULL) {
+		vk2dTextureFree(atlas->tex);
+		free(atlas->entries);
+		free(atlas);
+	}
+}
@@ -0,0 +1,71 @@
+/// \file Atlas.h
+/// \author Paolo Mazzon
+/// \brief Packs many small images into one texture so they can be drawn without texture switches
+#pragma once
+#include "VK2D/Structs.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// \brief Packs a list of image files into a single texture
+/// \param filenames Array of image filenames (png, bmp, jpg, tiff)
+/// \param count Number of filenames in the array
+/// \return Returns a new atlas or NULL if it failed
+///
+/// Entry `i` of the atlas corresponds to `filenames[i]`. Files that fail to load
+/// get a zeroed-out entry and the rest of the atlas is built without them.
+///
+/// Because every sub-image lives in the same texture, draws through the atlas never
+/// switch descriptor sets - with batching or the render queue enabled they all merge
+/// into single instanced draws no matter how many different sprites are on screen.
+VK2DAtlas vk2dAtlasLoad(const char **filenames, uint32_t count);
+
+/// \brief Same as vk2dAtlasLoad but sources images from a VK2DAssetLoad array
+/// \param assets Array of VK2DAssetLoad structs, only texture-type entries are packed
+/// \param count Number of structs in the array
+/// \return Returns a new atlas or NULL if it failed
+///
+/// Entry `i` of the atlas corresponds to `assets[i]`; model and shader entries (and
+/// textures that fail to load) get a zeroed-out entry. The structs are only read for
+/// their load information - their output pointers are not written to, since the atlas
+/// owns the one texture all the sub-images share.
+VK2DAtlas vk2dAtlasFrom(VK2DAssetLoad *assets, uint32_t count);
+
+/// \brief Returns the texture every sub-image in the atlas lives in
+/// \param atlas Atlas to get the texture from
+/// \return Returns the atlas texture
+VK2DTexture vk2dAtlasGetTexture(VK2DAtlas atlas);
+
+/// \brief Returns where a source image ended up in the atlas
+/// \param atlas Atlas to pull from
+/// \param index Index of the source image in the list the atlas was built from
+/// \return Returns the entry, or a zeroed-out entry if the index is out of range
+///
+/// The entry's fields plug straight into the UV parameters of vk2dRendererDrawTexture,
+/// for example
+///
+///     VK2DAtlasEntry e = vk2dAtlasGetEntry(atlas, 12);
+///     vk2dRendererDrawTexture(vk2dAtlasGetTexture(atlas), x, y, 1, 1, 0, 0, 0,
+///             e.xInTex, e.yInTex, e.texWidth, e.texHeight);
+VK2DAtlasEntry vk2dAtlasGetEntry(VK2DAtlas atlas, uint32_t index);
+
+/// \brief Returns the number of entries in the atlas
+/// \param atlas Atlas to check
+/// \return Returns the entry count (the size of the list the atlas was built from)
+uint32_t vk2dAtlasGetEntryCount(VK2DAtlas atlas);
+
+/// \brief Draws a sub-image of the atlas, shorthand for vk2dRendererDrawTexture with the entry's UVs
+/// \param atlas Atlas to draw from
+/// \param index Index of the sub-image in the atlas
+/// \param x X position to draw at
+/// \param y Y position to draw at
+void vk2dAtlasDraw(VK2DAtlas atlas, uint32_t index, float x, float y);
+
+/// \brief Frees an atlas, its texture and its entries from memory
+/// \param atlas Atlas to free
+void vk2dAtlasFree(VK2DAtlas atlas);
+
+#ifdef __cplusplus
+};
+#endif
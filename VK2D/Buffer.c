@@ -35,6 +35,30 @@ VK2DBuffer vk2dBufferCreate(VK2DLogicalDevice dev, VkDeviceSize size, VkBufferUs
 	return buf;
 }
 
+VK2DBuffer vk2dBufferCreateShared(VK2DLogicalDevice dev, VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags mem) {
+	VK2DRenderer gRenderer = vk2dRendererGetPointer();
+	VK2DBuffer buf = malloc(sizeof(struct VK2DBuffer_t));
+
+	if (vk2dPointerCheck(buf)) {
+		buf->dev = dev;
+		buf->size = size;
+
+		// Staging copies may run on a dedicated transfer queue, so the buffer is shared
+		// between the graphics and transfer families when the host keeps them separate
+		uint32_t families[] = {dev->pd->QueueFamily.graphicsFamily, dev->pd->QueueFamily.transferFamily};
+		VkBufferCreateInfo bufferCreateInfo = vk2dInitBufferCreateInfo(size, usage, families, 2);
+		if (families[0] != families[1])
+			bufferCreateInfo.sharingMode = VK_SHARING_MODE_CONCURRENT;
+		else
+			bufferCreateInfo.queueFamilyIndexCount = 1;
+		VmaAllocationCreateInfo allocationCreateInfo = {0};
+		allocationCreateInfo.requiredFlags = mem;
+		vk2dErrorCheck(vmaCreateBuffer(gRenderer->vma, &bufferCreateInfo, &allocationCreateInfo, &buf->buf, &buf->mem, VK_NULL_HANDLE));
+	}
+
+	return buf;
+}
+
 VK2DBuffer vk2dBufferLoad(VK2DLogicalDevice dev, VkDeviceSize size, VkBufferUsageFlags usage, void *data, bool mainThread) {
 	VK2DRenderer gRenderer = vk2dRendererGetPointer();
 	// Create staging buffer
@@ -89,6 +113,43 @@ VK2DBuffer vk2dBufferLoad2(VK2DLogicalDevice dev, VkDeviceSize size, VkBufferUsa
 	return ret;
 }
 
+VK2DBuffer vk2dBufferCreateStorage(VK2DLogicalDevice dev, VkDeviceSize size, void *data) {
+	VK2DRenderer gRenderer = vk2dRendererGetPointer();
+	VK2DBuffer buf = malloc(sizeof(struct VK2DBuffer_t));
+
+	if (vk2dPointerCheck(buf)) {
+		buf->dev = dev;
+		buf->size = size;
+
+		// Compute dispatches may run on a different queue family than drawing, so the
+		// buffer is shared between both families when the host keeps them separate
+		uint32_t families[] = {dev->pd->QueueFamily.graphicsFamily, dev->pd->QueueFamily.computeFamily};
+		VkBufferCreateInfo bufferCreateInfo = vk2dInitBufferCreateInfo(size,
+				VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+				families, 2);
+		if (families[0] != families[1])
+			bufferCreateInfo.sharingMode = VK_SHARING_MODE_CONCURRENT;
+		else
+			bufferCreateInfo.queueFamilyIndexCount = 1;
+		VmaAllocationCreateInfo allocationCreateInfo = {0};
+		allocationCreateInfo.requiredFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+		vk2dErrorCheck(vmaCreateBuffer(gRenderer->vma, &bufferCreateInfo, &allocationCreateInfo, &buf->buf, &buf->mem, VK_NULL_HANDLE));
+
+		if (data != NULL) {
+			VK2DBuffer stageBuffer = vk2dBufferCreate(dev, size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+					VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+			void *location;
+			vk2dErrorCheck(vmaMapMemory(gRenderer->vma, stageBuffer->mem, &location));
+			memcpy(location, data, size);
+			vmaUnmapMemory(gRenderer->vma, stageBuffer->mem);
+			vk2dBufferCopy(stageBuffer, buf, true);
+			vk2dBufferFree(stageBuffer);
+		}
+	}
+
+	return buf;
+}
+
 void vk2dBufferCopy(VK2DBuffer src, VK2DBuffer dst, bool mainThread) {
 	VkCommandBuffer buffer = vk2dLogicalDeviceGetSingleUseBuffer(src->dev, mainThread);
 	VkBufferCopy copyRegion = {0};
@@ -18,6 +18,14 @@ extern "C" {
 /// \return Returns the new buffer or NULL if it failed
 VK2DBuffer vk2dBufferCreate(VK2DLogicalDevice dev, VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags mem);
 
+/// \brief Same as vk2dBufferCreate but the buffer may also be used from the device's transfer queue
+/// \param dev Device to get the memory from
+/// \param size Size in bytes of the new buffer
+/// \param usage How the buffer will be used
+/// \param mem Required memory properties (device local, host visible, etc...)
+/// \return Returns the new buffer or NULL if it failed
+VK2DBuffer vk2dBufferCreateShared(VK2DLogicalDevice dev, VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags mem);
+
 /// \brief Creates a buffer and loads some data into high-performance memory
 /// \param dev Device to get the memory from
 /// \param size Size in bytes of data
@@ -36,6 +44,18 @@ VK2DBuffer vk2dBufferLoad(VK2DLogicalDevice dev, VkDeviceSize size, VkBufferUsag
 /// \return Returns a new buffer with the data loaded or NULL if it failed
 VK2DBuffer vk2dBufferLoad2(VK2DLogicalDevice dev, VkDeviceSize size, VkBufferUsageFlags usage, void *data, VkDeviceSize size2, void *data2, bool mainThread);
 
+/// \brief Creates a device-local storage buffer for compute shaders
+/// \param dev Device to get the memory from
+/// \param size Size in bytes of the new buffer
+/// \param data Data to seed the buffer with, or NULL to leave it uninitialized
+/// \return Returns the new buffer or NULL if it failed
+///
+/// Buffers created this way may be bound to compute dispatches and are also valid
+/// vertex and indirect buffers, so compute output can feed straight into drawing.
+/// If the host keeps compute on a separate queue family the buffer is shared
+/// between both families automatically.
+VK2DBuffer vk2dBufferCreateStorage(VK2DLogicalDevice dev, VkDeviceSize size, void *data);
+
 /// \brief Copies the entire contents of src into dst
 /// \param src Buffer to copy from
 /// \param dst Buffer to copy to
@@ -0,0 +1,137 @@
+/// \file Bundle.c
+/// \author Paolo Mazzon
+#include "VK2D/Bundle.h"
+#include "VK2D/Validation.h"
+#include "VK2D/Constants.h"
+#include "VK2D/Util.h"
+#include "VK2D/Opaque.h"
+#include <malloc.h>
+#include <string.h>
+#include <stdio.h>
+
+static const char *VK2D_BUNDLE_MAGIC = "VK2DBNDL";
+#define VK2D_BUNDLE_VERSION 1
+
+bool vk2dBundlePack(const char *bundleFilename, const char **filenames, const char **names, uint32_t count) {
+	bool success = true;
+	uint32_t i;
+
+	// Names must fit the fixed-size index entries
+	for (i = 0; i < count && success; i++) {
+		const char *name = names != NULL ? names[i] : filenames[i];
+		if (strlen(name) >= VK2D_BUNDLE_NAME_MAX) {
+			vk2dLogMessage("Bundle entry name \"%s\" is too long, must be shorter than %i characters.", name, VK2D_BUNDLE_NAME_MAX);
+			success = false;
+		}
+	}
+
+	VK2DBundleEntry *entries = calloc(count, sizeof(VK2DBundleEntry));
+	FILE *file = success ? fopen(bundleFilename, "wb") : NULL;
+
+	if (vk2dPointerCheck(entries) && file != NULL) {
+		// The index is written twice - once now to reserve its spot, again once offsets are known
+		VK2DBundleHeader header = {0};
+		memcpy(header.magic, VK2D_BUNDLE_MAGIC, 8);
+		header.version = VK2D_BUNDLE_VERSION;
+		header.count = count;
+		fwrite(&header, sizeof(VK2DBundleHeader), 1, file);
+		fwrite(entries, sizeof(VK2DBundleEntry), count, file);
+
+		// Entry data back-to-back after the index
+		uint32_t offset = sizeof(VK2DBundleHeader) + (count * sizeof(VK2DBundleEntry));
+		for (i = 0; i < count && success; i++) {
+			uint32_t size;
+			void *mapping;
+			uint8_t *data = _vk2dMapFile(filenames[i], &size, &mapping);
+			if (data != NULL && size != 0) {
+				strncpy(entries[i].name, names != NULL ? names[i] : filenames[i], VK2D_BUNDLE_NAME_MAX - 1);
+				entries[i].offset = offset;
+				entries[i].size = size;
+				fwrite(data, 1, size, file);
+				offset += size;
+				_vk2dUnmapFile(data, mapping);
+			} else {
+				vk2dLogMessage("Failed to pack \"%s\" into bundle \"%s\".", filenames[i], bundleFilename);
+				success = false;
+			}
+		}
+
+		// Now the real index
+		if (success) {
+			fseek(file, sizeof(VK2DBundleHeader), SEEK_SET);
+			fwrite(entries, sizeof(VK2DBundleEntry), count, file);
+		}
+	} else if (file == NULL && success) {
+		vk2dLogMessage("Failed to open bundle \"%s\" for writing.", bundleFilename);
+		success = false;
+	}
+
+	if (file != NULL)
+		fclose(file);
+	free(entries);
+	return success;
+}
+
+VK2DBundle vk2dBundleOpen(const char *filename) {
+	VK2DBundle out = malloc(sizeof(struct VK2DBundle_t));
+
+	if (vk2dPointerCheck(out)) {
+		uint32_t i;
+		bool valid = false;
+		out->data = _vk2dMapFile(filename, &out->size, &out->mapping);
+
+		// The whole index is validated up front so lookups can trust it
+		if (out->data != NULL && out->size >= sizeof(VK2DBundleHeader)) {
+			const VK2DBundleHeader *header = (const VK2DBundleHeader*)out->data;
+			valid = memcmp(header->magic, VK2D_BUNDLE_MAGIC, 8) == 0 &&
+					header->version == VK2D_BUNDLE_VERSION &&
+					sizeof(VK2DBundleHeader) + ((uint64_t)header->count * sizeof(VK2DBundleEntry)) <= out->size;
+			if (valid) {
+				out->entryCount = header->count;
+				out->entries = (const VK2DBundleEntry*)(out->data + sizeof(VK2DBundleHeader));
+				for (i = 0; i < out->entryCount && valid; i++)
+					valid = out->entries[i].name[VK2D_BUNDLE_NAME_MAX - 1] == 0 &&
+							(uint64_t)out->entries[i].offset + out->entries[i].size <= out->size;
+			}
+		}
+
+		if (!valid) {
+			vk2dLogMessage("\"%s\" is not a valid bundle.", filename);
+			_vk2dUnmapFile(out->data, out->mapping);
+			free(out);
+			out = NULL;
+		}
+	}
+
+	return out;
+}
+
+const void *vk2dBundleGet(VK2DBundle bundle, const char *name, uint32_t *size) {
+	*size = 0;
+	if (bundle != NULL) {
+		for (uint32_t i = 0; i < bundle->entryCount; i++) {
+			if (strcmp(bundle->entries[i].name, name) == 0) {
+				*size = bundle->entries[i].size;
+				return bundle->data + bundle->entries[i].offset;
+			}
+		}
+	}
+	return NULL;
+}
+
+uint32_t vk2dBundleGetEntryCount(VK2DBundle bundle) {
+	return bundle != NULL ? bundle->entryCount : 0;
+}
+
+const char *vk2dBundleGetEntryName(VK2DBundle bundle, uint32_t index) {
+	if (bundle != NULL && index < bundle->entryCount)
+		return bundle->entries[index].name;
+	return NULL;
+}
+
+void vk2dBundleClose(VK2DBundle bundle) {
+	if (bundle != NULL) {
+		_vk2dUnmapFile(bundle->data, bundle->mapping);
+		free(bundle);
+	}
+}
@@ -0,0 +1,55 @@
+/// \file Bundle.h
+/// \author Paolo Mazzon
+/// \brief Packed asset bundles so many small assets load through one file
+#pragma once
+#include "VK2D/Structs.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// \brief Packs a list of files into a bundle on disk
+/// \param bundleFilename Filename the bundle will be written to
+/// \param filenames List of files to pack into the bundle
+/// \param names Name each entry is stored under, or NULL to store them under their filenames
+/// \return Returns true if every file was packed
+///
+/// Entry names (including the null terminator) must be shorter than VK2D_BUNDLE_NAME_MAX
+/// characters. Typically bundles are packed once by your build pipeline and shipped, but
+/// nothing stops you from packing them at runtime.
+bool vk2dBundlePack(const char *bundleFilename, const char **filenames, const char **names, uint32_t count);
+
+/// \brief Opens a bundle, mapping the whole file into memory in one go
+/// \param filename Bundle file to open
+/// \return Returns the open bundle or NULL if the file is missing or not a valid bundle
+///
+/// However many assets the bundle holds, opening it costs a single open/map - entries
+/// are handed out as pointers into the mapping without any copies or further file access.
+VK2DBundle vk2dBundleOpen(const char *filename);
+
+/// \brief Finds an entry in a bundle by name
+/// \param bundle Bundle to search
+/// \param name Name the entry was packed under
+/// \param size Is set to the entry's size in bytes
+/// \return Returns a pointer to the entry's data, or NULL if there is no such entry
+///
+/// The pointer points into the bundle's mapping and is only valid until the bundle
+/// is closed - don't free it.
+const void *vk2dBundleGet(VK2DBundle bundle, const char *name, uint32_t *size);
+
+/// \brief Returns the number of entries in a bundle
+uint32_t vk2dBundleGetEntryCount(VK2DBundle bundle);
+
+/// \brief Returns the name of the entry at an index for enumeration, NULL if out of range
+const char *vk2dBundleGetEntryName(VK2DBundle bundle, uint32_t index);
+
+/// \brief Closes a bundle, unmapping the file
+/// \param bundle Bundle to close
+///
+/// Every pointer handed out by vk2dBundleGet dies with the bundle, so don't close it
+/// while assets referencing it are still loading.
+void vk2dBundleClose(VK2DBundle bundle);
+
+#ifdef __cplusplus
+};
+#endif
@@ -9,6 +9,13 @@
 
 void _vk2dCameraUpdateUBO(VK2DUniformBufferObject *ubo, VK2DCameraSpec *camera);
 void _vk2dRendererFlushUBOBuffer(uint32_t frame, int camera);
+bool _vk2dRendererDeferFree(void (*freeFunc)(void*), void *resource);
+
+// Deferred frees hand the resource over as a void pointer
+static void _vk2dCameraDestroyBuffer(void *buffer) {
+	vk2dBufferFree(buffer);
+}
+
 VK2DCameraIndex vk2dCameraCreate(VK2DCameraSpec spec) {
 	VK2DRenderer gRenderer = vk2dRendererGetPointer();
 	VK2DCameraIndex position = VK2D_INVALID_CAMERA;
@@ -29,13 +36,19 @@ VK2DCameraIndex vk2dCameraCreate(VK2DCameraSpec spec) {
 			// Create the lists first
 			cam->ubos = calloc(1, sizeof(VK2DUniformBufferObject) * gRenderer->swapchainImageCount);
 			cam->uboSets = malloc(sizeof(VkDescriptorSet) * gRenderer->swapchainImageCount);
+			cam->uboBuffers = malloc(sizeof(VK2DBuffer) * gRenderer->swapchainImageCount);
+			cam->uboDirty = malloc(sizeof(bool) * gRenderer->swapchainImageCount);
 			vk2dPointerCheck(cam->ubos);
 			vk2dPointerCheck(cam->uboSets);
+			vk2dPointerCheck(cam->uboBuffers);
+			vk2dPointerCheck(cam->uboDirty);
 
-			// Populate the lists
+			// Populate the lists - the dirty flags make sure each image's buffer uploads on its first frame
 			for (int i = 0; i < gRenderer->swapchainImageCount; i++) {
 				_vk2dCameraUpdateUBO(&cam->ubos[i], &spec);
-				cam->uboSets[i] = vk2dDescConGetSet(gRenderer->descConVP);
+				cam->uboBuffers[i] = vk2dBufferCreate(gRenderer->ld, sizeof(VK2DUniformBufferObject), VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+				cam->uboSets[i] = vk2dDescConGetBufferSet(gRenderer->descConVP, cam->uboBuffers[i]);
+				cam->uboDirty[i] = true;
 			}
 		} else {
 			vk2dLogMessage("Cannot create more cameras");
@@ -57,6 +70,11 @@ void vk2dCameraUpdate(VK2DCameraIndex index, VK2DCameraSpec spec) {
 			gRenderer->cameras[index].spec.wOnScreen = gRenderer->surfaceWidth;
 		if (gRenderer->cameras[index].spec.hOnScreen == 0)
 			gRenderer->cameras[index].spec.hOnScreen = gRenderer->surfaceHeight;
+
+		// Every image's UBO rebuilds and re-uploads on its next frame
+		if (gRenderer->cameras[index].uboDirty != NULL)
+			for (int i = 0; i < gRenderer->swapchainImageCount; i++)
+				gRenderer->cameras[index].uboDirty[i] = true;
 	} else {
 		vk2dLogMessage("Renderer is not initialized");
 	}
@@ -78,8 +96,20 @@ void vk2dCameraSetState(VK2DCameraIndex index, VK2DCameraState state) {
 		// Free internal resources
 		if ((state == VK2D_CAMERA_STATE_DELETED || state == VK2D_CAMERA_STATE_RESET) &&
 			(gRenderer->cameras[index].state == VK2D_CAMERA_STATE_DISABLED || gRenderer->cameras[index].state == VK2D_CAMERA_STATE_NORMAL)) {
+			// In-flight frames may still read the UBO buffers so they are freed with the frame
+			if (gRenderer->cameras[index].uboBuffers != NULL) {
+				for (int i = 0; i < gRenderer->swapchainImageCount; i++)
+					if (!_vk2dRendererDeferFree(_vk2dCameraDestroyBuffer, gRenderer->cameras[index].uboBuffers[i]))
+						vk2dBufferFree(gRenderer->cameras[index].uboBuffers[i]);
+			}
 			free(gRenderer->cameras[index].ubos);
 			free(gRenderer->cameras[index].uboSets);
+			free(gRenderer->cameras[index].uboBuffers);
+			free(gRenderer->cameras[index].uboDirty);
+			gRenderer->cameras[index].ubos = NULL;
+			gRenderer->cameras[index].uboSets = NULL;
+			gRenderer->cameras[index].uboBuffers = NULL;
+			gRenderer->cameras[index].uboDirty = NULL;
 		}
 		gRenderer->cameras[index].state = state;
 	} else {
@@ -0,0 +1,220 @@
+/// \file Compute.c
+/// \author Paolo Mazzon
+#include "VK2D/Compute.h"
+#include "VK2D/Renderer.h"
+#include "VK2D/Buffer.h"
+#include "VK2D/LogicalDevice.h"
+#include "VK2D/Initializers.h"
+#include "VK2D/Validation.h"
+#include "VK2D/DescriptorControl.h"
+#include "VK2D/Util.h"
+#include "VK2D/Opaque.h"
+#include <malloc.h>
+#include <string.h>
+
+unsigned char* _vk2dLoadFile(const char *filename, uint32_t *size);
+
+static void _vk2dComputeShaderBuildPipe(VK2DComputeShader shader) {
+	VK2DRenderer renderer = vk2dRendererGetPointer();
+	VK2DLogicalDevice dev = shader->dev;
+
+	// Everything lives in one set: storage buffers first, the uniform right after them
+	uint32_t bindingCount = shader->storageBufferCount + (shader->uniformSize != 0 ? 1 : 0);
+	VkDescriptorSetLayoutBinding bindings[bindingCount];
+	uint32_t i;
+	for (i = 0; i < shader->storageBufferCount; i++)
+		bindings[i] = vk2dInitDescriptorSetLayoutBinding(i, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT, VK_NULL_HANDLE);
+	if (shader->uniformSize != 0)
+		bindings[shader->storageBufferCount] = vk2dInitDescriptorSetLayoutBinding(shader->storageBufferCount, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT, VK_NULL_HANDLE);
+	VkDescriptorSetLayoutCreateInfo descriptorSetLayoutCreateInfo = vk2dInitDescriptorSetLayoutCreateInfo(bindings, bindingCount);
+	vk2dErrorCheck(vkCreateDescriptorSetLayout(dev->dev, &descriptorSetLayoutCreateInfo, VK_NULL_HANDLE, &shader->dsl));
+
+	VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo = vk2dInitPipelineLayoutCreateInfo(&shader->dsl, 1, 0, VK_NULL_HANDLE);
+	vk2dErrorCheck(vkCreatePipelineLayout(dev->dev, &pipelineLayoutCreateInfo, VK_NULL_HANDLE, &shader->layout));
+
+	VkShaderModuleCreateInfo shaderModuleCreateInfo = vk2dInitShaderModuleCreateInfo((void*)shader->spv, shader->spvSize);
+	VkShaderModule shaderModule;
+	vkCreateShaderModule(dev->dev, &shaderModuleCreateInfo, VK_NULL_HANDLE, &shaderModule);
+	VkPipelineShaderStageCreateInfo stage = vk2dInitPipelineShaderStageCreateInfo(VK_SHADER_STAGE_COMPUTE_BIT, shaderModule);
+	VkComputePipelineCreateInfo computePipelineCreateInfo = vk2dInitComputePipelineCreateInfo(stage, shader->layout);
+	vk2dErrorCheck(vkCreateComputePipelines(dev->dev, renderer->pipelineCache, 1, &computePipelineCreateInfo, VK_NULL_HANDLE, &shader->pipe));
+	vkDestroyShaderModule(dev->dev, shaderModule, VK_NULL_HANDLE);
+}
+
+VK2DComputeShader vk2dComputeShaderFrom(uint8_t *shaderBuffer, int shaderBufferSize, uint32_t uniformBufferSize, uint32_t storageBufferCount) {
+	VK2DRenderer gRenderer = vk2dRendererGetPointer();
+	if (gRenderer == NULL) {
+		vk2dLogMessage("Renderer is not initialized");
+		return NULL;
+	}
+	if (uniformBufferSize % 4 != 0) {
+		vk2dLogMessage("Uniform buffer size for compute shader is invalid, must be multiple of 4");
+		return NULL;
+	} else if (uniformBufferSize > gRenderer->limits.maxShaderBufferSize) {
+		vk2dLogMessage("Uniform buffer of size %i is greater than the maximum allowed uniform buffer size of %i from vk2dRendererGetLimits", uniformBufferSize, gRenderer->limits.maxShaderBufferSize);
+		return NULL;
+	}
+
+	VK2DComputeShader out = malloc(sizeof(struct VK2DComputeShader_t));
+	VK2DLogicalDevice dev = vk2dRendererGetDevice();
+	uint8_t *file = _vk2dCopyBuffer(shaderBuffer, shaderBufferSize);
+
+	if (vk2dPointerCheck(out) && vk2dPointerCheck(file)) {
+		out->spv = file;
+		out->spvSize = shaderBufferSize;
+		out->uniformSize = uniformBufferSize;
+		out->storageBufferCount = storageBufferCount;
+		out->dev = dev;
+		out->asyncBuffer = VK_NULL_HANDLE;
+		_vk2dComputeShaderBuildPipe(out);
+		out->descCon = vk2dDescConCreate(dev, out->dsl,
+				uniformBufferSize != 0 ? storageBufferCount : VK2D_NO_LOCATION,
+				VK2D_NO_LOCATION,
+				storageBufferCount != 0 ? 0 : VK2D_NO_LOCATION);
+		out->uniformBuffer = uniformBufferSize != 0 ? vk2dBufferCreate(dev, uniformBufferSize, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT) : NULL;
+		VkFenceCreateInfo fenceCreateInfo = vk2dInitFenceCreateInfo(0);
+		vk2dErrorCheck(vkCreateFence(dev->dev, &fenceCreateInfo, VK_NULL_HANDLE, &out->fence));
+	} else {
+		free(file);
+		free(out);
+		out = NULL;
+	}
+
+	return out;
+}
+
+VK2DComputeShader vk2dComputeShaderLoad(const char *filename, uint32_t uniformBufferSize, uint32_t storageBufferCount) {
+	uint32_t size;
+	uint8_t *file = _vk2dLoadFile(filename, &size);
+	VK2DComputeShader out = NULL;
+	if (file != NULL) {
+		out = vk2dComputeShaderFrom(file, size, uniformBufferSize, storageBufferCount);
+		free(file);
+	}
+	if (out == NULL)
+		vk2dLogMessage("Failed to load compute shader \"%s\".", filename);
+	return out;
+}
+
+// Fills a fresh descriptor set and records the dispatch into a new command buffer from
+// the compute pool, returning VK_NULL_HANDLE if the buffer list doesn't match the shader
+static VkCommandBuffer _vk2dComputeShaderRecord(VK2DComputeShader shader, void *data, VK2DBuffer *buffers, uint32_t bufferCount, uint32_t groupsX, uint32_t groupsY, uint32_t groupsZ) {
+	VK2DRenderer gRenderer = vk2dRendererGetPointer();
+	VK2DLogicalDevice dev = shader->dev;
+
+	if (bufferCount != shader->storageBufferCount) {
+		vk2dLogMessage("Compute dispatch got %i storage buffers but the shader declares %i.", bufferCount, shader->storageBufferCount);
+		return VK_NULL_HANDLE;
+	}
+
+	if (shader->uniformSize != 0 && data != NULL) {
+		void *location;
+		vk2dErrorCheck(vmaMapMemory(gRenderer->vma, shader->uniformBuffer->mem, &location));
+		memcpy(location, data, shader->uniformSize);
+		vmaUnmapMemory(gRenderer->vma, shader->uniformBuffer->mem);
+	}
+
+	VkDescriptorSet set = vk2dDescConGetSet(shader->descCon);
+	VkDescriptorBufferInfo bufferInfo[bufferCount + 1];
+	VkWriteDescriptorSet writes[bufferCount + 1];
+	uint32_t writeCount = 0;
+	uint32_t i;
+	for (i = 0; i < bufferCount; i++) {
+		bufferInfo[i].buffer = buffers[i]->buf;
+		bufferInfo[i].offset = 0;
+		bufferInfo[i].range = buffers[i]->size;
+		writes[writeCount++] = vk2dInitWriteDescriptorSet(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, i, set, &bufferInfo[i], 1, VK_NULL_HANDLE);
+	}
+	if (shader->uniformSize != 0) {
+		bufferInfo[bufferCount].buffer = shader->uniformBuffer->buf;
+		bufferInfo[bufferCount].offset = 0;
+		bufferInfo[bufferCount].range = shader->uniformSize;
+		writes[writeCount++] = vk2dInitWriteDescriptorSet(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, bufferCount, set, &bufferInfo[bufferCount], 1, VK_NULL_HANDLE);
+	}
+	vkUpdateDescriptorSets(dev->dev, writeCount, writes, 0, VK_NULL_HANDLE);
+
+	VkCommandBufferAllocateInfo allocInfo = vk2dInitCommandBufferAllocateInfo(dev->computePool, 1);
+	VkCommandBuffer buffer;
+	vk2dErrorCheck(vkAllocateCommandBuffers(dev->dev, &allocInfo, &buffer));
+	VkCommandBufferBeginInfo beginInfo = vk2dInitCommandBufferBeginInfo(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT, VK_NULL_HANDLE);
+	vk2dErrorCheck(vkBeginCommandBuffer(buffer, &beginInfo));
+	vkCmdBindPipeline(buffer, VK_PIPELINE_BIND_POINT_COMPUTE, shader->pipe);
+	vkCmdBindDescriptorSets(buffer, VK_PIPELINE_BIND_POINT_COMPUTE, shader->layout, 0, 1, &set, 0, VK_NULL_HANDLE);
+	vkCmdDispatch(buffer, groupsX, groupsY, groupsZ);
+
+	// Whatever reads the results next (draws, transfers, another dispatch) waits on this one
+	VkMemoryBarrier barrier = {VK_STRUCTURE_TYPE_MEMORY_BARRIER};
+	barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+	barrier.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_SHADER_READ_BIT;
+	vkCmdPipelineBarrier(buffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 1, &barrier, 0, VK_NULL_HANDLE, 0, VK_NULL_HANDLE);
+	vk2dErrorCheck(vkEndCommandBuffer(buffer));
+	return buffer;
+}
+
+void vk2dComputeShaderDispatch(VK2DComputeShader shader, void *data, VK2DBuffer *buffers, uint32_t bufferCount, uint32_t groupsX, uint32_t groupsY, uint32_t groupsZ) {
+	if (vk2dRendererGetPointer() != NULL) {
+		if (shader != NULL) {
+			vk2dComputeShaderWait(shader);
+			VkCommandBuffer buffer = _vk2dComputeShaderRecord(shader, data, buffers, bufferCount, groupsX, groupsY, groupsZ);
+			if (buffer != VK_NULL_HANDLE) {
+				VK2DLogicalDevice dev = shader->dev;
+				VkSubmitInfo submitInfo = vk2dInitSubmitInfo(&buffer, 1, VK_NULL_HANDLE, 0, VK_NULL_HANDLE, 0, VK_NULL_HANDLE);
+				vk2dErrorCheck(vkQueueSubmit(dev->computeQueue, 1, &submitInfo, VK_NULL_HANDLE));
+				vkQueueWaitIdle(dev->computeQueue);
+				vkFreeCommandBuffers(dev->dev, dev->computePool, 1, &buffer);
+				vk2dDescConReset(shader->descCon);
+			}
+		} else {
+			vk2dLogMessage("Compute shader does not exist");
+		}
+	} else {
+		vk2dLogMessage("Renderer is not initialized");
+	}
+}
+
+void vk2dComputeShaderDispatchAsync(VK2DComputeShader shader, void *data, VK2DBuffer *buffers, uint32_t bufferCount, uint32_t groupsX, uint32_t groupsY, uint32_t groupsZ) {
+	if (vk2dRendererGetPointer() != NULL) {
+		if (shader != NULL) {
+			// Only one dispatch per shader can be in flight, the uniform buffer and
+			// descriptor set would otherwise be overwritten mid-execution
+			vk2dComputeShaderWait(shader);
+			VkCommandBuffer buffer = _vk2dComputeShaderRecord(shader, data, buffers, bufferCount, groupsX, groupsY, groupsZ);
+			if (buffer != VK_NULL_HANDLE) {
+				VK2DLogicalDevice dev = shader->dev;
+				VkSubmitInfo submitInfo = vk2dInitSubmitInfo(&buffer, 1, VK_NULL_HANDLE, 0, VK_NULL_HANDLE, 0, VK_NULL_HANDLE);
+				vk2dErrorCheck(vkQueueSubmit(dev->computeQueue, 1, &submitInfo, shader->fence));
+				shader->asyncBuffer = buffer;
+			}
+		} else {
+			vk2dLogMessage("Compute shader does not exist");
+		}
+	} else {
+		vk2dLogMessage("Renderer is not initialized");
+	}
+}
+
+void vk2dComputeShaderWait(VK2DComputeShader shader) {
+	if (shader != NULL && shader->asyncBuffer != VK_NULL_HANDLE) {
+		VK2DLogicalDevice dev = shader->dev;
+		vk2dErrorCheck(vkWaitForFences(dev->dev, 1, &shader->fence, VK_TRUE, UINT64_MAX));
+		vk2dErrorCheck(vkResetFences(dev->dev, 1, &shader->fence));
+		vkFreeCommandBuffers(dev->dev, dev->computePool, 1, &shader->asyncBuffer);
+		shader->asyncBuffer = VK_NULL_HANDLE;
+		vk2dDescConReset(shader->descCon);
+	}
+}
+
+void vk2dComputeShaderFree(VK2DComputeShader shader) {
+	if (shader != NULL) {
+		vk2dComputeShaderWait(shader);
+		VK2DLogicalDevice dev = shader->dev;
+		vkDestroyPipeline(dev->dev, shader->pipe, VK_NULL_HANDLE);
+		vkDestroyPipelineLayout(dev->dev, shader->layout, VK_NULL_HANDLE);
+		vkDestroyDescriptorSetLayout(dev->dev, shader->dsl, VK_NULL_HANDLE);
+		vk2dDescConFree(shader->descCon);
+		vk2dBufferFree(shader->uniformBuffer);
+		vkDestroyFence(dev->dev, shader->fence, VK_NULL_HANDLE);
+		free(shader->spv);
+		free(shader);
+	}
+}
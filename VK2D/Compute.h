@@ -0,0 +1,61 @@
+/// \file Compute.h
+/// \author Paolo Mazzon
+/// \brief Runs compute shaders on the GPU so data never has to round-trip through the CPU
+#pragma once
+#include "VK2D/Structs.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// \brief Creates a compute shader from compiled SPIR-V
+/// \param shaderBuffer Buffer containing the compiled SPIR-V compute shader
+/// \param shaderBufferSize Size of the aforementioned buffer in bytes
+/// \param uniformBufferSize Size of the shader's uniform buffer in bytes, or 0 for no uniform (must be a multiple of 4)
+/// \param storageBufferCount Number of storage buffers the shader declares
+/// \return Returns a new compute shader or NULL if it failed
+///
+/// Unlike graphics shaders these don't receive any built-in data, the shader only sees
+/// what each dispatch hands it. Everything lives in set 0: storage buffer `i` binds at
+/// `layout(set = 0, binding = i) buffer`, and if a uniform is requested it binds right
+/// after the storage buffers at `layout(set = 0, binding = storageBufferCount) uniform`.
+VK2DComputeShader vk2dComputeShaderFrom(uint8_t *shaderBuffer, int shaderBufferSize, uint32_t uniformBufferSize, uint32_t storageBufferCount);
+
+/// \brief Same as vk2dComputeShaderFrom but loads the SPIR-V from a file
+/// \param filename Filename of the compiled SPIR-V compute shader
+/// \param uniformBufferSize Size of the shader's uniform buffer in bytes, or 0 for no uniform (must be a multiple of 4)
+/// \param storageBufferCount Number of storage buffers the shader declares
+/// \return Returns a new compute shader or NULL if it failed
+VK2DComputeShader vk2dComputeShaderLoad(const char *filename, uint32_t uniformBufferSize, uint32_t storageBufferCount);
+
+/// \brief Runs a compute shader and waits for it to finish
+/// \param shader Compute shader to run
+/// \param data Uniform data for this dispatch, must be at least uniformBufferSize bytes (ignored if the shader has no uniform)
+/// \param buffers Storage buffers to bind, in binding order - use vk2dBufferCreateStorage to make them
+/// \param bufferCount Number of buffers in the array, must match the shader's storageBufferCount
+/// \param groupsX Number of work groups to dispatch in x
+/// \param groupsY Number of work groups to dispatch in y
+/// \param groupsZ Number of work groups to dispatch in z
+/// \warning This blocks until the GPU finishes the dispatch, use vk2dComputeShaderDispatchAsync to overlap it with other work
+void vk2dComputeShaderDispatch(VK2DComputeShader shader, void *data, VK2DBuffer *buffers, uint32_t bufferCount, uint32_t groupsX, uint32_t groupsY, uint32_t groupsZ);
+
+/// \brief Same as vk2dComputeShaderDispatch but returns immediately
+///
+/// The dispatch runs on the host's compute queue (its own queue family when the
+/// hardware has one), so it can overlap frame rendering and CPU work. Call
+/// vk2dComputeShaderWait before touching the storage buffers again; only one
+/// async dispatch per shader may be in flight at a time, so dispatching again
+/// first waits out the previous one.
+void vk2dComputeShaderDispatchAsync(VK2DComputeShader shader, void *data, VK2DBuffer *buffers, uint32_t bufferCount, uint32_t groupsX, uint32_t groupsY, uint32_t groupsZ);
+
+/// \brief Waits until a shader's async dispatch has finished, does nothing if there isn't one in flight
+/// \param shader Compute shader to wait on
+void vk2dComputeShaderWait(VK2DComputeShader shader);
+
+/// \brief Frees a compute shader from memory, waiting out any dispatch still in flight
+/// \param shader Compute shader to free
+void vk2dComputeShaderFree(VK2DComputeShader shader);
+
+#ifdef __cplusplus
+};
+#endif
@@ -38,6 +38,24 @@ extern const float VK2D_CIRCLE_VERTICES;
 /// Maximum number of frames to be processed at once - You generally want this and VK2D_DEVICE_COMMAND_POOLS to be the same
 #define VK2D_MAX_FRAMES_IN_FLIGHT 3
 
+/// Number of threads the asset loader uses so image decoding and model parsing can happen in parallel
+#define VK2D_WORKER_THREAD_COUNT 4
+
+/// Maximum number of GPU timestamps the profiler may record per frame, one is written per pipeline switch
+#define VK2D_MAX_GPU_TIMESTAMPS 128
+
+/// Maximum number of textures the bindless texture array can hold at once (the host may support less)
+#define VK2D_MAX_BOUND_TEXTURES 1000
+
+/// Workgroup size (local_size_x) particle update compute shaders must declare
+#define VK2D_PARTICLE_WORKGROUP_SIZE 64
+
+/// Width and height of a tilemap chunk in tiles, edits only re-bake the chunk they land in
+#define VK2D_TILEMAP_CHUNK_SIZE 32
+
+/// Maximum length of an asset bundle entry name, including the null terminator
+#define VK2D_BUNDLE_NAME_MAX 64
+
 /// Not terribly difficult to figure out the usages of this
 #define VK2D_PI 3.14159265358979323846264338327950
 
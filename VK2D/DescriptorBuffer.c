@@ -23,19 +23,22 @@ static _VK2DDescriptorBufferInternal *_vk2dDescriptorBufferAppendBuffer(VK2DDesc
 	_VK2DDescriptorBufferInternal *buffer = &db->buffers[db->bufferCount];
 	db->bufferCount++;
 
-	// Create the new buffers
+	// Create the new buffers, shared so their copies may run on a dedicated transfer queue
 	buffer->size = 0;
-	buffer->stageBuffer = vk2dBufferCreate(
+	buffer->stageBuffer = vk2dBufferCreateShared(
 			db->dev,
 			gRenderer->options.vramPageSize,
 			VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
 			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT);
-	buffer->deviceBuffer = vk2dBufferCreate(
+	buffer->deviceBuffer = vk2dBufferCreateShared(
 			db->dev,
 			gRenderer->options.vramPageSize,
 			VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
 			VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
 
+	// The stage buffer stays mapped for its whole life so frames don't pay for map/unmap churn
+	vk2dErrorCheck(vmaMapMemory(gRenderer->vma, buffer->stageBuffer->mem, &buffer->hostData));
+
 	return buffer;
 }
 
@@ -43,27 +46,31 @@ VK2DDescriptorBuffer vk2dDescriptorBufferCreate() {
 	VK2DDescriptorBuffer db = calloc(1, sizeof(struct VK2DDescriptorBuffer_t));
 	vk2dPointerCheck(db);
 	db->dev = vk2dRendererGetDevice();
+	db->copyMutex = SDL_CreateMutex();
+	vk2dPointerCheck(db->copyMutex);
 	_vk2dDescriptorBufferAppendBuffer(db);
 	return db;
 }
 
 void vk2dDescriptorBufferFree(VK2DDescriptorBuffer db) {
+	VK2DRenderer gRenderer = vk2dRendererGetPointer();
 	if (db != NULL) {
 		for (int i = 0; i < db->bufferCount; i++) {
+			vmaUnmapMemory(gRenderer->vma, db->buffers[i].stageBuffer->mem);
 			vk2dBufferFree(db->buffers[i].deviceBuffer);
 			vk2dBufferFree(db->buffers[i].stageBuffer);
 		}
+		SDL_DestroyMutex(db->copyMutex);
 		free(db->buffers);
 		free(db);
 	}
 }
 
 void vk2dDescriptorBufferBeginFrame(VK2DDescriptorBuffer db, VkCommandBuffer drawBuffer) {
-	VK2DRenderer gRenderer = vk2dRendererGetPointer();
-	for (int i = 0; i < db->bufferCount; i++) {
+	// The stage buffers are persistently mapped, frames only reset the write cursors
+	for (int i = 0; i < db->bufferCount; i++)
 		db->buffers[i].size = 0;
-		vk2dErrorCheck(vmaMapMemory(gRenderer->vma, db->buffers[i].stageBuffer->mem, &db->buffers[i].hostData));
-	}
+	db->pageIndex = 0;
 
 	vkCmdPipelineBarrier(
 			drawBuffer,
@@ -82,19 +89,26 @@ void vk2dDescriptorBufferBeginFrame(VK2DDescriptorBuffer db, VkCommandBuffer dra
 void vk2dDescriptorBufferCopyData(VK2DDescriptorBuffer db, void *data, VkDeviceSize size, VkBuffer *outBuffer, VkDeviceSize *offset) {
 	VK2DRenderer gRenderer = vk2dRendererGetPointer();
 	if (size < gRenderer->options.vramPageSize) {
-		// Find a buffer with enough space
-		_VK2DDescriptorBufferInternal *spot = NULL;
-		for (int i = 0; i < db->bufferCount && spot == NULL; i++) {
-			if (size <= gRenderer->options.vramPageSize - db->buffers[i].size) {
-				spot = &db->buffers[i];
+		// Draws may be recorded from multiple threads at once so the cursor bump is locked
+		SDL_LockMutex(db->copyMutex);
+
+		// The common case is a simple bump on the current page
+		_VK2DDescriptorBufferInternal *spot = &db->buffers[db->pageIndex];
+		if (size > gRenderer->options.vramPageSize - spot->size) {
+			// Current page is full for this size, walk forward through the remaining pages
+			spot = NULL;
+			for (int i = db->pageIndex + 1; i < db->bufferCount && spot == NULL; i++) {
+				if (size <= gRenderer->options.vramPageSize - db->buffers[i].size) {
+					spot = &db->buffers[i];
+					db->pageIndex = i;
+				}
 			}
-		}
 
-		// If no buffer exists, make a new one
-		if (spot == NULL) {
-			spot = _vk2dDescriptorBufferAppendBuffer(db);
-			spot->size = 0;
-			vmaMapMemory(gRenderer->vma, spot->stageBuffer->mem, &spot->hostData);
+			// If no buffer exists, make a new one (it comes back mapped and empty)
+			if (spot == NULL) {
+				spot = _vk2dDescriptorBufferAppendBuffer(db);
+				db->pageIndex = db->bufferCount - 1;
+			}
 		}
 
 		// Copy data over
@@ -104,20 +118,23 @@ void vk2dDescriptorBufferCopyData(VK2DDescriptorBuffer db, void *data, VkDeviceS
 		*offset = spot->size;
 
 		// We may only move size in accordance with minUniformBufferOffsetAlignment
+		VkDeviceSize previousSize = spot->size;
 		if (size % gRenderer->pd->props.limits.minUniformBufferOffsetAlignment != 0) {
 			spot->size += ((size / gRenderer->pd->props.limits.minUniformBufferOffsetAlignment) + 1) * gRenderer->pd->props.limits.minUniformBufferOffsetAlignment;
 		} else {
 			spot->size += size;
 		}
+		gRenderer->frameStats.descriptorBufferBytes += spot->size - previousSize;
+
+		SDL_UnlockMutex(db->copyMutex);
 	}
 }
 
 void vk2dDescriptorBufferEndFrame(VK2DDescriptorBuffer db, VkCommandBuffer copyBuffer) {
 	VK2DRenderer gRenderer = vk2dRendererGetPointer();
 
-	// Unmap all of the buffers then queue a buffer copy if their size is greater than 0
+	// Queue a buffer copy for each buffer with a size greater than 0
 	for (int i = 0; i < db->bufferCount; i++) {
-		vmaUnmapMemory(gRenderer->vma, db->buffers[i].stageBuffer->mem);
 		if (db->buffers[i].size > 0) {
 			VkBufferCopy bufferCopy = {0};
 			bufferCopy.size = (db->buffers[i].size < gRenderer->options.vramPageSize) ? db->buffers[i].size : gRenderer->options.vramPageSize;
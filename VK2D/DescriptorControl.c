@@ -46,10 +46,20 @@ static void _vk2dDescConAppendList(VK2DDescCon descCon) {
 // Gets the first available descriptor set from a descriptor controller (allocating a new pool if need be)
 VkDescriptorSet _vk2dDescConGetAvailableSet(VK2DDescCon descCon) {
 	VkDescriptorSet set = VK_NULL_HANDLE;
-	uint32_t i = 0;
 	VkResult res;
 	VkDescriptorSetAllocateInfo allocInfo = vk2dInitDescriptorSetAllocateInfo(VK_NULL_HANDLE, 1, &descCon->layout);
 
+	SDL_LockMutex(descCon->mutex);
+
+	// Recycled sets are just rewritten by the caller, no pool allocation needed
+	if (descCon->freeListCount > 0) {
+		set = descCon->freeList[--descCon->freeListCount];
+		SDL_UnlockMutex(descCon->mutex);
+		return set;
+	}
+
+	// Pools before poolIndex are known to be full, no point asking them again
+	uint32_t i = descCon->poolIndex;
 	while (set == VK_NULL_HANDLE) {
 		allocInfo.descriptorPool = descCon->pools[i];
 		res = vkAllocateDescriptorSets(descCon->dev->dev, &allocInfo, &set);
@@ -58,12 +68,15 @@ VkDescriptorSet _vk2dDescConGetAvailableSet(VK2DDescCon descCon) {
 		} else if (res != VK_SUCCESS) {
 			vk2dErrorCheck(res);
 			break;
+		} else {
+			descCon->poolIndex = i;
 		}
 		i++;
 		if (i == descCon->poolsInUse && set == VK_NULL_HANDLE)
 			_vk2dDescConAppendList(descCon);
 	}
 
+	SDL_UnlockMutex(descCon->mutex);
 	return set;
 }
 
@@ -79,6 +92,7 @@ VK2DDescCon vk2dDescConCreate(VK2DLogicalDevice dev, VkDescriptorSetLayout layou
 		out->pools = NULL;
 		out->poolListSize = 0;
 		out->poolsInUse = 0;
+		out->mutex = SDL_CreateMutex();
 		_vk2dDescConAppendList(out);
 	}
 
@@ -90,11 +104,30 @@ void vk2dDescConFree(VK2DDescCon descCon) {
 		uint32_t i;
 		for (i = 0; i < descCon->poolsInUse; i++)
 			vkDestroyDescriptorPool(descCon->dev->dev, descCon->pools[i], VK_NULL_HANDLE);
+		SDL_DestroyMutex(descCon->mutex);
+		free(descCon->freeList);
 		free(descCon->pools);
 		free(descCon);
 	}
 }
 
+void vk2dDescConFreeSet(VK2DDescCon descCon, VkDescriptorSet set) {
+	if (descCon == NULL || set == VK_NULL_HANDLE)
+		return;
+	SDL_LockMutex(descCon->mutex);
+	if (descCon->freeListCount == descCon->freeListSize) {
+		VkDescriptorSet *newList = realloc(descCon->freeList, sizeof(VkDescriptorSet) * (descCon->freeListSize + VK2D_DEFAULT_ARRAY_EXTENSION));
+		if (!vk2dPointerCheck(newList)) {
+			SDL_UnlockMutex(descCon->mutex);
+			return;
+		}
+		descCon->freeList = newList;
+		descCon->freeListSize += VK2D_DEFAULT_ARRAY_EXTENSION;
+	}
+	descCon->freeList[descCon->freeListCount++] = set;
+	SDL_UnlockMutex(descCon->mutex);
+}
+
 VkDescriptorSet vk2dDescConGetBufferSet(VK2DDescCon descCon, VK2DBuffer buffer) {
 	VkDescriptorSet set = _vk2dDescConGetAvailableSet(descCon);
 	VkDescriptorBufferInfo bufferInfo = {0};
@@ -112,10 +145,14 @@ VkDescriptorSet vk2dDescConGetSet(VK2DDescCon descCon) {
 }
 
 VkDescriptorSet vk2dDescConGetSamplerSet(VK2DDescCon descCon, VK2DTexture tex) {
+	return vk2dDescConGetSamplerSetFromImage(descCon, tex->img);
+}
+
+VkDescriptorSet vk2dDescConGetSamplerSetFromImage(VK2DDescCon descCon, VK2DImage img) {
 	VkDescriptorSet set = _vk2dDescConGetAvailableSet(descCon);
 	VkDescriptorImageInfo imageInfo = {0};
 	imageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-	imageInfo.imageView = tex->img->view;
+	imageInfo.imageView = img->view;
 	VkWriteDescriptorSet write = vk2dInitWriteDescriptorSet(VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,
 																descCon->sampler, set, VK_NULL_HANDLE, 1, &imageInfo);
 	vkUpdateDescriptorSets(descCon->dev->dev, 1, &write, 0, VK_NULL_HANDLE);
@@ -142,7 +179,12 @@ VkDescriptorSet vk2dDescConGetSamplerBufferSet(VK2DDescCon descCon, VK2DTexture
 
 void vk2dDescConReset(VK2DDescCon descCon) {
 	uint32_t i;
+	SDL_LockMutex(descCon->mutex);
 	for (i = 0; i < descCon->poolsInUse; i++) {
 		vkResetDescriptorPool(descCon->dev->dev, descCon->pools[i], 0);
 	}
+	// Every set the pools handed out is now invalid, including recycled ones
+	descCon->poolIndex = 0;
+	descCon->freeListCount = 0;
+	SDL_UnlockMutex(descCon->mutex);
 }
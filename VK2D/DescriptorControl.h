@@ -36,6 +36,12 @@ VkDescriptorSet vk2dDescConGetSet(VK2DDescCon descCon);
 /// \return Returns a new descriptor set ready to be bound to a command buffer (valid until vk2dDescConReset is called)
 VkDescriptorSet vk2dDescConGetSamplerSet(VK2DDescCon descCon, VK2DTexture tex);
 
+/// \brief Same as vk2dDescConGetSamplerSet but for a bare image that isn't attached to a texture yet
+/// \param descCon Descriptor controller to pull the set from
+/// \param img Image whose view is bound to the descriptor set
+/// \return Returns a new descriptor set ready to be bound to a command buffer (valid until vk2dDescConReset is called)
+VkDescriptorSet vk2dDescConGetSamplerSetFromImage(VK2DDescCon descCon, VK2DImage img);
+
 /// \brief Creates, updates, and returns a descriptor set ready to be bound to a command buffer
 /// \param descCon Descriptor controller to pull the set from
 /// \param tex Texture to bind to the descriptor set
@@ -47,6 +53,12 @@ VkDescriptorSet vk2dDescConGetSamplerBufferSet(VK2DDescCon descCon, VK2DTexture
 /// \param descCon Descriptor controller to reset
 void vk2dDescConReset(VK2DDescCon descCon);
 
+/// \brief Hands a set back to its controller so a later allocation can reuse it
+/// \param descCon Descriptor controller the set came from
+/// \param set Set to recycle, may be VK_NULL_HANDLE
+/// \warning The set must no longer be referenced by any in-flight frame, it will be rewritten on reuse
+void vk2dDescConFreeSet(VK2DDescCon descCon, VkDescriptorSet set);
+
 #ifdef __cplusplus
 }
 #endif
\ No newline at end of file
@@ -0,0 +1,90 @@
+/// \file DrawList.c
+/// \author Paolo Mazzon
+#include "VK2D/DrawList.h"
+#include "VK2D/Buffer.h"
+#include "VK2D/Renderer.h"
+#include "VK2D/LogicalDevice.h"
+#include "VK2D/Validation.h"
+#include "VK2D/Opaque.h"
+#include <malloc.h>
+
+bool _vk2dRendererDeferFree(void (*freeFunc)(void*), void *resource);
+
+// So retired buffers can ride the renderer's deferred-free queue
+static void _vk2dDrawListDestroyBuffer(void *buffer) {
+	vk2dBufferFree(buffer);
+}
+
+VK2DDrawList vk2dDrawListCreate(VK2DTexture tex) {
+	VK2DDrawList out = NULL;
+
+	if (vk2dRendererGetPointer() != NULL) {
+		out = calloc(1, sizeof(struct VK2DDrawList_t));
+		if (vk2dPointerCheck(out))
+			out->tex = tex;
+	} else {
+		vk2dLogMessage("Renderer is not initialized");
+	}
+
+	return out;
+}
+
+void vk2dDrawListAppend(VK2DDrawList list, float x, float y, float xscale, float yscale, float rot, float originX, float originY, float xInTex, float yInTex, float texWidth, float texHeight) {
+	if (list != NULL) {
+		// Potentially grow the list
+		if (list->itemCount == list->itemListSize) {
+			uint32_t newSize = list->itemListSize == 0 ? 256 : list->itemListSize * 2;
+			list->items = realloc(list->items, sizeof(VK2DDrawInstance) * newSize);
+			vk2dPointerCheck(list->items);
+			list->itemListSize = newSize;
+		}
+
+		vec4 colour;
+		vk2dRendererGetColourMod(colour);
+		if (rot != 0 || xscale != 1 || yscale != 1)
+			vk2dInstanceSet(&list->items[list->itemCount], x, y, xscale, yscale, rot, originX, originY, xInTex, yInTex, texWidth, texHeight, colour);
+		else
+			vk2dInstanceSetFast(&list->items[list->itemCount], x, y, xInTex, yInTex, texWidth, texHeight, colour);
+		list->itemCount++;
+		list->dirty = true;
+	}
+}
+
+// In-flight frames may still source the old buffers so they retire through the deferred-free queue
+static void _vk2dDrawListReleaseBuffers(VK2DDrawList list) {
+	if (list->instances != NULL && !_vk2dRendererDeferFree(_vk2dDrawListDestroyBuffer, list->instances))
+		vk2dBufferFree(list->instances);
+	if (list->commands != NULL && !_vk2dRendererDeferFree(_vk2dDrawListDestroyBuffer, list->commands))
+		vk2dBufferFree(list->commands);
+	list->instances = NULL;
+	list->commands = NULL;
+}
+
+void vk2dDrawListBake(VK2DDrawList list) {
+	if (list != NULL && list->dirty) {
+		VK2DLogicalDevice dev = vk2dRendererGetDevice();
+		_vk2dDrawListReleaseBuffers(list);
+
+		if (list->itemCount > 0) {
+			list->instances = vk2dBufferCreateStorage(dev, list->itemCount * sizeof(VK2DDrawInstance), list->items);
+			VK2DDrawCommand command = {6, list->itemCount, 0, 0};
+			list->commands = vk2dBufferCreateStorage(dev, sizeof(VK2DDrawCommand), &command);
+		}
+		list->dirty = false;
+	}
+}
+
+void vk2dDrawListClear(VK2DDrawList list) {
+	if (list != NULL) {
+		list->itemCount = 0;
+		list->dirty = true;
+	}
+}
+
+void vk2dDrawListFree(VK2DDrawList list) {
+	if (list != NULL) {
+		_vk2dDrawListReleaseBuffers(list);
+		free(list->items);
+		free(list);
+	}
+}
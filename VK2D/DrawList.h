@@ -0,0 +1,56 @@
+/// \file DrawList.h
+/// \author Paolo Mazzon
+/// \brief Records draws once into retained device buffers so static layers replay for free
+#pragma once
+#include "VK2D/Structs.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// \brief Creates an empty draw list
+/// \param tex Texture every draw in the list samples from (use an atlas to cover many sprites)
+/// \return Returns a new draw list or NULL if it failed
+///
+/// Record a static layer (tilemap, background, UI chrome) into the list once with
+/// vk2dDrawListAppend, then replay the whole thing each frame with a single call to
+/// vk2dRendererDrawList - the draws live in device buffers and cost the CPU nothing
+/// after baking.
+VK2DDrawList vk2dDrawListCreate(VK2DTexture tex);
+
+/// \brief Records a draw into the list, parameters are the same as vk2dRendererDrawTexture
+/// \param list List to record into
+/// \param x X position to draw at
+/// \param y Y position to draw at
+/// \param xscale Horizontal scale of the draw
+/// \param yscale Vertical scale of the draw
+/// \param rot Rotation of the draw in radians
+/// \param originX X origin to rotate about
+/// \param originY Y origin to rotate about
+/// \param xInTex X position in the texture to draw from
+/// \param yInTex Y position in the texture to draw from
+/// \param texWidth Width of the texture region to draw
+/// \param texHeight Height of the texture region to draw
+///
+/// The renderer's current colour mod is recorded with the draw. Appending after the
+/// list was baked just marks it dirty, it gets re-baked on the next draw.
+void vk2dDrawListAppend(VK2DDrawList list, float x, float y, float xscale, float yscale, float rot, float originX, float originY, float xInTex, float yInTex, float texWidth, float texHeight);
+
+/// \brief Uploads the recorded draws into device-local buffers
+/// \param list List to bake
+///
+/// This blocks on a GPU transfer so it belongs at load time; vk2dRendererDrawList
+/// calls it automatically if the list changed since the last bake.
+void vk2dDrawListBake(VK2DDrawList list);
+
+/// \brief Empties a draw list so it can be re-recorded
+/// \param list List to clear
+void vk2dDrawListClear(VK2DDrawList list);
+
+/// \brief Frees a draw list and its device buffers from memory
+/// \param list List to free
+void vk2dDrawListFree(VK2DDrawList list);
+
+#ifdef __cplusplus
+};
+#endif
@@ -0,0 +1,155 @@
+/// \file Font.c
+/// \author Paolo Mazzon
+#include "VK2D/Font.h"
+#include "VK2D/Texture.h"
+#include "VK2D/Renderer.h"
+#include "VK2D/Validation.h"
+#include "VK2D/Opaque.h"
+#include <malloc.h>
+#include <string.h>
+
+void *vk2dFrameAlloc(uint32_t size);
+
+VK2DFont vk2dFontFrom(VK2DTexture tex, int firstChar, int lastChar, float cellW, float cellH) {
+	VK2DFont out = NULL;
+
+	if (vk2dRendererGetPointer() != NULL) {
+		if (tex != NULL && lastChar >= firstChar && cellW > 0 && cellH > 0) {
+			out = malloc(sizeof(struct VK2DFont_t));
+			if (vk2dPointerCheck(out)) {
+				out->tex = tex;
+				out->ownsTexture = false;
+				out->firstChar = firstChar;
+				out->lastChar = lastChar;
+				out->cellW = cellW;
+				out->cellH = cellH;
+				out->widths = NULL;
+			}
+		} else {
+			vk2dLogMessage("Invalid font parameters");
+		}
+	} else {
+		vk2dLogMessage("Renderer is not initialized");
+	}
+
+	return out;
+}
+
+VK2DFont vk2dFontLoad(const char *filename, int firstChar, int lastChar, float cellW, float cellH) {
+	VK2DFont out = NULL;
+
+	if (vk2dRendererGetPointer() != NULL) {
+		VK2DTexture tex = vk2dTextureLoad(filename);
+		if (tex != NULL) {
+			out = vk2dFontFrom(tex, firstChar, lastChar, cellW, cellH);
+			if (out != NULL)
+				out->ownsTexture = true;
+			else
+				vk2dTextureFree(tex);
+		}
+	} else {
+		vk2dLogMessage("Renderer is not initialized");
+	}
+
+	return out;
+}
+
+void vk2dFontSetCharWidths(VK2DFont font, const float *widths) {
+	if (font != NULL && widths != NULL) {
+		uint32_t count = font->lastChar - font->firstChar + 1;
+		if (font->widths == NULL)
+			font->widths = malloc(sizeof(float) * count);
+		if (vk2dPointerCheck(font->widths))
+			memcpy(font->widths, widths, sizeof(float) * count);
+	}
+}
+
+// Advance the pen gets from a character, whether or not the font can draw it
+static float _vk2dFontAdvance(VK2DFont font, unsigned char c, float scale) {
+	if (font->widths != NULL && c >= font->firstChar && c <= font->lastChar)
+		return font->widths[c - font->firstChar] * scale;
+	return font->cellW * scale;
+}
+
+void vk2dFontDrawExt(VK2DFont font, float x, float y, float scale, const char *text) {
+	if (vk2dRendererGetPointer() != NULL) {
+		if (font != NULL && text != NULL) {
+			// Every glyph in the string becomes one instance in a single instanced draw
+			uint32_t len = strlen(text);
+			VK2DDrawInstance *instances = vk2dFrameAlloc(sizeof(VK2DDrawInstance) * len);
+			if (!vk2dPointerCheck(instances))
+				return;
+			uint32_t glyphsPerRow = (uint32_t)(vk2dTextureWidth(font->tex) / font->cellW);
+			vec4 colour;
+			vk2dRendererGetColourMod(colour);
+			uint32_t count = 0;
+			float penX = x;
+			float penY = y;
+
+			for (uint32_t i = 0; text[i] != 0; i++) {
+				unsigned char c = text[i];
+				if (c == '\n') {
+					penX = x;
+					penY += font->cellH * scale;
+					continue;
+				}
+				if (c >= font->firstChar && c <= font->lastChar) {
+					uint32_t cell = c - font->firstChar;
+					if (scale != 1)
+						vk2dInstanceSet(&instances[count], penX, penY, scale, scale, 0, 0, 0,
+										(cell % glyphsPerRow) * font->cellW, (cell / glyphsPerRow) * font->cellH,
+										font->cellW, font->cellH, colour);
+					else
+						vk2dInstanceSetFast(&instances[count], penX, penY,
+											(cell % glyphsPerRow) * font->cellW, (cell / glyphsPerRow) * font->cellH,
+											font->cellW, font->cellH, colour);
+					count++;
+				}
+				penX += _vk2dFontAdvance(font, c, scale);
+			}
+
+			if (count > 0)
+				vk2dRendererDrawInstanced(font->tex, instances, count);
+		} else {
+			vk2dLogMessage("Font does not exist");
+		}
+	} else {
+		vk2dLogMessage("Renderer is not initialized");
+	}
+}
+
+void vk2dFontDraw(VK2DFont font, float x, float y, const char *text) {
+	vk2dFontDrawExt(font, x, y, 1, text);
+}
+
+void vk2dFontMeasure(VK2DFont font, const char *text, float *w, float *h) {
+	float width = 0;
+	float height = 0;
+	if (font != NULL && text != NULL && text[0] != 0) {
+		float lineWidth = 0;
+		height = font->cellH;
+		for (uint32_t i = 0; text[i] != 0; i++) {
+			if (text[i] == '\n') {
+				width = lineWidth > width ? lineWidth : width;
+				lineWidth = 0;
+				height += font->cellH;
+				continue;
+			}
+			lineWidth += _vk2dFontAdvance(font, (unsigned char)text[i], 1);
+		}
+		width = lineWidth > width ? lineWidth : width;
+	}
+	if (w != NULL)
+		*w = width;
+	if (h != NULL)
+		*h = height;
+}
+
+void vk2dFontFree(VK2DFont font) {
+	if (font != NULL) {
+		if (font->ownsTexture)
+			vk2dTextureFree(font->tex);
+		free(font->widths);
+		free(font);
+	}
+}
@@ -0,0 +1,73 @@
+/// \file Font.h
+/// \author Paolo Mazzon
+/// \brief Draws bitmap-font text as one instanced draw per string
+#pragma once
+#include "VK2D/Structs.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// \brief Loads a font from an image containing a grid of glyphs
+/// \param filename Image to load the glyph grid from (same formats as vk2dTextureLoad)
+/// \param firstChar Character code of the grid's first cell (usually 32 for space)
+/// \param lastChar Character code of the grid's last cell, inclusive (usually 126 for `~`)
+/// \param cellW Width of a glyph cell in pixels
+/// \param cellH Height of a glyph cell in pixels
+/// \return Returns a new font or NULL if it failed
+///
+/// Glyphs are expected left-to-right, top-to-bottom in the grid. Each string then
+/// renders as a single instanced draw with one instance per visible glyph, so
+/// chat-heavy scenes cost one draw call per string instead of one per glyph (or a
+/// texture allocation per string).
+VK2DFont vk2dFontLoad(const char *filename, int firstChar, int lastChar, float cellW, float cellH);
+
+/// \brief Same as vk2dFontLoad but wraps a texture you already loaded
+/// \param tex Texture holding the glyph grid, the font does not take ownership of it
+/// \param firstChar Character code of the grid's first cell
+/// \param lastChar Character code of the grid's last cell, inclusive
+/// \param cellW Width of a glyph cell in pixels
+/// \param cellH Height of a glyph cell in pixels
+/// \return Returns a new font or NULL if it failed
+VK2DFont vk2dFontFrom(VK2DTexture tex, int firstChar, int lastChar, float cellW, float cellH);
+
+/// \brief Gives a font per-glyph advances for non-monospace rendering
+/// \param font Font to update
+/// \param widths Array of advances in pixels, one per character from firstChar to lastChar (copied)
+///
+/// Without this every glyph advances the pen by cellW. Glyphs still sample their full
+/// cell from the grid, only the advance changes.
+void vk2dFontSetCharWidths(VK2DFont font, const float *widths);
+
+/// \brief Draws a string in one instanced draw
+/// \param font Font to draw with
+/// \param x X position of the string's top-left corner
+/// \param y Y position of the string's top-left corner
+/// \param text Null-terminated UTF-8/ASCII string, `\n` starts a new line
+///
+/// Characters outside the font's range advance the pen without drawing. The string
+/// uses the renderer's current colour mod.
+void vk2dFontDraw(VK2DFont font, float x, float y, const char *text);
+
+/// \brief Same as vk2dFontDraw but with a uniform scale applied to every glyph
+/// \param font Font to draw with
+/// \param x X position of the string's top-left corner
+/// \param y Y position of the string's top-left corner
+/// \param scale Scale applied to every glyph (1 is natural size)
+/// \param text Null-terminated UTF-8/ASCII string, `\n` starts a new line
+void vk2dFontDrawExt(VK2DFont font, float x, float y, float scale, const char *text);
+
+/// \brief Measures how much space a string would take to draw
+/// \param font Font that would draw the string
+/// \param text String to measure
+/// \param w Filled with the width of the widest line in pixels, may be NULL
+/// \param h Filled with the total height in pixels, may be NULL
+void vk2dFontMeasure(VK2DFont font, const char *text, float *w, float *h);
+
+/// \brief Frees a font from memory, including its texture if the font loaded it
+/// \param font Font to free
+void vk2dFontFree(VK2DFont font);
+
+#ifdef __cplusplus
+};
+#endif
@@ -26,9 +26,7 @@ Uint32 amask = 0xff000000;
 
 // Internal functions
 
-static void _vk2dImageCopyBufferToImage(VK2DLogicalDevice dev, VkBuffer buffer, VkImage image, uint32_t width, uint32_t height, bool mainThread) {
-	VkCommandBuffer commandBuffer = vk2dLogicalDeviceGetSingleUseBuffer(dev, mainThread);
-
+static void _vk2dImageRecordCopyBufferToImage(VkCommandBuffer commandBuffer, VkBuffer buffer, VkImage image, uint32_t width, uint32_t height) {
 	VkBufferImageCopy region = {0};
 	region.bufferOffset = 0;
 	region.bufferRowLength = 0;
@@ -51,12 +49,9 @@ static void _vk2dImageCopyBufferToImage(VK2DLogicalDevice dev, VkBuffer buffer,
 			1,
 			&region
 	);
-
-	vk2dLogicalDeviceSubmitSingleBuffer(dev, commandBuffer, mainThread);
 }
 
-void _vk2dImageTransitionImageLayout(VK2DLogicalDevice dev, VkImage image, VkImageLayout oldLayout, VkImageLayout newLayout, bool mainThread) {
-	VkCommandBuffer buffer = vk2dLogicalDeviceGetSingleUseBuffer(dev, mainThread);
+static void _vk2dImageRecordTransitionImageLayout(VkCommandBuffer buffer, VkImage image, VkImageLayout oldLayout, VkImageLayout newLayout, uint32_t baseMipLevel, uint32_t mipLevels) {
 	VkPipelineStageFlags sourceStage = 0;
 	VkPipelineStageFlags destinationStage = 0;
 
@@ -68,8 +63,8 @@ void _vk2dImageTransitionImageLayout(VK2DLogicalDevice dev, VkImage image, VkIma
 	barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
 	barrier.image = image;
 	barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-	barrier.subresourceRange.baseMipLevel = 0;
-	barrier.subresourceRange.levelCount = 1;
+	barrier.subresourceRange.baseMipLevel = baseMipLevel;
+	barrier.subresourceRange.levelCount = mipLevels;
 	barrier.subresourceRange.baseArrayLayer = 0;
 	barrier.subresourceRange.layerCount = 1;
 
@@ -97,6 +92,24 @@ void _vk2dImageTransitionImageLayout(VK2DLogicalDevice dev, VkImage image, VkIma
 
 		sourceStage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
 		destinationStage = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT;
+	} else if (oldLayout == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL && newLayout == VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL) {
+		barrier.srcAccessMask = VK_ACCESS_SHADER_READ_BIT;
+		barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+
+		sourceStage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+		destinationStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
+	} else if (oldLayout == VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL && newLayout == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL) {
+		barrier.srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+		barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+
+		sourceStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
+		destinationStage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+	} else if (oldLayout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL && newLayout == VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL) {
+		barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+		barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+
+		sourceStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
+		destinationStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
 	} else {
 		vk2dLogMessage("Unsupported image transition");
 		vk2dErrorCheck(-1);
@@ -110,13 +123,111 @@ void _vk2dImageTransitionImageLayout(VK2DLogicalDevice dev, VkImage image, VkIma
 			0, VK_NULL_HANDLE,
 			1, &barrier
 	);
+}
 
+void _vk2dImageTransitionImageLayout(VK2DLogicalDevice dev, VkImage image, VkImageLayout oldLayout, VkImageLayout newLayout, bool mainThread) {
+	VkCommandBuffer buffer = vk2dLogicalDeviceGetSingleUseBuffer(dev, mainThread);
+	_vk2dImageRecordTransitionImageLayout(buffer, image, oldLayout, newLayout, 0, 1);
 	vk2dLogicalDeviceSubmitSingleBuffer(dev, buffer, mainThread);
 }
 
+// Copies an image sitting in shader-read layout into host memory, pixels must be width * height * 4 bytes
+void _vk2dImageGetPixels(VK2DImage img, void *pixels) {
+	VK2DRenderer gRenderer = vk2dRendererGetPointer();
+	VkDeviceSize imageSize = img->width * img->height * 4;
+	VK2DBuffer stage = vk2dBufferCreate(img->dev, imageSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+										VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+
+	if (vk2dPointerCheck(stage)) {
+		VkBufferImageCopy region = {0};
+		region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+		region.imageSubresource.layerCount = 1;
+		region.imageExtent.width = img->width;
+		region.imageExtent.height = img->height;
+		region.imageExtent.depth = 1;
+
+		// Both transitions and the copy go through one command buffer and one submission
+		VkCommandBuffer commandBuffer = vk2dLogicalDeviceGetSingleUseBuffer(img->dev, true);
+		_vk2dImageRecordTransitionImageLayout(commandBuffer, img->img, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+											  VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, 0, 1);
+		vkCmdCopyImageToBuffer(commandBuffer, img->img, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, stage->buf, 1, &region);
+		_vk2dImageRecordTransitionImageLayout(commandBuffer, img->img, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+											  VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, 0, 1);
+		vk2dLogicalDeviceSubmitSingleBuffer(img->dev, commandBuffer, true);
+
+		void *data;
+		vmaMapMemory(gRenderer->vma, stage->mem, &data);
+		memcpy(pixels, data, imageSize);
+		vmaUnmapMemory(gRenderer->vma, stage->mem);
+
+		vk2dBufferFree(stage);
+	}
+}
+
+// Full mip chain length for a given size
+static uint32_t _vk2dImageMipLevels(uint32_t width, uint32_t height) {
+	uint32_t levels = 1;
+	while (width > 1 || height > 1) {
+		width = width > 1 ? width / 2 : 1;
+		height = height > 1 ? height / 2 : 1;
+		levels++;
+	}
+	return levels;
+}
+
+// Mip levels a loaded image should get - 1 unless mipmaps are enabled and the format can blit
+static uint32_t _vk2dImageLoadMipLevels(VK2DLogicalDevice dev, VkFormat format, uint32_t width, uint32_t height) {
+	VK2DRenderer gRenderer = vk2dRendererGetPointer();
+	if (!gRenderer->config.enableMipmaps)
+		return 1;
+	VkFormatProperties formatProperties;
+	vkGetPhysicalDeviceFormatProperties(dev->pd->dev, format, &formatProperties);
+	if (!(formatProperties.optimalTilingFeatures & VK_FORMAT_FEATURE_BLIT_SRC_BIT) ||
+			!(formatProperties.optimalTilingFeatures & VK_FORMAT_FEATURE_BLIT_DST_BIT) ||
+			!(formatProperties.optimalTilingFeatures & VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT))
+		return 1;
+	return _vk2dImageMipLevels(width, height);
+}
+
+// Downsamples each mip from the level above it, leaving the whole chain shader-readable,
+// expects every level in transfer-dst layout with the top level already filled
+static void _vk2dImageRecordMipBlits(VkCommandBuffer commandBuffer, VK2DImage img) {
+	int32_t mipWidth = img->width;
+	int32_t mipHeight = img->height;
+	for (uint32_t i = 1; i < img->mipLevels; i++) {
+		int32_t nextWidth = mipWidth > 1 ? mipWidth / 2 : 1;
+		int32_t nextHeight = mipHeight > 1 ? mipHeight / 2 : 1;
+		_vk2dImageRecordTransitionImageLayout(commandBuffer, img->img, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+											  VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, i - 1, 1);
+
+		VkImageBlit blit = {0};
+		blit.srcSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+		blit.srcSubresource.mipLevel = i - 1;
+		blit.srcSubresource.layerCount = 1;
+		blit.srcOffsets[1].x = mipWidth;
+		blit.srcOffsets[1].y = mipHeight;
+		blit.srcOffsets[1].z = 1;
+		blit.dstSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+		blit.dstSubresource.mipLevel = i;
+		blit.dstSubresource.layerCount = 1;
+		blit.dstOffsets[1].x = nextWidth;
+		blit.dstOffsets[1].y = nextHeight;
+		blit.dstOffsets[1].z = 1;
+		vkCmdBlitImage(commandBuffer, img->img, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, img->img,
+					   VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &blit, VK_FILTER_LINEAR);
+
+		_vk2dImageRecordTransitionImageLayout(commandBuffer, img->img, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+											  VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, i - 1, 1);
+		mipWidth = nextWidth;
+		mipHeight = nextHeight;
+	}
+	_vk2dImageRecordTransitionImageLayout(commandBuffer, img->img, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+										  VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, img->mipLevels - 1, 1);
+}
+
 // End of internal functions
 
-VK2DImage vk2dImageCreate(VK2DLogicalDevice dev, uint32_t width, uint32_t height, VkFormat format, VkImageAspectFlags aspectMask, VkImageUsageFlags usage, VkSampleCountFlagBits samples) {
+static VK2DImage _vk2dImageCreateMipped(VK2DLogicalDevice dev, uint32_t width, uint32_t height, VkFormat format, VkImageAspectFlags aspectMask, VkImageUsageFlags usage, VkSampleCountFlagBits samples, uint32_t mipLevels) {
 	VK2DRenderer gRenderer = vk2dRendererGetPointer();
 
 	VK2DImage out = malloc(sizeof(struct VK2DImage_t));
@@ -125,14 +236,15 @@ VK2DImage vk2dImageCreate(VK2DLogicalDevice dev, uint32_t width, uint32_t height
 		out->dev = dev;
 		out->width = width;
 		out->height = height;
+		out->mipLevels = mipLevels;
 		out->set = VK_NULL_HANDLE;
-		VkImageCreateInfo imageCreateInfo = vk2dInitImageCreateInfo(width, height, format, usage, 1, samples);
+		VkImageCreateInfo imageCreateInfo = vk2dInitImageCreateInfo(width, height, format, usage, mipLevels, samples);
 		VmaAllocationCreateInfo allocationCreateInfo = {0};
 		allocationCreateInfo.usage = VMA_MEMORY_USAGE_GPU_ONLY;
 		vk2dErrorCheck(vmaCreateImage(gRenderer->vma, &imageCreateInfo, &allocationCreateInfo, &out->img, &out->mem, VK_NULL_HANDLE));
 
 		// Create the image view
-		VkImageViewCreateInfo imageViewCreateInfo = vk2dInitImageViewCreateInfo(out->img, format, aspectMask, 1);
+		VkImageViewCreateInfo imageViewCreateInfo = vk2dInitImageViewCreateInfo(out->img, format, aspectMask, mipLevels);
 		vk2dErrorCheck(vkCreateImageView(dev->dev, &imageViewCreateInfo, NULL, &out->view));
 	} else {
 		free(out);
@@ -142,6 +254,10 @@ VK2DImage vk2dImageCreate(VK2DLogicalDevice dev, uint32_t width, uint32_t height
 	return out;
 }
 
+VK2DImage vk2dImageCreate(VK2DLogicalDevice dev, uint32_t width, uint32_t height, VkFormat format, VkImageAspectFlags aspectMask, VkImageUsageFlags usage, VkSampleCountFlagBits samples) {
+	return _vk2dImageCreateMipped(dev, width, height, format, aspectMask, usage, samples, 1);
+}
+
 VK2DImage vk2dImageLoad(VK2DLogicalDevice dev, const char *filename) {
 	VK2DRenderer gRenderer = vk2dRendererGetPointer();
 	VK2DImage out = NULL;
@@ -165,16 +281,23 @@ VK2DImage vk2dImageLoad(VK2DLogicalDevice dev, const char *filename) {
 
 		stbi_image_free(pixels);
 
-		out = vk2dImageCreate(dev, texWidth, texHeight, VK_FORMAT_R8G8B8A8_SRGB, VK_IMAGE_ASPECT_COLOR_BIT,
-							  VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT, 1);
+		uint32_t mipLevels = _vk2dImageLoadMipLevels(dev, VK_FORMAT_R8G8B8A8_SRGB, texWidth, texHeight);
+		out = _vk2dImageCreateMipped(dev, texWidth, texHeight, VK_FORMAT_R8G8B8A8_SRGB, VK_IMAGE_ASPECT_COLOR_BIT,
+							  VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT | (mipLevels > 1 ? VK_IMAGE_USAGE_TRANSFER_SRC_BIT : 0), 1, mipLevels);
 
 
 		if (vk2dPointerCheck(out)) {
-			_vk2dImageTransitionImageLayout(dev, out->img, VK_IMAGE_LAYOUT_UNDEFINED,
-											VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, true);
-			_vk2dImageCopyBufferToImage(dev, stage->buf, out->img, texWidth, texHeight, true);
-			_vk2dImageTransitionImageLayout(dev, out->img, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-											VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, true);
+			// Transitions, the copy, and the mip cascade all go through one command buffer and one submission
+			VkCommandBuffer commandBuffer = vk2dLogicalDeviceGetSingleUseBuffer(dev, true);
+			_vk2dImageRecordTransitionImageLayout(commandBuffer, out->img, VK_IMAGE_LAYOUT_UNDEFINED,
+												  VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 0, mipLevels);
+			_vk2dImageRecordCopyBufferToImage(commandBuffer, stage->buf, out->img, texWidth, texHeight);
+			if (mipLevels > 1)
+				_vk2dImageRecordMipBlits(commandBuffer, out);
+			else
+				_vk2dImageRecordTransitionImageLayout(commandBuffer, out->img, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+													  VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, 0, 1);
+			vk2dLogicalDeviceSubmitSingleBuffer(dev, commandBuffer, true);
 		}
 
 		vk2dBufferFree(stage);
@@ -183,6 +306,212 @@ VK2DImage vk2dImageLoad(VK2DLogicalDevice dev, const char *filename) {
 	return out;
 }
 
+// Matches the start of a .dds file, legacy fourCC formats and the DX10 extension both appear in the wild
+typedef struct VK2DDdsHeader {
+	uint32_t magic;             ///< Always "DDS "
+	uint32_t size;              ///< Always 124
+	uint32_t flags;             ///< Which header fields are valid
+	uint32_t height;            ///< Height in pixels
+	uint32_t width;             ///< Width in pixels
+	uint32_t pitchOrLinearSize; ///< Size of the top mip in bytes for compressed formats
+	uint32_t depth;             ///< Depth for volume textures
+	uint32_t mipMapCount;       ///< Number of mip levels
+	uint32_t reserved[11];      ///< Unused
+	uint32_t pfSize;            ///< Pixel format struct size, always 32
+	uint32_t pfFlags;           ///< Pixel format flags
+	uint32_t pfFourCC;          ///< Compressed format code
+	uint32_t pfBitCounts[5];    ///< Uncompressed channel masks, unused here
+	uint32_t caps[4];           ///< Capability flags
+	uint32_t reserved2;         ///< Unused
+} VK2DDdsHeader;
+
+// Follows VK2DDdsHeader when the fourCC is "DX10"
+typedef struct VK2DDdsHeaderDx10 {
+	uint32_t dxgiFormat;        ///< DXGI_FORMAT of the payload
+	uint32_t resourceDimension; ///< 3 for 2D textures
+	uint32_t miscFlag;          ///< Cubemap flag and friends
+	uint32_t arraySize;         ///< Number of array layers
+	uint32_t miscFlags2;        ///< Alpha mode
+} VK2DDdsHeaderDx10;
+
+// First 48 bytes of a KTX2 file, the index and level list follow directly
+typedef struct VK2DKtx2Header {
+	uint8_t identifier[12];          ///< File identifier bytes
+	uint32_t vkFormat;               ///< VkFormat of the payload
+	uint32_t typeSize;               ///< Size of a single texel component
+	uint32_t pixelWidth;             ///< Width in pixels
+	uint32_t pixelHeight;            ///< Height in pixels
+	uint32_t pixelDepth;             ///< Depth for volume textures
+	uint32_t layerCount;             ///< Number of array layers
+	uint32_t faceCount;              ///< 6 for cubemaps, 1 otherwise
+	uint32_t levelCount;             ///< Number of mip levels
+	uint32_t supercompressionScheme; ///< 0 means the payload is plain block data
+} VK2DKtx2Header;
+
+// One entry of the KTX2 level index, level 0 sits at byte 80 of the file
+typedef struct VK2DKtx2LevelIndex {
+	uint64_t byteOffset;             ///< Offset of this level's data in the file
+	uint64_t byteLength;             ///< Size of this level's data in bytes
+	uint64_t uncompressedByteLength; ///< Same as byteLength without supercompression
+} VK2DKtx2LevelIndex;
+
+static const uint8_t VK2D_KTX2_IDENTIFIER[12] = {0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A};
+
+// Bytes in one 4x4 block of the given format, or 0 if the format isn't one we upload
+static uint32_t _vk2dImageBlockSize(VkFormat format) {
+	if (format == VK_FORMAT_BC1_RGBA_UNORM_BLOCK || format == VK_FORMAT_BC1_RGBA_SRGB_BLOCK)
+		return 8;
+	if (format == VK_FORMAT_BC3_UNORM_BLOCK || format == VK_FORMAT_BC3_SRGB_BLOCK ||
+			format == VK_FORMAT_BC7_UNORM_BLOCK || format == VK_FORMAT_BC7_SRGB_BLOCK)
+		return 16;
+	return 0;
+}
+
+// Maps a DXGI_FORMAT from a DX10 header to the matching VkFormat, VK_FORMAT_UNDEFINED if unhandled
+static VkFormat _vk2dImageDxgiToVkFormat(uint32_t dxgiFormat) {
+	switch (dxgiFormat) {
+		case 71: return VK_FORMAT_BC1_RGBA_UNORM_BLOCK;
+		case 72: return VK_FORMAT_BC1_RGBA_SRGB_BLOCK;
+		case 77: return VK_FORMAT_BC3_UNORM_BLOCK;
+		case 78: return VK_FORMAT_BC3_SRGB_BLOCK;
+		case 98: return VK_FORMAT_BC7_UNORM_BLOCK;
+		case 99: return VK_FORMAT_BC7_SRGB_BLOCK;
+		default: return VK_FORMAT_UNDEFINED;
+	}
+}
+
+// Pulls format, dimensions, and the level-0 payload out of a DDS or KTX2 blob,
+// returns false if the blob is not a supported container
+static bool _vk2dImageParseCompressed(const void *data, uint32_t size, VkFormat *format, uint32_t *width, uint32_t *height, const void **payload, uint32_t *payloadSize) {
+	const uint8_t *bytes = data;
+	*format = VK_FORMAT_UNDEFINED;
+	*width = 0;
+	*height = 0;
+	*payload = NULL;
+	*payloadSize = 0;
+
+	if (data == NULL)
+		return false;
+
+	if (size >= sizeof(VK2DDdsHeader) && memcmp(bytes, "DDS ", 4) == 0) {
+		const VK2DDdsHeader *header = data;
+		uint32_t dataStart = sizeof(VK2DDdsHeader);
+		if (memcmp(&header->pfFourCC, "DXT1", 4) == 0) {
+			*format = VK_FORMAT_BC1_RGBA_SRGB_BLOCK;
+		} else if (memcmp(&header->pfFourCC, "DXT5", 4) == 0) {
+			*format = VK_FORMAT_BC3_SRGB_BLOCK;
+		} else if (memcmp(&header->pfFourCC, "DX10", 4) == 0 && size >= sizeof(VK2DDdsHeader) + sizeof(VK2DDdsHeaderDx10)) {
+			const VK2DDdsHeaderDx10 *dx10 = (const void*)(bytes + sizeof(VK2DDdsHeader));
+			*format = _vk2dImageDxgiToVkFormat(dx10->dxgiFormat);
+			dataStart += sizeof(VK2DDdsHeaderDx10);
+		}
+		*width = header->width;
+		*height = header->height;
+		*payload = bytes + dataStart;
+		*payloadSize = size - dataStart;
+		return true;
+	}
+
+	if (size >= sizeof(VK2DKtx2Header) && memcmp(bytes, VK2D_KTX2_IDENTIFIER, 12) == 0) {
+		const VK2DKtx2Header *header = data;
+		// Only plain 2D block data - supercompressed, array, cube, and volume payloads are not handled
+		const uint64_t levelIndexStart = 80;
+		if (header->supercompressionScheme == 0 && header->faceCount == 1 && header->layerCount <= 1 &&
+				header->pixelDepth <= 1 && header->levelCount >= 1 &&
+				levelIndexStart + sizeof(VK2DKtx2LevelIndex) <= size) {
+			const VK2DKtx2LevelIndex *level = (const void*)(bytes + levelIndexStart);
+			if (level->byteOffset + level->byteLength <= size) {
+				*format = (VkFormat)header->vkFormat;
+				*width = header->pixelWidth;
+				*height = header->pixelHeight;
+				*payload = bytes + level->byteOffset;
+				*payloadSize = (uint32_t)level->byteLength;
+			}
+		}
+		return true;
+	}
+
+	return false;
+}
+
+// Reads just the dimensions out of a DDS/KTX2 header so streamed textures can report their
+// real size before the payload is anywhere near video memory, data only needs the header bytes
+bool _vk2dImageCompressedDims(const void *data, uint32_t size, uint32_t *width, uint32_t *height) {
+	const uint8_t *bytes = data;
+	*width = 0;
+	*height = 0;
+
+	if (data == NULL)
+		return false;
+
+	if (size >= sizeof(VK2DDdsHeader) && memcmp(bytes, "DDS ", 4) == 0) {
+		const VK2DDdsHeader *header = data;
+		*width = header->width;
+		*height = header->height;
+		return true;
+	}
+
+	if (size >= sizeof(VK2DKtx2Header) && memcmp(bytes, VK2D_KTX2_IDENTIFIER, 12) == 0) {
+		const VK2DKtx2Header *header = data;
+		*width = header->pixelWidth;
+		*height = header->pixelHeight;
+		return true;
+	}
+
+	return false;
+}
+
+VK2DImage _vk2dImageFromCompressed(VK2DLogicalDevice dev, const void *data, uint32_t size, bool mainThread) {
+	VK2DRenderer gRenderer = vk2dRendererGetPointer();
+	VK2DImage out = NULL;
+	VkFormat format;
+	uint32_t width, height, payloadSize;
+	const void *payload;
+
+	if (!_vk2dImageParseCompressed(data, size, &format, &width, &height, &payload, &payloadSize))
+		return NULL;
+
+	uint32_t blockSize = _vk2dImageBlockSize(format);
+	uint64_t expectedSize = (uint64_t)((width + 3) / 4) * ((height + 3) / 4) * blockSize;
+	VkFormatProperties formatProperties;
+	vkGetPhysicalDeviceFormatProperties(dev->pd->dev, format, &formatProperties);
+
+	if (blockSize == 0 || width == 0 || height == 0 || expectedSize > payloadSize) {
+		vk2dLogMessage("Compressed image payload is not a supported BC format or is truncated.");
+	} else if (!(formatProperties.optimalTilingFeatures & VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT)) {
+		vk2dLogMessage("Device cannot sample compressed image format %i.", format);
+	} else {
+		// Block data is already GPU-ready so it stages and uploads as-is, no CPU decode
+		VK2DBuffer stage = vk2dBufferCreate(dev, expectedSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+											VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+
+		if (vk2dPointerCheck(stage)) {
+			void *stageData;
+			vmaMapMemory(gRenderer->vma, stage->mem, &stageData);
+			memcpy(stageData, payload, expectedSize);
+			vmaUnmapMemory(gRenderer->vma, stage->mem);
+
+			out = vk2dImageCreate(dev, width, height, format, VK_IMAGE_ASPECT_COLOR_BIT,
+								  VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT, 1);
+
+			if (vk2dPointerCheck(out)) {
+				// Both transitions and the copy go through one command buffer and one submission
+				VkCommandBuffer commandBuffer = vk2dLogicalDeviceGetSingleUseBuffer(dev, mainThread);
+				_vk2dImageRecordTransitionImageLayout(commandBuffer, out->img, VK_IMAGE_LAYOUT_UNDEFINED,
+													  VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 0, 1);
+				_vk2dImageRecordCopyBufferToImage(commandBuffer, stage->buf, out->img, width, height);
+				_vk2dImageRecordTransitionImageLayout(commandBuffer, out->img, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+													  VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, 0, 1);
+				vk2dLogicalDeviceSubmitSingleBuffer(dev, commandBuffer, mainThread);
+			}
+
+			vk2dBufferFree(stage);
+		}
+	}
+
+	return out;
+}
+
 VK2DImage vk2dImageFromPixels(VK2DLogicalDevice dev, void *pixels, int w, int h, bool mainThread) {
 	VK2DRenderer gRenderer = vk2dRendererGetPointer();
 	VK2DImage out = NULL;
@@ -197,16 +526,23 @@ VK2DImage vk2dImageFromPixels(VK2DLogicalDevice dev, void *pixels, int w, int h,
 		memcpy(data, pixels, w * h * 4);
 		vmaUnmapMemory(gRenderer->vma, stage->mem);
 
-		out = vk2dImageCreate(dev, w, h, VK_FORMAT_R8G8B8A8_SRGB, VK_IMAGE_ASPECT_COLOR_BIT,
-							  VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT, 1);
+		uint32_t mipLevels = _vk2dImageLoadMipLevels(dev, VK_FORMAT_R8G8B8A8_SRGB, w, h);
+		out = _vk2dImageCreateMipped(dev, w, h, VK_FORMAT_R8G8B8A8_SRGB, VK_IMAGE_ASPECT_COLOR_BIT,
+							  VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT | (mipLevels > 1 ? VK_IMAGE_USAGE_TRANSFER_SRC_BIT : 0), 1, mipLevels);
 
 
 		if (vk2dPointerCheck(out)) {
-			_vk2dImageTransitionImageLayout(dev, out->img, VK_IMAGE_LAYOUT_UNDEFINED,
-											VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, mainThread);
-			_vk2dImageCopyBufferToImage(dev, stage->buf, out->img, w, h, mainThread);
-			_vk2dImageTransitionImageLayout(dev, out->img, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-											VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, mainThread);
+			// Transitions, the copy, and the mip cascade all go through one command buffer and one submission
+			VkCommandBuffer commandBuffer = vk2dLogicalDeviceGetSingleUseBuffer(dev, mainThread);
+			_vk2dImageRecordTransitionImageLayout(commandBuffer, out->img, VK_IMAGE_LAYOUT_UNDEFINED,
+												  VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 0, mipLevels);
+			_vk2dImageRecordCopyBufferToImage(commandBuffer, stage->buf, out->img, w, h);
+			if (mipLevels > 1)
+				_vk2dImageRecordMipBlits(commandBuffer, out);
+			else
+				_vk2dImageRecordTransitionImageLayout(commandBuffer, out->img, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+													  VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, 0, 1);
+			vk2dLogicalDeviceSubmitSingleBuffer(dev, commandBuffer, mainThread);
 		}
 
 		vk2dBufferFree(stage);
@@ -375,6 +375,16 @@ VkGraphicsPipelineCreateInfo vk2dInitGraphicsPipelineCreateInfo(VkPipelineShader
 	return graphicsPipelineCreateInfo;
 }
 
+VkComputePipelineCreateInfo vk2dInitComputePipelineCreateInfo(VkPipelineShaderStageCreateInfo shaderStage, VkPipelineLayout layout) {
+	VkComputePipelineCreateInfo computePipelineCreateInfo = {0};
+	computePipelineCreateInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+	computePipelineCreateInfo.stage = shaderStage;
+	computePipelineCreateInfo.layout = layout;
+	computePipelineCreateInfo.basePipelineHandle = VK_NULL_HANDLE;
+	computePipelineCreateInfo.basePipelineIndex = -1;
+	return computePipelineCreateInfo;
+}
+
 VkVertexInputBindingDescription vk2dInitVertexInputBindingDescription(VkVertexInputRate input, uint32_t stride, uint32_t binding) {
 	VkVertexInputBindingDescription vertexInputBindingDescription = {0};
 	vertexInputBindingDescription.binding = binding;
@@ -453,10 +463,10 @@ VkSamplerCreateInfo vk2dInitSamplerCreateInfo(VkBool32 linearFilter, float aniso
 	samplerCreateInfo.unnormalizedCoordinates = VK_TRUE;
 	samplerCreateInfo.compareEnable = VK_FALSE;
 	samplerCreateInfo.compareOp = VK_COMPARE_OP_ALWAYS;
-	samplerCreateInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+	samplerCreateInfo.mipmapMode = mipLevels > 1 ? VK_SAMPLER_MIPMAP_MODE_LINEAR : VK_SAMPLER_MIPMAP_MODE_NEAREST;
 	samplerCreateInfo.mipLodBias = 0;
 	samplerCreateInfo.minLod = 0;
-	samplerCreateInfo.maxLod = 0;
+	samplerCreateInfo.maxLod = mipLevels > 1 ? mipLevels : 0;
 	return samplerCreateInfo;
 }
 
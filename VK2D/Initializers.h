@@ -40,6 +40,7 @@ VkPipelineColorBlendStateCreateInfo vk2dInitPipelineColorBlendStateCreateInfo(Vk
 VkPipelineDynamicStateCreateInfo vk2dInitPipelineDynamicStateCreateInfo(VkDynamicState *states, uint32_t stateCount);
 VkPipelineLayoutCreateInfo vk2dInitPipelineLayoutCreateInfo(VkDescriptorSetLayout *layouts, uint32_t layoutCount, uint32_t pushConstantCount, VkPushConstantRange *pushConstants);
 VkGraphicsPipelineCreateInfo vk2dInitGraphicsPipelineCreateInfo(VkPipelineShaderStageCreateInfo *shaderStages, uint32_t stageCount, VkPipelineVertexInputStateCreateInfo *vertexInputInfo, VkPipelineInputAssemblyStateCreateInfo *inputAssembly, VkPipelineViewportStateCreateInfo *viewport, VkPipelineRasterizationStateCreateInfo *rasterizer, VkPipelineMultisampleStateCreateInfo *multisampling, VkPipelineDepthStencilStateCreateInfo *depthStencil, VkPipelineColorBlendStateCreateInfo *colourBlending, VkPipelineDynamicStateCreateInfo *dynamicState, VkPipelineLayout layout, VkRenderPass renderPass);
+VkComputePipelineCreateInfo vk2dInitComputePipelineCreateInfo(VkPipelineShaderStageCreateInfo shaderStage, VkPipelineLayout layout);
 VkVertexInputBindingDescription vk2dInitVertexInputBindingDescription(VkVertexInputRate input, uint32_t stride, uint32_t binding);
 VkVertexInputAttributeDescription vk2dInitVertexInputAttributeDescription(uint32_t location, uint32_t binding, VkFormat format, uint32_t offset);
 VkBufferCreateInfo vk2dInitBufferCreateInfo(VkDeviceSize size, VkBufferUsageFlags usage, uint32_t *queueFamilies, uint32_t queueFamilyCount);
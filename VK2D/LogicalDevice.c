@@ -40,29 +40,108 @@ VK2DLogicalDevice vk2dLogicalDeviceCreate(VK2DPhysicalDevice dev, bool enableAll
 			}
 		}
 
+		// Descriptor indexing is optional, it powers the bindless texture array for custom shaders
+		bool descriptorIndexing = false;
+		uint32_t extensionCount = 0;
+		vkEnumerateDeviceExtensionProperties(dev->dev, VK_NULL_HANDLE, &extensionCount, VK_NULL_HANDLE);
+		VkExtensionProperties *extensions = malloc(sizeof(VkExtensionProperties) * extensionCount);
+		if (vk2dPointerCheck(extensions)) {
+			vkEnumerateDeviceExtensionProperties(dev->dev, VK_NULL_HANDLE, &extensionCount, extensions);
+			for (uint32_t i = 0; i < extensionCount; i++)
+				if (strcmp(extensions[i].extensionName, VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME) == 0)
+					descriptorIndexing = true;
+			free(extensions);
+		}
+
+		VkPhysicalDeviceDescriptorIndexingFeaturesEXT indexingFeatures = {VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT};
+		if (descriptorIndexing) {
+			VkPhysicalDeviceFeatures2 feats2 = {VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2};
+			feats2.pNext = &indexingFeatures;
+			vkGetPhysicalDeviceFeatures2(dev->dev, &feats2);
+			descriptorIndexing = indexingFeatures.runtimeDescriptorArray &&
+					indexingFeatures.descriptorBindingPartiallyBound &&
+					indexingFeatures.descriptorBindingSampledImageUpdateAfterBind &&
+					indexingFeatures.shaderSampledImageArrayNonUniformIndexing;
+		}
+		limits->supportsTextureArray = descriptorIndexing;
+
+		// The compute and transfer families get their own queue when they differ from the
+		// family this device is built on, otherwise that work shares the main queue
+		bool separateComputeQueue = dev->QueueFamily.computeFamily != queueFamily;
+		bool separateTransferQueue = dev->QueueFamily.transferFamily != queueFamily;
 		float priority[] = {1, 1};
 		VkDeviceQueueCreateInfo queueCreateInfo = vk2dInitDeviceQueueCreateInfo(queueFamily, priority);
 		queueCreateInfo.queueCount = 2;
-		VkDeviceQueueCreateInfo queues[] = {queueCreateInfo};
-		VkDeviceCreateInfo deviceCreateInfo = vk2dInitDeviceCreateInfo(queues, 1, &feats, debug);
+		VkDeviceQueueCreateInfo computeQueueCreateInfo = vk2dInitDeviceQueueCreateInfo(dev->QueueFamily.computeFamily, priority);
+		VkDeviceQueueCreateInfo transferQueueCreateInfo = vk2dInitDeviceQueueCreateInfo(dev->QueueFamily.transferFamily, priority);
+		VkDeviceQueueCreateInfo queues[3];
+		uint32_t queueCreateCount = 0;
+		queues[queueCreateCount++] = queueCreateInfo;
+		if (separateComputeQueue)
+			queues[queueCreateCount++] = computeQueueCreateInfo;
+		if (separateTransferQueue)
+			queues[queueCreateCount++] = transferQueueCreateInfo;
+		VkDeviceCreateInfo deviceCreateInfo = vk2dInitDeviceCreateInfo(queues, queueCreateCount, &feats, debug);
+
+		// Only the features the array needs are enabled, not everything the extension offers
+		const char *extensionsWithIndexing[] = {VK_KHR_SWAPCHAIN_EXTENSION_NAME, VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME};
+		VkPhysicalDeviceDescriptorIndexingFeaturesEXT enabledIndexingFeatures = {VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT};
+		if (descriptorIndexing) {
+			enabledIndexingFeatures.runtimeDescriptorArray = VK_TRUE;
+			enabledIndexingFeatures.descriptorBindingPartiallyBound = VK_TRUE;
+			enabledIndexingFeatures.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+			enabledIndexingFeatures.shaderSampledImageArrayNonUniformIndexing = VK_TRUE;
+			deviceCreateInfo.pNext = &enabledIndexingFeatures;
+			deviceCreateInfo.ppEnabledExtensionNames = extensionsWithIndexing;
+			deviceCreateInfo.enabledExtensionCount = 2;
+		}
+
 		vk2dErrorCheck(vkCreateDevice(dev->dev, &deviceCreateInfo, VK_NULL_HANDLE, &ldev->dev));
 		ldev->pd = dev;
 		vkGetDeviceQueue(ldev->dev, queueFamily, 0, &ldev->queue);
 		vkGetDeviceQueue(ldev->dev, queueFamily, 1, &ldev->loadQueue);
+		if (separateComputeQueue)
+			vkGetDeviceQueue(ldev->dev, dev->QueueFamily.computeFamily, 0, &ldev->computeQueue);
+		else
+			ldev->computeQueue = ldev->queue;
+		if (separateTransferQueue)
+			vkGetDeviceQueue(ldev->dev, dev->QueueFamily.transferFamily, 0, &ldev->transferQueue);
+		else
+			ldev->transferQueue = ldev->queue;
 
 		VkCommandPoolCreateInfo commandPoolCreateInfo = vk2dInitCommandPoolCreateInfo(queueFamily, VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT);
 		vk2dErrorCheck(vkCreateCommandPool(ldev->dev, &commandPoolCreateInfo, VK_NULL_HANDLE, &ldev->pool));
+		VkCommandPoolCreateInfo computeCommandPoolCreateInfo = vk2dInitCommandPoolCreateInfo(dev->QueueFamily.computeFamily, VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT);
+		vk2dErrorCheck(vkCreateCommandPool(ldev->dev, &computeCommandPoolCreateInfo, VK_NULL_HANDLE, &ldev->computePool));
+		VkCommandPoolCreateInfo transferCommandPoolCreateInfo = vk2dInitCommandPoolCreateInfo(dev->QueueFamily.transferFamily, VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT);
+		vk2dErrorCheck(vkCreateCommandPool(ldev->dev, &transferCommandPoolCreateInfo, VK_NULL_HANDLE, &ldev->transferPool));
 
 		ldev->loadList = NULL;
 		ldev->loadListMutex = SDL_CreateMutex();
+		ldev->loadQueueMutex = SDL_CreateMutex();
 		ldev->shaderMutex = SDL_CreateMutex();
+		ldev->loadPoolTLS = SDL_TLSCreate();
 		ldev->loadListSize = 0;
 		ldev->quitThread = false;
 		ldev->loads = 0;
+		ldev->loadsInProgress = 0;
+		ldev->streamList = NULL;
+		ldev->streamListSize = 0;
+		ldev->streamCount = 0;
+		ldev->streamDoneList = NULL;
+		ldev->streamDoneListSize = 0;
+		ldev->streamDoneCount = 0;
+		ldev->streamListMutex = SDL_CreateMutex();
 		gDeviceFromMainThread = ldev;
-		ldev->workerThread = SDL_CreateThread(_vk2dWorkerThread, "VK2D_Load", NULL);
 
-		if (ldev->loadListMutex == NULL || ldev->workerThread == NULL) {
+		// Worker threads share the load list but decode assets concurrently
+		bool threadsCreated = true;
+		for (int i = 0; i < VK2D_WORKER_THREAD_COUNT; i++) {
+			ldev->workerThreads[i] = SDL_CreateThread(_vk2dWorkerThread, "VK2D_Load", (void*)(intptr_t)i);
+			threadsCreated = threadsCreated && ldev->workerThreads[i] != NULL;
+		}
+
+		if (ldev->loadListMutex == NULL || ldev->loadQueueMutex == NULL || ldev->streamListMutex == NULL || ldev->loadPoolTLS == 0 || !threadsCreated) {
 			vk2dLogMessage("Failed to initialize off-thread loading: %s", SDL_GetError());
 		}
 	}
@@ -74,12 +153,20 @@ void vk2dLogicalDeviceFree(VK2DLogicalDevice dev) {
 	if (dev != NULL) {
 		dev->quitThread = true;
 		int status;
-		SDL_WaitThread(dev->workerThread, &status);
+		for (int i = 0; i < VK2D_WORKER_THREAD_COUNT; i++)
+			SDL_WaitThread(dev->workerThreads[i], &status);
 		vkDestroyCommandPool(dev->dev, dev->pool, VK_NULL_HANDLE);
-		vkDestroyCommandPool(dev->dev, dev->loadPool, VK_NULL_HANDLE);
+		vkDestroyCommandPool(dev->dev, dev->computePool, VK_NULL_HANDLE);
+		vkDestroyCommandPool(dev->dev, dev->transferPool, VK_NULL_HANDLE);
+		for (int i = 0; i < VK2D_WORKER_THREAD_COUNT; i++)
+			vkDestroyCommandPool(dev->dev, dev->loadPools[i], VK_NULL_HANDLE);
 		vkDestroyDevice(dev->dev, VK_NULL_HANDLE);
 		SDL_DestroyMutex(dev->loadListMutex);
+		SDL_DestroyMutex(dev->loadQueueMutex);
 		SDL_DestroyMutex(dev->shaderMutex);
+		SDL_DestroyMutex(dev->streamListMutex);
+		free(dev->streamList);
+		free(dev->streamDoneList);
 		free(dev);
 	}
 }
@@ -96,6 +183,13 @@ VkCommandBuffer vk2dLogicalDeviceGetCommandBuffer(VK2DLogicalDevice dev, bool pr
 	return buffer;
 }
 
+VkCommandBuffer vk2dLogicalDeviceGetTransferCommandBuffer(VK2DLogicalDevice dev) {
+	VkCommandBufferAllocateInfo allocInfo = vk2dInitCommandBufferAllocateInfo(dev->transferPool, 1);
+	VkCommandBuffer buffer;
+	vk2dErrorCheck(vkAllocateCommandBuffers(dev->dev, &allocInfo, &buffer));
+	return buffer;
+}
+
 void vk2dLogicalDeviceGetCommandBuffers(VK2DLogicalDevice dev, bool primary, uint32_t n, VkCommandBuffer *list) {
 	VkCommandBufferAllocateInfo allocInfo = vk2dInitCommandBufferAllocateInfo(dev->pool, n);
 	allocInfo.level = primary ? VK_COMMAND_BUFFER_LEVEL_PRIMARY : VK_COMMAND_BUFFER_LEVEL_SECONDARY;
@@ -108,8 +202,11 @@ void vk2dLogicalDeviceFreeCommandBuffer(VK2DLogicalDevice dev, VkCommandBuffer b
 
 VkCommandBuffer vk2dLogicalDeviceGetSingleUseBuffer(VK2DLogicalDevice dev, bool mainThread) {
 	VkCommandBufferAllocateInfo allocInfo = vk2dInitCommandBufferAllocateInfo(dev->pool, 1);
-	if (!mainThread)
-		allocInfo.commandPool = dev->loadPool;
+	if (!mainThread) {
+		// Each worker thread allocates from its own pool
+		VkCommandPool *loadPool = SDL_TLSGet(dev->loadPoolTLS);
+		allocInfo.commandPool = *loadPool;
+	}
 	VkCommandBuffer buffer;
 	vk2dErrorCheck(vkAllocateCommandBuffers(dev->dev, &allocInfo, &buffer));
 	VkCommandBufferBeginInfo beginInfo = vk2dInitCommandBufferBeginInfo(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT, VK_NULL_HANDLE);
@@ -125,9 +222,13 @@ void vk2dLogicalDeviceSubmitSingleBuffer(VK2DLogicalDevice dev, VkCommandBuffer
 		vkQueueWaitIdle(dev->queue);
 		vkFreeCommandBuffers(dev->dev, dev->pool, 1, &buffer);
 	} else {
+		// Worker threads share the load queue so submissions are serialized on it
+		VkCommandPool *loadPool = SDL_TLSGet(dev->loadPoolTLS);
+		SDL_LockMutex(dev->loadQueueMutex);
 		vkQueueSubmit(dev->loadQueue, 1, &submitInfo, VK_NULL_HANDLE);
 		vkQueueWaitIdle(dev->loadQueue);
-		vkFreeCommandBuffers(dev->dev, dev->loadPool, 1, &buffer);
+		SDL_UnlockMutex(dev->loadQueueMutex);
+		vkFreeCommandBuffers(dev->dev, *loadPool, 1, &buffer);
 	}
 }
 
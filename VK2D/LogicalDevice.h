@@ -50,6 +50,11 @@ void vk2dLogicalDeviceResetPool(VK2DLogicalDevice dev);
 /// \return Returns a VkCommandBuffer in the initial state (see Vulkan spec for more info on command buffer states)
 VkCommandBuffer vk2dLogicalDeviceGetCommandBuffer(VK2DLogicalDevice dev, bool primary);
 
+/// \brief Gets a primary command buffer that may be submitted to the device's transfer queue
+/// \param dev Logical device to get the buffer from
+/// \return Returns a VkCommandBuffer in the initial state
+VkCommandBuffer vk2dLogicalDeviceGetTransferCommandBuffer(VK2DLogicalDevice dev);
+
 /// \brief Fills a list with new command buffers
 /// \param dev Device to get the buffers from
 /// \param pool Pool to get the buffers from
@@ -38,6 +38,16 @@
 #include <math.h>
 #include <malloc.h>
 
+// Matrix kernels use vector instructions when the target supports them, the
+// scalar versions below are kept as the fallback for everything else
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define VK2D_MATH_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define VK2D_MATH_NEON
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -97,10 +107,42 @@ void multiplyVector(float a[], float b[], float c[])
 
 void multiplyMatrix(float a[], float b[], float c[])
 {
+#if defined(VK2D_MATH_SSE2)
+	__m128 b0 = _mm_loadu_ps(&b[0]);
+	__m128 b1 = _mm_loadu_ps(&b[4]);
+	__m128 b2 = _mm_loadu_ps(&b[8]);
+	__m128 b3 = _mm_loadu_ps(&b[12]);
+
+	for(int row = 0; row < 4; row++)
+	{
+		__m128 sum = _mm_loadu_ps(&c[4 * row]);
+		sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(a[4 * row + 0]), b0));
+		sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(a[4 * row + 1]), b1));
+		sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(a[4 * row + 2]), b2));
+		sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(a[4 * row + 3]), b3));
+		_mm_storeu_ps(&c[4 * row], sum);
+	}
+#elif defined(VK2D_MATH_NEON)
+	float32x4_t b0 = vld1q_f32(&b[0]);
+	float32x4_t b1 = vld1q_f32(&b[4]);
+	float32x4_t b2 = vld1q_f32(&b[8]);
+	float32x4_t b3 = vld1q_f32(&b[12]);
+
+	for(int row = 0; row < 4; row++)
+	{
+		float32x4_t sum = vld1q_f32(&c[4 * row]);
+		sum = vmlaq_n_f32(sum, b0, a[4 * row + 0]);
+		sum = vmlaq_n_f32(sum, b1, a[4 * row + 1]);
+		sum = vmlaq_n_f32(sum, b2, a[4 * row + 2]);
+		sum = vmlaq_n_f32(sum, b3, a[4 * row + 3]);
+		vst1q_f32(&c[4 * row], sum);
+	}
+#else
 	for(int row = 0; row < 4; row++)
 		for(int col = 0; col < 4; col++)
 			for(int itr = 0; itr < 4; itr++)
 				c[4 * row + col] += a[4 * row + itr] * b[4 * itr + col];
+#endif
 }
 
 void scaleVector(float v[], float t)
@@ -9,6 +9,9 @@
 #include "VK2D/Validation.h"
 #include "VK2D/Opaque.h"
 #include "VK2D/Util.h"
+#include <string.h>
+
+bool _vk2dRendererDeferFree(void (*freeFunc)(void*), void *resource);
 
 // Needed to use buffers for tinyobjloader
 static const void *gTinyObjBuffer;
@@ -52,11 +55,34 @@ static inline bool verticesAreEqual(VK2DVertex3D *v1, VK2DVertex3D *v2) {
 	return false;
 }
 
-VK2DModel _vk2dModelFromInternal(const void *objFile, uint32_t objFileSize, VK2DTexture texture, bool mainThread) {
+// FNV-1a over a vertex's position and uv so welding is a table probe instead of a list scan
+static inline uint32_t _vk2dVertexHash(VK2DVertex3D *v) {
+	const float fields[] = {v->pos[0], v->pos[1], v->pos[2], v->uv[0], v->uv[1]};
+	const uint8_t *bytes = (const uint8_t*)fields;
+	uint32_t hash = 2166136261u;
+	for (int i = 0; i < sizeof(fields); i++) {
+		hash ^= bytes[i];
+		hash *= 16777619u;
+	}
+	return hash;
+}
+
+// On-disk header for pre-baked binary models, vertices then indices follow directly
+typedef struct VK2DModelHeader {
+	char magic[8];        ///< Always "VK2DMODL"
+	uint32_t version;     ///< Format version, currently 1
+	uint32_t vertexCount; ///< Number of VK2DVertex3D after the header
+	uint32_t indexCount;  ///< Number of uint16_t indices after the vertices
+} VK2DModelHeader;
+
+static const char *VK2D_MODEL_MAGIC = "VK2DMODL";
+#define VK2D_MODEL_VERSION 1
+
+// Parses a .obj blob into malloc'd vertex/index lists the caller must free, returns false on parse failure
+static bool _vk2dModelParseObj(const void *objFile, uint32_t objFileSize, VK2DVertex3D **outVertices, uint32_t *outVertexCount, uint16_t **outIndices, uint32_t *outIndexCount) {
 	gTinyObjBuffer = objFile;
 	gTinyObjBufferSize = objFileSize;
-	VK2DModel m = NULL;
-	bool error = false;
+	bool success = false;
 
 	tinyobj_attrib_t attrib;
 	tinyobj_shape_t* shapes = NULL;
@@ -69,10 +95,18 @@ VK2DModel _vk2dModelFromInternal(const void *objFile, uint32_t objFileSize, VK2D
 		// Create lists for the worst case, actual parsed indices/vertices will likely we less
 		VK2DVertex3D *vertices = malloc(sizeof(VK2DVertex3D) * attrib.num_faces * 3);
 		uint16_t *indices = malloc(sizeof(uint16_t) * attrib.num_faces * 3);
-		int vertexCount = 0;
-		int indexCount = 0;
-
-		if (vk2dPointerCheck(vertices) && vk2dPointerCheck(indices)) {
+		uint32_t vertexCount = 0;
+		uint32_t indexCount = 0;
+
+		// Hash table over the whole vertex list so every duplicate welds, kept
+		// at most half full so linear probes stay short
+		uint32_t tableSize = 1;
+		while (tableSize < attrib.num_faces * 3 * 2)
+			tableSize *= 2;
+		uint32_t *table = malloc(sizeof(uint32_t) * tableSize);
+
+		if (vk2dPointerCheck(vertices) && vk2dPointerCheck(indices) && vk2dPointerCheck(table)) {
+			memset(table, 0xFF, sizeof(uint32_t) * tableSize);
 			for (int faceIndex = 0; faceIndex < attrib.num_faces; faceIndex++) {
 				VK2DVertex3D vertex = {0};
 
@@ -85,35 +119,64 @@ VK2DModel _vk2dModelFromInternal(const void *objFile, uint32_t objFileSize, VK2D
 				vertex.uv[0] = attrib.texcoords[(textureIndex * 2) + 0];
 				vertex.uv[1] = 1 - attrib.texcoords[(textureIndex * 2) + 1];
 
-				// Check if this vertex is the same as any of the previous 6 (kinda arbitrary)
-				int found = -1;
-				for (int i = 0; i < vertexIndex && found == -1; i++)
-					if (verticesAreEqual(&vertex, &vertices[i]))
-						found = i;
+				// Probe for this exact vertex among everything stored so far
+				uint32_t slot = _vk2dVertexHash(&vertex) & (tableSize - 1);
+				while (table[slot] != UINT32_MAX && !verticesAreEqual(&vertex, &vertices[table[slot]]))
+					slot = (slot + 1) & (tableSize - 1);
 
-				if (found != -1) {
-					// Vertex is already at vertices[found]
-					indices[indexCount++] = found;
+				if (table[slot] != UINT32_MAX) {
+					// Vertex is already in the list
+					indices[indexCount++] = table[slot];
 				} else {
 					// Vertex was not found in the vertex list
+					table[slot] = vertexCount;
 					vertices[vertexCount++] = vertex;
 					indices[indexCount++] = vertexCount - 1;
 				}
 			}
-
-			m = _vk2dModelCreateInternal(vertices, vertexCount, indices, indexCount, texture, mainThread);
+			if (vertexCount > UINT16_MAX)
+				vk2dLogMessage("Model has %i unique vertices, more than the 16-bit index list can address.", vertexCount);
+
+			*outVertices = vertices;
+			*outVertexCount = vertexCount;
+			*outIndices = indices;
+			*outIndexCount = indexCount;
+			success = true;
 		} else {
-			error = true;
-			m = NULL;
+			free(vertices);
+			free(indices);
 		}
-		free(vertices);
-		free(indices);
+		free(table);
 		tinyobj_attrib_free(&attrib);
 		tinyobj_shapes_free(shapes, num_shapes);
 		tinyobj_materials_free(materials, num_materials);
-	} else {
-		error = true;
-		m = NULL;
+	}
+
+	return success;
+}
+
+VK2DModel _vk2dModelFromInternal(const void *objFile, uint32_t objFileSize, VK2DTexture texture, bool mainThread) {
+	VK2DModel m = NULL;
+
+	// Pre-baked binary models skip parsing entirely - the blob is already upload-ready
+	if (objFile != NULL && objFileSize >= sizeof(VK2DModelHeader) && memcmp(objFile, VK2D_MODEL_MAGIC, 8) == 0) {
+		const VK2DModelHeader *header = objFile;
+		uint64_t expected = sizeof(VK2DModelHeader) + ((uint64_t)header->vertexCount * sizeof(VK2DVertex3D)) + ((uint64_t)header->indexCount * sizeof(uint16_t));
+		if (header->version == VK2D_MODEL_VERSION && expected <= objFileSize) {
+			const VK2DVertex3D *vertices = (const VK2DVertex3D*)((const uint8_t*)objFile + sizeof(VK2DModelHeader));
+			const uint16_t *indices = (const uint16_t*)(vertices + header->vertexCount);
+			m = _vk2dModelCreateInternal(vertices, header->vertexCount, indices, header->indexCount, texture, mainThread);
+		}
+		return m;
+	}
+
+	VK2DVertex3D *vertices;
+	uint16_t *indices;
+	uint32_t vertexCount, indexCount;
+	if (_vk2dModelParseObj(objFile, objFileSize, &vertices, &vertexCount, &indices, &indexCount)) {
+		m = _vk2dModelCreateInternal(vertices, vertexCount, indices, indexCount, texture, mainThread);
+		free(vertices);
+		free(indices);
 	}
 
 	return m;
@@ -129,17 +192,61 @@ VK2DModel vk2dModelFrom(const void *objFile, uint32_t objFileSize, VK2DTexture t
 VK2DModel vk2dModelLoad(const char *objFile, VK2DTexture texture) {
 	VK2DModel m = NULL;
 	uint32_t size;
-	const void *data = _vk2dLoadFile(objFile, &size);
+	void *mapping;
+	// Mapped so big models parse straight from the page cache instead of a heap copy
+	const void *data = _vk2dMapFile(objFile, &size, &mapping);
 	m = _vk2dModelFromInternal(data, size, texture, true);
-	free((void*)data);
+	_vk2dUnmapFile((unsigned char*)data, mapping);
 	if (m == NULL)
 		vk2dLogMessage("Failed to create model from \"%s\".", objFile);
 	return m;
 }
 
+bool vk2dModelConvertObj(const char *objFilename, const char *outputFilename) {
+	bool success = false;
+	uint32_t size;
+	void *mapping;
+	const void *data = _vk2dMapFile(objFilename, &size, &mapping);
+
+	VK2DVertex3D *vertices;
+	uint16_t *indices;
+	uint32_t vertexCount, indexCount;
+	if (data != NULL && _vk2dModelParseObj(data, size, &vertices, &vertexCount, &indices, &indexCount)) {
+		FILE *file = fopen(outputFilename, "wb");
+		if (file != NULL) {
+			VK2DModelHeader header = {0};
+			memcpy(header.magic, VK2D_MODEL_MAGIC, 8);
+			header.version = VK2D_MODEL_VERSION;
+			header.vertexCount = vertexCount;
+			header.indexCount = indexCount;
+			fwrite(&header, sizeof(VK2DModelHeader), 1, file);
+			fwrite(vertices, sizeof(VK2DVertex3D), vertexCount, file);
+			fwrite(indices, sizeof(uint16_t), indexCount, file);
+			fclose(file);
+			success = true;
+		} else {
+			vk2dLogMessage("Failed to open \"%s\" for writing.", outputFilename);
+		}
+		free(vertices);
+		free(indices);
+	} else {
+		vk2dLogMessage("Failed to parse model \"%s\".", objFilename);
+	}
+	_vk2dUnmapFile((unsigned char*)data, mapping);
+
+	return success;
+}
+
+// Destroys the model's buffer for real, only safe once no in-flight frame references it
+static void _vk2dModelDestroy(void *mdl) {
+	VK2DModel model = mdl;
+	vk2dBufferFree(model->vertices);
+	free(model);
+}
+
 void vk2dModelFree(VK2DModel model) {
 	if (model != NULL) {
-		vk2dBufferFree(model->vertices);
-		free(model);
+		if (!_vk2dRendererDeferFree(_vk2dModelDestroy, model))
+			_vk2dModelDestroy(model);
 	}
 }
\ No newline at end of file
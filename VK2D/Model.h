@@ -19,21 +19,31 @@ extern "C" {
 /// \warning The input must be triangulated.
 VK2DModel vk2dModelCreate(const VK2DVertex3D *vertices, uint32_t vertexCount, const uint16_t *indices, uint32_t indexCount, VK2DTexture tex);
 
-/// \brief Loads a .obj model from a binary buffer
-/// \param objFile .obj file binary buffer
+/// \brief Loads a .obj or pre-baked binary model from a binary buffer
+/// \param objFile .obj file or pre-baked model binary buffer
 /// \param objFileSize Size of the buffer in bytes
-/// \param texture Texture the .obj file expects
+/// \param texture Texture the model expects
 /// \return Returns a new model or NULL if it fails
-/// \warning This function is very taxing as it builds a proper index list from the loaded model to save video memory
+/// \warning For .obj input this function is very taxing as it builds a proper index list from the loaded model to save video memory, pre-baked models (see vk2dModelConvertObj) upload as-is
 VK2DModel vk2dModelFrom(const void *objFile, uint32_t objFileSize, VK2DTexture texture);
 
-/// \brief Loads a model from a .obj file
-/// \param objFile Path to the .obj file
-/// \param texture Texture the .obj file expects
+/// \brief Loads a model from a .obj or pre-baked binary model file
+/// \param objFile Path to the .obj or pre-baked model file
+/// \param texture Texture the model expects
 /// \return Returns a new model or NULL if it fails
-/// \warning This function is very taxing as it builds a proper index list from the loaded model to save video memory
+/// \warning For .obj input this function is very taxing as it builds a proper index list from the loaded model to save video memory, pre-baked models (see vk2dModelConvertObj) upload as-is
 VK2DModel vk2dModelLoad(const char *objFile, VK2DTexture texture);
 
+/// \brief Converts a .obj file into a pre-baked binary model file
+/// \param objFilename Path to the .obj file to convert
+/// \param outputFilename Path the pre-baked model will be written to
+/// \return Returns true if the model was converted
+///
+/// The output holds the finished vertex and index lists, so loading it later is just a
+/// read and an upload - text parsing and index building are paid once here instead of at
+/// every load. Run this from your build pipeline and ship the baked files.
+bool vk2dModelConvertObj(const char *objFilename, const char *outputFilename);
+
 /// \brief The texture stored in the model is not destroyed
 /// \param model Model to free from memory
 void vk2dModelFree(VK2DModel model);
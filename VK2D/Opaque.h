@@ -19,6 +19,7 @@ struct VK2DPhysicalDevice_t {
 	struct {
 		uint32_t graphicsFamily; ///< Queue family for graphics pipeline
 		uint32_t computeFamily;  ///< Queue family for compute pipeline
+		uint32_t transferFamily; ///< Dedicated transfer family, the graphics family when the host has none
 	} QueueFamily;               ///< Nicely groups up queue families
 	VkPhysicalDeviceMemoryProperties mem; ///< Memory properties of this device
 	VkPhysicalDeviceFeatures feats;       ///< Features of this device
@@ -30,17 +31,31 @@ struct VK2DLogicalDevice_t {
 	VkDevice dev;              ///< Logical device
 	VkQueue queue;             ///< Queue for command buffers
 	VkQueue loadQueue;         ///< Queue for off-thread loading
+	VkQueue computeQueue;      ///< Queue for compute dispatches, the main queue when the host has no separate compute family
+	VkQueue transferQueue;     ///< Queue for per-frame staging copies, the main queue when the host has no dedicated transfer family
 	VK2DPhysicalDevice pd;     ///< Physical device this came from
 	VkCommandPool pool;        ///< Command pools to cycle through
-	VkCommandPool loadPool;    ///< Command pool for off-thread loading
+	VkCommandPool computePool; ///< Command pool for compute dispatches
+	VkCommandPool transferPool; ///< Command pool for the transfer queue
+	VkCommandPool loadPools[VK2D_WORKER_THREAD_COUNT]; ///< One loading command pool per worker thread, pools can't be shared between threads
+	SDL_TLSID loadPoolTLS;     ///< Hands each worker thread its own loading pool deep in the loading paths
 	_Atomic(int) loadListSize; ///< Size of the asset load list
 	VK2DAssetLoad *loadList;   ///< Assets that need to be loaded
 	SDL_mutex *loadListMutex;  ///< Mutex for asset load list synchronization
-	SDL_Thread *workerThread;  ///< Thread that loads assets
-	_Atomic(bool) quitThread;  ///< How to tell the thread to quit
+	SDL_mutex *loadQueueMutex; ///< Queues require external synchronization, workers take turns submitting
+	SDL_Thread *workerThreads[VK2D_WORKER_THREAD_COUNT]; ///< Threads that load assets
+	_Atomic(bool) quitThread;  ///< How to tell the threads to quit
 	_Atomic(int) loads;        ///< Number of loads waiting in the list
+	_Atomic(int) loadsInProgress; ///< Number of assets workers have claimed but not finished
 	_Atomic(bool) doneLoading; ///< To know when loading is complete
 	SDL_mutex *shaderMutex;    ///< Mutex for creating shaders
+	VK2DTexture *streamList;   ///< Streamed textures waiting for a worker to decode them
+	int streamListSize;        ///< Actual size of the stream list
+	_Atomic(int) streamCount;  ///< Number of textures waiting in the stream list
+	VK2DTexture *streamDoneList; ///< Streamed textures a worker finished, waiting for the frame swap
+	int streamDoneListSize;    ///< Actual size of the stream done list
+	int streamDoneCount;       ///< Number of textures waiting in the stream done list
+	SDL_mutex *streamListMutex; ///< Mutex guarding both stream lists
 };
 
 /// \brief An internal representation of a camera (the user deals with VK2DCameraIndex, the renderer uses this struct)
@@ -51,6 +66,8 @@ typedef struct VK2DCamera {
 	VK2DCameraSpec spec;           ///< Info on how to create the UBO and scissor/viewport
 	VK2DUniformBufferObject *ubos; ///< UBO data for each frame
 	VkDescriptorSet *uboSets;      ///< List of UBO sets, 1 per swapchain image
+	VK2DBuffer *uboBuffers;        ///< Persistent host-visible UBO buffer per swapchain image, the sets point at these
+	bool *uboDirty;                ///< Whether each swapchain image's UBO needs to be rebuilt and re-uploaded
 	VK2DCameraState state;         ///< State of this camera
 } VK2DCamera;
 
@@ -66,7 +83,7 @@ struct VK2DBuffer_t {
 typedef struct _VK2DDescriptorBufferInternal {
 	VK2DBuffer deviceBuffer; ///< Device-local (on vram) buffer that the shaders will access
 	VK2DBuffer stageBuffer;  ///< Host-local (on ram) buffer that data will be copied into
-	void *hostData;          ///< For when stageBuffer is mapped
+	void *hostData;          ///< Persistent mapping of stageBuffer, valid for the buffer's whole lifetime
 	VkDeviceSize size;       ///< Amount of data currently in this buffer
 } _VK2DDescriptorBufferInternal;
 
@@ -86,9 +103,39 @@ struct VK2DDescriptorBuffer_t {
 	_VK2DDescriptorBufferInternal *buffers; ///< List of internal buffers so that we can allocate more on the fly
 	int bufferCount;          ///< Amount of internal buffers in the descriptor buffer, for when it needs to be resized
 	int bufferListSize;       ///< Actual number of elements in the buffer lists
+	int pageIndex;            ///< Page that copies are currently being bump-allocated from
+	SDL_mutex *copyMutex;     ///< Locked around copies so parallel recording threads don't race the cursor
 	VK2DLogicalDevice dev;    ///< Device this lives on
 };
 
+/// \brief A texture draw recorded by the deferred render queue
+typedef struct VK2DQueuedDraw {
+	VK2DTexture tex;           ///< Texture the draw was submitted with
+	VK2DBlendMode blendMode;   ///< Blend mode the draw was submitted with
+	uint32_t order;            ///< Submission order, used to keep the sort stable
+	VK2DDrawInstance instance; ///< Everything else about the draw
+} VK2DQueuedDraw;
+
+/// \brief A per-thread recording slot for parallel draw recording
+typedef struct VK2DThreadSlot {
+	VkCommandPool pool;     ///< Dedicated pool so worker threads never share one
+	VkCommandBuffer buffer; ///< Secondary command buffer draws are recorded into
+	bool active;            ///< Whether the buffer is recording and awaits execution
+} VK2DThreadSlot;
+
+/// \brief A resource waiting on its frame to retire before it can safely be destroyed
+typedef struct VK2DDeferredFree {
+	void (*freeFunc)(void*); ///< Function that actually destroys the resource
+	void *resource;          ///< Resource handed to freeFunc
+} VK2DDeferredFree;
+
+/// \brief A depth attachment shared between every same-size render target
+typedef struct VK2DSharedAttachment {
+	VK2DImage img;              ///< The attachment itself
+	VkSampleCountFlagBits msaa; ///< Sample count the attachment was created with
+	uint32_t refs;              ///< Number of targets using it, destroyed when this hits zero
+} VK2DSharedAttachment;
+
 /// \brief Abstraction for descriptor pools and sets so you can dynamically use them
 struct VK2DDescCon_t {
 	VkDescriptorPool *pools;      ///< List of pools
@@ -102,6 +149,15 @@ struct VK2DDescCon_t {
 	// valid pools (in an effort to avoid constantly reallocating memory)
 	uint32_t poolsInUse;   ///< Number of actively in use pools in pools
 	uint32_t poolListSize; ///< Total length of pools array
+	uint32_t poolIndex;    ///< First pool that may still have room, allocation skips the full ones before it
+
+	// Persistent sets go back here when their owner dies so new owners reuse them
+	// instead of the pools growing forever
+	VkDescriptorSet *freeList; ///< Recycled sets waiting to be handed out again
+	uint32_t freeListCount;    ///< Number of sets waiting in the free list
+	uint32_t freeListSize;     ///< Total length of the free list array
+
+	SDL_mutex *mutex; ///< Loading workers allocate from the off-thread controller concurrently, and pools require external synchronization
 };
 
 /// \brief A handy abstraction that groups up pipeline state and makes multiple shaders easier
@@ -116,9 +172,12 @@ struct VK2DPipeline_t {
 
 /// \brief Makes shapes easier to deal with
 struct VK2DPolygon_t {
-	VK2DBuffer vertices;  ///< Internal memory for the vertices
-	VK2DVertexType type;  ///< What kind of vertices this stores
-	uint32_t vertexCount; ///< Number of vertices
+	VK2DBuffer vertices;        ///< Internal memory for the vertices (NULL for dynamic polygons)
+	VK2DVertexType type;        ///< What kind of vertices this stores
+	uint32_t vertexCount;       ///< Number of vertices
+	bool dynamic;               ///< True if the vertices stream through the frame's descriptor buffer
+	VkBuffer dynamicBuffer;     ///< Buffer the vertices were streamed into, only valid for the frame they were copied in
+	VkDeviceSize dynamicOffset; ///< Where in dynamicBuffer the streamed vertices start
 };
 
 /// \brief Wrapper for data needed to manage a shader
@@ -138,11 +197,34 @@ struct VK2DShader_t {
 	uint8_t *spvFrag;        ///< Fragment shader in SPIR-V
 	uint32_t spvFragSize;    ///< Size of the fragment shader (in bytes)
 	VK2DPipeline pipe;       ///< Pipeline associated with this shader
+	_Atomic(bool) pipeReady; ///< Whether the pipeline has finished building and may be drawn with
+	SDL_Thread *buildThread; ///< Background pipeline build, NULL once joined
 	uint32_t uniformSize;    ///< Uniform buffer size in bytes
 	VK2DLogicalDevice dev;   ///< Device this belongs to
 	VK2DDescCon descCons[VK2D_MAX_FRAMES_IN_FLIGHT]; ///< Descriptor sets for the uniform buffers
 };
 
+/// \brief Wrapper for data needed to manage a compute shader
+///
+/// Unlike graphics shaders these don't get any built-in data, they only see the
+/// storage buffers (and optional uniform buffer) handed to each dispatch. All of
+/// a dispatch's bindings live in one descriptor set so each dispatch just grabs a
+/// fresh set from the controller, fills it and binds it.
+struct VK2DComputeShader_t {
+	uint8_t *spv;               ///< Compute shader in SPIR-V
+	uint32_t spvSize;           ///< Size of the shader (in bytes)
+	uint32_t uniformSize;       ///< Uniform buffer size in bytes, 0 if there is no uniform
+	uint32_t storageBufferCount;///< Number of storage buffer bindings the shader declares
+	VkDescriptorSetLayout dsl;  ///< Layout of the shader's one descriptor set
+	VkPipelineLayout layout;    ///< Pipeline layout (just the one set)
+	VkPipeline pipe;            ///< The compute pipeline
+	VK2DDescCon descCon;        ///< Descriptor sets for dispatches
+	VK2DBuffer uniformBuffer;   ///< Host-visible buffer dispatch uniform data is copied into
+	VkFence fence;              ///< Signalled when an async dispatch retires
+	VkCommandBuffer asyncBuffer;///< Command buffer of the in-flight async dispatch, VK_NULL_HANDLE if none
+	VK2DLogicalDevice dev;      ///< Device this belongs to
+};
+
 /// \brief Simple wrapper that groups image things together
 struct VK2DImage_t {
 	VkImage img;           ///< Internal image
@@ -151,7 +233,9 @@ struct VK2DImage_t {
 	VK2DLogicalDevice dev; ///< Device this image belongs to
 	uint32_t width;        ///< Width in pixels of the image
 	uint32_t height;       ///< Height in pixels of the image
+	uint32_t mipLevels;    ///< Number of mip levels in the image
 	VkDescriptorSet set;   ///< Descriptor set for this image
+	VK2DDescCon setOwner;  ///< Controller that issued set, recycled sets must go back to it
 };
 
 /// \brief Takes the headache out of Vulkan textures
@@ -167,6 +251,141 @@ struct VK2DTexture_t {
 	VK2DBuffer ubo;         ///< UBO that will be used when drawing to this texture
 	VkDescriptorSet uboSet; ///< Set for the UBO
 	bool imgHandled;        ///< Whether or not to free the image with the texture (if it was loaded with vk2dTextureLoad)
+	uint32_t arrayIndex;    ///< Slot in the bindless texture array, UINT32_MAX if it doesn't have one
+	bool imgAttachmentLayout; ///< Whether the image was left in attachment layout because the hinted target sequence binds it again
+	bool streamed;          ///< Whether this texture came from vk2dTextureStream
+	_Atomic(int) streamState; ///< Where the full image is in the streaming pipeline
+	VK2DImage placeholderImg; ///< Tiny stand-in image draws sample until the full image is resident
+	VK2DImage pendingImg;   ///< Full image a worker finished, waiting to be swapped in at the next frame
+	char *streamFilename;   ///< Owned copy of the source file so evicted textures can come back
+	float streamWidth;      ///< Width of the full image, read from the file header up front
+	float streamHeight;     ///< Height of the full image, read from the file header up front
+};
+
+/// \brief An asynchronous copy of a target or the screen into host-visible memory
+struct VK2DReadback_t {
+	VK2DBuffer buffer;  ///< Host-visible buffer the pixels land in
+	void *data;         ///< Mapped pointer into the buffer, NULL until first accessed
+	uint32_t width;     ///< Width in pixels of the copied image
+	uint32_t height;    ///< Height in pixels of the copied image
+	VK2DTexture target; ///< Target being copied, NULL for the screen
+	uint32_t frame;     ///< Frame-in-flight slot whose fence covers the copy
+	bool recorded;      ///< Whether the copy has been recorded into a frame yet
+	bool complete;      ///< Whether the GPU has finished the copy
+};
+
+/// \brief A retained list of texture draws baked into device buffers
+struct VK2DDrawList_t {
+	VK2DTexture tex;         ///< Texture every draw in the list samples from
+	VK2DDrawInstance *items; ///< CPU copy of the recorded draws
+	uint32_t itemCount;      ///< Number of recorded draws
+	uint32_t itemListSize;   ///< Actual size of the items list
+	VK2DBuffer instances;    ///< Baked device-local instance buffer
+	VK2DBuffer commands;     ///< Baked draw parameters for the indirect draw
+	bool dirty;              ///< Whether the device buffers are behind the CPU copy
+};
+
+/// \brief A bucket of entries occupying one grid cell of a spatial map
+typedef struct _VK2DSpatialCell {
+	bool used;                   ///< Whether this hash slot holds a cell
+	int64_t key;                 ///< Packed coordinates of the cell this slot holds
+	uint64_t stamp;              ///< Last gather pass that visited this cell
+	VK2DDrawInstance *instances; ///< Instance data for every entry in the cell
+	int32_t *handles;            ///< Owning handle of each entry, parallel to instances
+	uint32_t count;              ///< Entries currently in the cell
+	uint32_t listSize;           ///< Actual size of the entry lists
+} _VK2DSpatialCell;
+
+/// \brief Where a spatial map handle's entry currently lives
+typedef struct _VK2DSpatialSlot {
+	bool used;      ///< False once the handle has been freed
+	int64_t key;    ///< Packed coordinates of the cell holding the entry
+	uint32_t index; ///< Index of the entry inside that cell
+	float x;        ///< World x the entry was last placed at
+	float y;        ///< World y the entry was last placed at
+} _VK2DSpatialSlot;
+
+/// \brief Retained world-space sprites bucketed into a uniform grid for culled drawing
+struct VK2DSpatialMap_t {
+	VK2DTexture tex;         ///< Texture every entry samples from
+	float cellSize;          ///< World-space width/height of a grid cell
+	_VK2DSpatialCell *cells; ///< Open-addressed hash table of occupied cells
+	uint32_t cellListSize;   ///< Capacity of the cell hash, always a power of two
+	uint32_t cellCount;      ///< Cells currently occupied
+	uint32_t totalCount;     ///< Total entries across every cell
+	uint64_t stamp;          ///< Incremented per gather so cells two cameras share copy once
+	_VK2DSpatialSlot *slots; ///< Handle lookup table
+	int32_t slotListSize;    ///< Actual size of the slot list
+	int32_t *freeSlots;      ///< Stack of recycled handles
+	int32_t freeSlotCount;   ///< Number of recycled handles waiting for reuse
+};
+
+/// \brief A tile world split into chunks that each keep a baked draw list
+struct VK2DTilemap_t {
+	VK2DTexture tex;       ///< Atlas texture the tiles sample from
+	float tileWidth;       ///< Width of a tile in pixels
+	float tileHeight;      ///< Height of a tile in pixels
+	uint32_t width;        ///< Width of the map in tiles
+	uint32_t height;       ///< Height of the map in tiles
+	uint32_t chunksAcross; ///< Number of chunks per row
+	uint32_t chunksDown;   ///< Number of chunks per column
+	uint32_t *tiles;       ///< Tile ids in row-major order, 0 is empty
+	VK2DDrawList *chunks;  ///< One retained draw list per chunk
+	bool *chunkDirty;      ///< Which chunks need their draw list rebuilt
+};
+
+/// \brief A fixed-grid bitmap font drawn as one instanced draw per string
+struct VK2DFont_t {
+	VK2DTexture tex;  ///< Texture holding the glyphs in a grid of cellW x cellH cells
+	bool ownsTexture; ///< Whether the font frees the texture itself
+	int firstChar;    ///< Character code of the grid's first cell
+	int lastChar;     ///< Character code of the grid's last cell (inclusive)
+	float cellW;      ///< Width of a glyph cell in pixels
+	float cellH;      ///< Height of a glyph cell in pixels
+	float *widths;    ///< Optional per-glyph advances, NULL means every glyph advances cellW
+};
+
+/// \brief A particle system that lives entirely on the GPU
+///
+/// Particle state is a device-local VK2DDrawInstance array that a user compute
+/// shader updates in place; drawing sources the instancing pipeline straight from
+/// that array through an indirect draw, so the CPU never touches a particle.
+struct VK2DParticleSystem_t {
+	VK2DComputeShader shader; ///< User compute shader that steps the particles
+	VK2DBuffer instances;     ///< Device-local VK2DDrawInstance array the shader updates
+	VK2DBuffer indirect;      ///< VkDrawIndirectCommand the shader may write the live count into
+	uint32_t capacity;        ///< Maximum number of particles
+	VK2DLogicalDevice dev;    ///< Device this belongs to
+};
+
+/// \brief A texture atlas built at load time out of many small images
+struct VK2DAtlas_t {
+	VK2DTexture tex;         ///< The one big texture every sub-image was packed into
+	VK2DAtlasEntry *entries; ///< Where each source image ended up, in input order
+	uint32_t entryCount;     ///< Number of entries
+};
+
+/// \brief On-disk header at the start of every asset bundle
+typedef struct VK2DBundleHeader {
+	char magic[8];    ///< Always "VK2DBNDL"
+	uint32_t version; ///< Format version, currently 1
+	uint32_t count;   ///< Number of entries in the index
+} VK2DBundleHeader;
+
+/// \brief One on-disk index entry, the index follows the header directly
+typedef struct VK2DBundleEntry {
+	char name[VK2D_BUNDLE_NAME_MAX]; ///< Null-terminated entry name
+	uint32_t offset;                 ///< Entry data's offset from the start of the bundle
+	uint32_t size;                   ///< Entry data's size in bytes
+} VK2DBundleEntry;
+
+/// \brief A packed asset bundle mapped into memory in one go
+struct VK2DBundle_t {
+	uint8_t *data;                  ///< Whole bundle file, usually a file mapping
+	void *mapping;                  ///< Mapping handle for _vk2dUnmapFile
+	uint32_t size;                  ///< Size of the bundle file in bytes
+	const VK2DBundleEntry *entries; ///< Index, points into data
+	uint32_t entryCount;            ///< Number of entries in the index
 };
 
 /// \brief A 3D model
@@ -199,12 +418,15 @@ struct VK2DRenderer_t {
 	VkSampler modelSampler;               ///< Same as textureSampler but for 3D (normalized coordinates)
 	VkViewport viewport;                  ///< Viewport to draw with
 	bool enableTextureCameraUBO;          ///< If true, when drawing to a texture the UBO for the internal camera is used instead of the texture's UBO
+	bool enableCulling;                   ///< If true, texture draws and instance lists are culled against each camera's world bounds before recording
 	VK2DBlendMode blendMode;              ///< Current blend mode to draw with
 	VK2DCameraSpec defaultCameraSpec;     ///< Default camera spec (spec for camera 0)
 	VK2DCamera cameras[VK2D_MAX_CAMERAS]; ///< All cameras to be drawn to
 	VK2DCameraIndex cameraLocked;         ///< If true, only the default camera will be drawn to
 	VK2DStartupOptions options;           ///< Root options for the renderer
 	VK2DRendererLimits limits;            ///< For user safety
+	VK2DMemoryBudgetCallback memoryBudgetCallback; ///< Optional user callback fired when a memory heap goes over budget
+	void *memoryBudgetContext;            ///< User pointer handed back through memoryBudgetCallback
 
 	// KHR Surface
 	SDL_Window *window;                           ///< Window this renderer belongs to
@@ -221,6 +443,8 @@ struct VK2DRenderer_t {
 	VkImage *swapchainImages;              ///< Images of the swapchain
 	VkImageView *swapchainImageViews;      ///< Image views for the swapchain images
 	uint32_t swapchainImageCount;          ///< Number of images in the swapchain
+	bool headless;                         ///< True when rendering without a window (no surface or swapchain exists)
+	VK2DImage *headlessImages;             ///< Offscreen images that stand in for the swapchain in headless mode
 	VkRenderPass renderPass;               ///< The render pass
 	VkRenderPass midFrameSwapRenderPass;   ///< Render pass for mid-frame switching back to the swapchain as a target
 	VkRenderPass externalTargetRenderPass; ///< Render pass for rendering to textures
@@ -230,6 +454,7 @@ struct VK2DRenderer_t {
 	bool procedStartFrame;                 ///< End frame things are only done if this is true and start frame things are only done if this is false
 
 	// Pipelines
+	VkPipelineCache pipelineCache; ///< Cache every pipeline is created from, optionally persisted to disk
 	VK2DPipeline texPipe;       ///< Pipeline for rendering textures
 	VK2DPipeline modelPipe;     ///< Pipeline for 3D models
 	VK2DPipeline wireframePipe; ///< Pipeline for 3D wireframes
@@ -253,11 +478,21 @@ struct VK2DRenderer_t {
 	VkDescriptorSet modelSamplerSet;          ///< Sampler for all 3D models
 	VK2DDescriptorBuffer *descriptorBuffers;  ///< Descriptor buffer, one per swapchain image
 
+	// Bindless texture array, only exists if limits.supportsTextureArray (custom shaders access it as set 4)
+	VkDescriptorSetLayout dslTextureArray; ///< Set layout for the bindless texture array
+	VkDescriptorPool texArrayPool;         ///< Update-after-bind pool the array set comes from
+	VkDescriptorSet texArraySet;           ///< One big set holding every loaded texture
+	VK2DTexture *texArrayTextures;         ///< Which texture owns each slot, NULL slots are free
+	uint32_t texArraySlotCount;            ///< Number of slots in the array
+	SDL_mutex *texArrayMutex;              ///< Textures can be created and freed from worker threads
+
 	// Frame synchronization
 	uint32_t currentFrame;                 ///< Current frame being looped through
+	uint32_t framesInFlight;               ///< How many frames may be in flight at once, 1 to VK2D_MAX_FRAMES_IN_FLIGHT
 	uint32_t scImageIndex;                 ///< Swapchain image index to be rendered to this frame
 	VkSemaphore *imageAvailableSemaphores; ///< Semaphores to signal when the image is ready
 	VkSemaphore *renderFinishedSemaphores; ///< Semaphores to signal when rendering is done
+	VkSemaphore *dbFinishedSemaphores;     ///< Semaphores the draw submit waits on when descriptor-buffer copies run on a dedicated transfer queue
 	VkFence *inFlightFences;               ///< Fences for each frame
 	VkFence *imagesInFlight;               ///< Individual images in flight
 	VkCommandBuffer *commandBuffer;        ///< Command buffers, recreated each frame
@@ -278,6 +513,65 @@ struct VK2DRenderer_t {
 	VkBuffer prevVBO;     ///< Currently bound vertex buffer
 	VkPipeline prevPipe;  ///< Currently bound pipeline
 
+	// Deferred destruction - resources freed mid-frame wait on their frame's fence instead of a device wait
+	VK2DDeferredFree *deferredFrees[VK2D_MAX_FRAMES_IN_FLIGHT]; ///< Per-frame lists of resources waiting to be destroyed
+	uint32_t deferredFreeCounts[VK2D_MAX_FRAMES_IN_FLIGHT];     ///< Number of resources waiting in each list
+	uint32_t deferredFreeListSizes[VK2D_MAX_FRAMES_IN_FLIGHT];  ///< Actual size of each list
+
+	// Automatic sprite batching, only used when the user enables it
+	bool batching;                ///< Whether or not texture draws are accumulated into a batch
+	VK2DTexture batchTexture;     ///< Texture the pending batch will be drawn with
+	VK2DBlendMode batchBlendMode; ///< Blend mode the pending batch was started with
+	VK2DDrawInstance *batch;      ///< Instances waiting to be flushed as one instanced draw
+	uint32_t batchCount;          ///< Number of instances currently in the batch
+	uint32_t batchListSize;       ///< Actual size of the batch list
+
+	// Shape batching, filled rectangles/circles/lines accumulate here and flush together
+	VK2DVertexColour *shapeBatch;      ///< World-space triangle vertices waiting to be flushed
+	uint32_t shapeBatchCount;          ///< Number of vertices currently in the shape batch
+	uint32_t shapeBatchListSize;       ///< Actual size of the shape batch list
+	VK2DBlendMode shapeBatchBlendMode; ///< Blend mode the pending shape batch was started with
+
+	// Parallel draw recording, only used when the user creates recording slots
+	SDL_TLSID threadSlotTLS;     ///< Thread-local pointer to the slot the calling thread records into
+	VK2DThreadSlot *threadSlots; ///< One recording slot per worker thread
+	uint32_t threadSlotCount;    ///< Number of recording slots
+
+	// Deferred render queue, only used when the user enables it
+	bool renderQueue;                  ///< Whether or not texture draws are deferred, sorted by state, then recorded
+	VK2DQueuedDraw *drawQueue;         ///< Texture draws waiting to be sorted and flushed
+	uint32_t drawQueueCount;           ///< Number of draws currently in the queue
+	uint32_t drawQueueListSize;        ///< Actual size of the draw queue list
+
+	// Render-target attachment sharing and the rented-target pool
+	VK2DSharedAttachment *sharedDepthBuffers; ///< Depth attachments shared between same-size targets
+	uint32_t sharedDepthBufferCount;          ///< Number of shared depth attachments alive
+	uint32_t sharedDepthBufferListSize;       ///< Actual size of the shared depth attachment list
+	VK2DTexture *targetPool;                  ///< Returned temporary targets waiting to be rented again
+	uint32_t targetPoolCount;                 ///< Number of targets waiting in the pool
+	uint32_t targetPoolListSize;              ///< Actual size of the target pool list
+
+	// Asynchronous readbacks waiting to be recorded or still riding a frame's fence
+	VK2DReadback *readbacks;    ///< Requested readbacks, completed ones leave the list
+	uint32_t readbackCount;     ///< Number of pending or in-flight readbacks
+	uint32_t readbackListSize;  ///< Actual size of the readback list
+	bool swapchainTransferSrc;  ///< Whether the swapchain images can be copied from
+
+	// Declared target sequence, lets target switches skip layout moves for ping-ponged targets
+	VK2DTexture *targetHints;    ///< The frame's declared target bind sequence, in order
+	uint32_t targetHintCount;    ///< Number of binds in the declared sequence
+	uint32_t targetHintListSize; ///< Actual size of the hint list
+	uint32_t targetHintIndex;    ///< Next bind expected by the declared sequence
+
+	// Per-frame bump arena, every transient host allocation lives here and dies at the next start-of-frame
+	uint8_t *frameArena;               ///< Backing memory for transient per-frame allocations
+	uint32_t frameArenaSize;           ///< Size of the arena in bytes
+	uint32_t frameArenaOffset;         ///< Bump cursor into the arena, reset every frame
+	void **frameArenaOverflow;         ///< Heap blocks handed out while the arena was full, freed at reset
+	uint32_t frameArenaOverflowCount;  ///< Number of outstanding overflow blocks
+	uint32_t frameArenaOverflowSize;   ///< Actual size of the overflow list
+	uint32_t frameArenaOverflowBytes;  ///< Bytes that spilled to the heap this frame, the arena grows by this at reset
+
 	// Makes drawing things simpler
 	VK2DPolygon unitSquare;        ///< Used to draw rectangles
 	VK2DPolygon unitSquareOutline; ///< Used to draw rectangle outlines
@@ -286,12 +580,31 @@ struct VK2DRenderer_t {
 	VK2DPolygon unitLine;          ///< Used to draw lines
 	VK2DBuffer unitUBO;            ///< Used to draw to the whole screen
 	VkDescriptorSet unitUBOSet;    ///< Descriptor Set for the unit ubo
+	VK2DBuffer identityUBO;        ///< VP buffer holding an identity matrix for the premultiplied 2D draw path
+	VkDescriptorSet identityUBOSet; ///< Descriptor set every premultiplied 2D draw shares at set 0
 
 	// Debugging tools
 	double previousTime;     ///< Time that the current frame started
 	double amountOfFrames;   ///< Number of frames needed to calculate frameTimeAverage
 	double accumulatedTime;  ///< Total time of frames for average in ms
 	double frameTimeAverage; ///< Average amount of time frames are taking over a second (in ms)
+
+	// CPU frame statistics
+	VK2DFrameStats frameStats;     ///< Counters accumulating for the frame being recorded
+	VK2DFrameStats lastFrameStats; ///< Snapshot of the previous frame's counters
+	double acquireTime;            ///< Performance counter stamp of the frame's image acquire
+
+	// Frame pacing
+	double targetFrameTimeMS; ///< Frame time the pacer holds the main loop to, 0 when pacing is disabled
+	uint64_t pacingDeadline;  ///< Performance-counter tick the current frame aims to finish at
+
+	// GPU profiling
+	VkQueryPool gpuProfileQueryPool; ///< Timestamp queries, VK2D_MAX_GPU_TIMESTAMPS per frame in flight
+	bool gpuProfileSupported;        ///< Whether the device can write timestamps on the graphics queue
+	float timestampPeriod;           ///< Nanoseconds per timestamp tick, from the device limits
+	uint32_t gpuTimestampCounts[VK2D_MAX_FRAMES_IN_FLIGHT];                        ///< Timestamps written so far per frame slot
+	uint8_t gpuTimestampPipes[VK2D_MAX_FRAMES_IN_FLIGHT][VK2D_MAX_GPU_TIMESTAMPS]; ///< Which pipeline was live after each timestamp
+	VK2DGpuProfile gpuProfile;       ///< Timings of the most recently retired frame
 };
 
 #ifdef __cplusplus
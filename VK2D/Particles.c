@@ -0,0 +1,73 @@
+/// \file Particles.c
+/// \author Paolo Mazzon
+#include "VK2D/Particles.h"
+#include "VK2D/Compute.h"
+#include "VK2D/Buffer.h"
+#include "VK2D/Renderer.h"
+#include "VK2D/LogicalDevice.h"
+#include "VK2D/Validation.h"
+#include "VK2D/Constants.h"
+#include "VK2D/Opaque.h"
+#include <malloc.h>
+
+VK2DParticleSystem vk2dParticleSystemCreate(const char *computeShaderFilename, uint32_t uniformBufferSize, uint32_t capacity, VK2DDrawInstance *initialState) {
+	VK2DParticleSystem out = NULL;
+
+	if (vk2dRendererGetPointer() != NULL) {
+		out = malloc(sizeof(struct VK2DParticleSystem_t));
+		VK2DLogicalDevice dev = vk2dRendererGetDevice();
+
+		if (vk2dPointerCheck(out)) {
+			out->shader = vk2dComputeShaderLoad(computeShaderFilename, uniformBufferSize, 2);
+			out->dev = dev;
+			out->capacity = capacity;
+			out->instances = NULL;
+			out->indirect = NULL;
+
+			if (out->shader != NULL) {
+				// Zeroed instances have a degenerate model matrix so unseeded particles are invisible
+				VK2DDrawInstance *seed = initialState;
+				if (seed == NULL)
+					seed = calloc(capacity, sizeof(VK2DDrawInstance));
+				out->instances = vk2dPointerCheck(seed) ? vk2dBufferCreateStorage(dev, capacity * sizeof(VK2DDrawInstance), seed) : NULL;
+				if (seed != initialState)
+					free(seed);
+
+				// The shader can shrink the instance count from here to cull dead particles
+				VkDrawIndirectCommand command = {6, capacity, 0, 0};
+				out->indirect = vk2dBufferCreateStorage(dev, sizeof(VkDrawIndirectCommand), &command);
+			}
+
+			if (out->shader == NULL || out->instances == NULL || out->indirect == NULL) {
+				vk2dLogMessage("Failed to create particle system of capacity %i.", capacity);
+				vk2dParticleSystemFree(out);
+				out = NULL;
+			}
+		}
+	} else {
+		vk2dLogMessage("Renderer is not initialized");
+	}
+
+	return out;
+}
+
+void vk2dParticleSystemUpdate(VK2DParticleSystem system, void *data) {
+	if (system != NULL) {
+		VK2DBuffer buffers[] = {system->instances, system->indirect};
+		uint32_t groups = (system->capacity + VK2D_PARTICLE_WORKGROUP_SIZE - 1) / VK2D_PARTICLE_WORKGROUP_SIZE;
+		vk2dComputeShaderDispatchAsync(system->shader, data, buffers, 2, groups, 1, 1);
+	}
+}
+
+VK2DBuffer vk2dParticleSystemGetBuffer(VK2DParticleSystem system) {
+	return system->instances;
+}
+
+void vk2dParticleSystemFree(VK2DParticleSystem system) {
+	if (system != NULL) {
+		vk2dComputeShaderFree(system->shader);
+		vk2dBufferFree(system->instances);
+		vk2dBufferFree(system->indirect);
+		free(system);
+	}
+}
@@ -0,0 +1,50 @@
+/// \file Particles.h
+/// \author Paolo Mazzon
+/// \brief Particle systems that are simulated and drawn without the CPU touching a particle
+#pragma once
+#include "VK2D/Structs.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// \brief Creates a particle system that lives entirely on the GPU
+/// \param computeShaderFilename Filename of the compiled SPIR-V compute shader that steps the particles
+/// \param uniformBufferSize Size of the shader's uniform buffer in bytes, or 0 for no uniform (must be a multiple of 4)
+/// \param capacity Maximum number of particles the system can hold
+/// \param initialState Initial VK2DDrawInstance state of every particle, or NULL to start them all zeroed (invisible)
+/// \return Returns a new particle system or NULL if it failed
+///
+/// The compute shader sees two storage buffers plus the optional uniform:
+///
+///  + `layout(set = 0, binding = 0) buffer` - an array of `capacity` VK2DDrawInstance structs, the particles
+///  + `layout(set = 0, binding = 1) buffer` - a VkDrawIndirectCommand, write its second field (instanceCount) to control how many particles get drawn
+///  + `layout(set = 0, binding = 2) uniform` - the per-update uniform data, if a size was given
+///
+/// It must declare `local_size_x = VK2D_PARTICLE_WORKGROUP_SIZE` and each invocation
+/// steps the particle at `gl_GlobalInvocationID.x` (guarding against ids past capacity).
+VK2DParticleSystem vk2dParticleSystemCreate(const char *computeShaderFilename, uint32_t uniformBufferSize, uint32_t capacity, VK2DDrawInstance *initialState);
+
+/// \brief Steps every particle with a compute dispatch, returning before it finishes
+/// \param system Particle system to update
+/// \param data Uniform data for this update (delta time, emitter position, ...), ignored if the shader has no uniform
+///
+/// The dispatch runs on the compute queue so it overlaps whatever the CPU does next;
+/// vk2dRendererDrawParticles waits it out before sourcing the results, so the usual
+/// pattern is to update early in the frame and draw late.
+void vk2dParticleSystemUpdate(VK2DParticleSystem system, void *data);
+
+/// \brief Returns the buffer holding the system's VK2DDrawInstance array
+/// \param system Particle system to pull the buffer from
+/// \return Returns the instance buffer
+///
+/// Handy for seeding or inspecting particles with your own compute shaders.
+VK2DBuffer vk2dParticleSystemGetBuffer(VK2DParticleSystem system);
+
+/// \brief Frees a particle system from memory, waiting out any update still in flight
+/// \param system Particle system to free
+void vk2dParticleSystemFree(VK2DParticleSystem system);
+
+#ifdef __cplusplus
+};
+#endif
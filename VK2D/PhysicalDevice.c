@@ -43,6 +43,16 @@ static bool _vk2dPhysicalDeviceSupportsQueueFamilies(VkInstance instance, VkPhys
 		}
 	}
 
+	// A transfer-only family means a DMA engine that can copy while the graphics queue
+	// draws, the graphics family handles copies when the host doesn't expose one
+	out->QueueFamily.transferFamily = out->QueueFamily.graphicsFamily;
+	for (i = 0; i < queueFamilyCount; i++) {
+		if (queueList[i].queueCount > 0 && (queueList[i].queueFlags & VK_QUEUE_TRANSFER_BIT) &&
+				!(queueList[i].queueFlags & (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT))) {
+			out->QueueFamily.transferFamily = i;
+		}
+	}
+
 	free(queueList);
 	if (gfx && cpu && transfer)
 		return true;
@@ -83,9 +83,13 @@ VK2DPipeline vk2dPipelineCreate(VK2DLogicalDevice dev, VkRenderPass renderPass,
 			pipelineDepthStencilStateCreateInfo.depthWriteEnable = VK_TRUE;
 		}
 
+		// Every blend-mode variant goes into one multi-create call so the driver can
+		// compile them together and dedupe the shared state instead of one call each
+		VkPipelineColorBlendStateCreateInfo pipelineColorBlendStateCreateInfos[VK2D_BLEND_MODE_MAX];
+		VkGraphicsPipelineCreateInfo graphicsPipelineCreateInfos[VK2D_BLEND_MODE_MAX];
 		for (i = 0; i < VK2D_BLEND_MODE_MAX; i++) {
-			VkPipelineColorBlendStateCreateInfo pipelineColorBlendStateCreateInfo = vk2dInitPipelineColorBlendStateCreateInfo(&VK2D_BLEND_MODES[i], 1);
-			VkGraphicsPipelineCreateInfo graphicsPipelineCreateInfo = vk2dInitGraphicsPipelineCreateInfo(
+			pipelineColorBlendStateCreateInfos[i] = vk2dInitPipelineColorBlendStateCreateInfo(&VK2D_BLEND_MODES[i], 1);
+			graphicsPipelineCreateInfos[i] = vk2dInitGraphicsPipelineCreateInfo(
 					shaderStageCreateInfo,
 					shaderStageCount,
 					vertexInfo,
@@ -94,12 +98,12 @@ VK2DPipeline vk2dPipelineCreate(VK2DLogicalDevice dev, VkRenderPass renderPass,
 					&pipelineRasterizationStateCreateInfo,
 					&pipelineMultisampleStateCreateInfo,
 					&pipelineDepthStencilStateCreateInfo,
-					&pipelineColorBlendStateCreateInfo,
+					&pipelineColorBlendStateCreateInfos[i],
 					&pipelineDynamicStateCreateInfo,
 					pipe->layout,
 					renderPass);
-			vk2dErrorCheck(vkCreateGraphicsPipelines(dev->dev, VK_NULL_HANDLE, 1, &graphicsPipelineCreateInfo, VK_NULL_HANDLE, &pipe->pipes[i]));
 		}
+		vk2dErrorCheck(vkCreateGraphicsPipelines(dev->dev, gRenderer->pipelineCache, VK2D_BLEND_MODE_MAX, graphicsPipelineCreateInfos, VK_NULL_HANDLE, pipe->pipes));
 
 		vkDestroyShaderModule(dev->dev, vertShader, VK_NULL_HANDLE);
 		vkDestroyShaderModule(dev->dev, fragShader, VK_NULL_HANDLE);
@@ -4,9 +4,12 @@
 #include "VK2D/Buffer.h"
 #include "VK2D/Validation.h"
 #include "VK2D/Renderer.h"
+#include "VK2D/DescriptorBuffer.h"
 #include "VK2D/Opaque.h"
 #include <malloc.h>
 
+bool _vk2dRendererDeferFree(void (*freeFunc)(void*), void *resource);
+
 VK2DPolygon _vk2dPolygonCreate(VK2DLogicalDevice dev, void *data, uint32_t size, VK2DVertexType type) {
 	VK2DPolygon poly = malloc(sizeof(struct VK2DPolygon_t));
 	VK2DBuffer buf = vk2dBufferLoad(dev, size, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, data, true);
@@ -87,9 +90,48 @@ VK2DPolygon vk2dPolygonCreateOutline(vec2 *vertices, uint32_t vertexCount) {
 	return out;
 }
 
+VK2DPolygon vk2dPolygonCreateDynamic() {
+	VK2DPolygon poly = NULL;
+
+	if (vk2dRendererGetPointer() != NULL) {
+		poly = calloc(1, sizeof(struct VK2DPolygon_t));
+		if (vk2dPointerCheck(poly)) {
+			poly->type = VK2D_VERTEX_TYPE_SHAPE;
+			poly->dynamic = true;
+		}
+	} else {
+		vk2dLogMessage("Renderer is not initialized");
+	}
+
+	return poly;
+}
+
+void vk2dPolygonUpdate(VK2DPolygon polygon, VK2DVertexColour *vertexData, uint32_t vertexCount) {
+	VK2DRenderer gRenderer = vk2dRendererGetPointer();
+	if (gRenderer != NULL) {
+		if (polygon != NULL && polygon->dynamic) {
+			// The frame's descriptor buffer doubles as a vertex buffer, so the vertices ride
+			// the same staged copy every other per-frame upload uses - no allocation happens
+			vk2dDescriptorBufferCopyData(gRenderer->descriptorBuffers[gRenderer->currentFrame], vertexData, sizeof(VK2DVertexColour) * vertexCount, &polygon->dynamicBuffer, &polygon->dynamicOffset);
+			polygon->vertexCount = vertexCount;
+		} else {
+			vk2dLogMessage("Polygon is not dynamic");
+		}
+	} else {
+		vk2dLogMessage("Renderer is not initialized");
+	}
+}
+
+// Destroys the polygon's buffer for real, only safe once no in-flight frame references it
+static void _vk2dPolygonDestroy(void *poly) {
+	VK2DPolygon polygon = poly;
+	vk2dBufferFree(polygon->vertices);
+	free(polygon);
+}
+
 void vk2dPolygonFree(VK2DPolygon polygon) {
 	if (polygon != NULL) {
-		vk2dBufferFree(polygon->vertices);
-		free(polygon);
+		if (!_vk2dRendererDeferFree(_vk2dPolygonDestroy, polygon))
+			_vk2dPolygonDestroy(polygon);
 	}
 }
\ No newline at end of file
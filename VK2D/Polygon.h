@@ -33,6 +33,24 @@ VK2DPolygon vk2dPolygonCreate(vec2 *vertices, uint32_t vertexCount);
 /// \warning This function will crash on < 1 vertex
 VK2DPolygon vk2dPolygonCreateOutline(vec2 *vertices, uint32_t vertexCount);
 
+/// \brief Creates a polygon whose vertices are streamed each frame with vk2dPolygonUpdate
+/// \return Returns either the new polygon or NULL if it failed
+///
+/// Dynamic polygons are for geometry that changes every frame (trails, soft bodies,
+/// deforming meshes). Instead of baking the vertices into a device-local buffer, each
+/// vk2dPolygonUpdate call copies them through the frame's internal staging path, so
+/// updating one costs a memcpy instead of a buffer allocation and upload.
+/// \warning You must call vk2dPolygonUpdate every frame before drawing a dynamic polygon, the previous frame's vertices do not survive
+VK2DPolygon vk2dPolygonCreateDynamic();
+
+/// \brief Streams this frame's vertices into a dynamic polygon
+/// \param polygon Dynamic polygon to update (from vk2dPolygonCreateDynamic)
+/// \param vertexData Triangulated vertices to draw this frame
+/// \param vertexCount Number of vertices in the list
+/// \warning Must be called between vk2dRendererStartFrame and vk2dRendererEndFrame
+/// \warning The vertices only last for the frame they were copied in
+void vk2dPolygonUpdate(VK2DPolygon polygon, VK2DVertexColour *vertexData, uint32_t vertexCount);
+
 /// \brief Frees a polygon from memory
 /// \param polygon Polygon to free
 void vk2dPolygonFree(VK2DPolygon polygon);
@@ -3,6 +3,7 @@
 #include <vulkan/vulkan.h>
 #include <SDL2/SDL_vulkan.h>
 #include <time.h>
+#include <stdlib.h>
 
 #include "VK2D/RendererMeta.h"
 #include "VK2D/Renderer.h"
@@ -17,6 +18,9 @@
 #include "VK2D/Model.h"
 #include "VK2D/DescriptorBuffer.h"
 #include "VK2D/DescriptorControl.h"
+#include "VK2D/Compute.h"
+#include "VK2D/DrawList.h"
+#include "VK2D/Buffer.h"
 #include "VK2D/Opaque.h"
 
 /******************************* Forward declarations *******************************/
@@ -50,12 +54,220 @@ static VK2DStartupOptions DEFAULT_STARTUP_OPTIONS = {
 		true,
 		"vk2derror.txt",
 		false,
-		256 * 1000
+		256 * 1000,
+		NULL
 };
 
+static void _vk2dRendererFlushDeferredTargetLayouts();
+static void _vk2dRendererRecordReadbacks();
+void _vk2dTextureResolveStreams();
+
+/******************************* Render queue *******************************/
+
+// Orders queued draws by blend mode, then texture, then submission order so equal-state
+// draws end up adjacent but overlapping draws of the same state keep their order
+static int _vk2dQueuedDrawCompare(const void *a, const void *b) {
+	const VK2DQueuedDraw *l = a;
+	const VK2DQueuedDraw *r = b;
+	if (l->blendMode != r->blendMode)
+		return l->blendMode < r->blendMode ? -1 : 1;
+	if (l->tex != r->tex)
+		return l->tex < r->tex ? -1 : 1;
+	return l->order < r->order ? -1 : 1;
+}
+
+// Sorts the render queue by pipeline state and records it as one instanced draw per state run
+static void _vk2dRendererFlushQueue() {
+	// The queue belongs to the main recording thread, parallel threads never flush it
+	if (_vk2dRendererThreadOnSecondary())
+		return;
+	if (gRenderer->drawQueueCount > 0) {
+		qsort(gRenderer->drawQueue, gRenderer->drawQueueCount, sizeof(VK2DQueuedDraw), _vk2dQueuedDrawCompare);
+
+		// Pack the sorted instance data contiguously so each run can be drawn in one go
+		VK2DDrawInstance *scratch = vk2dFrameAlloc(sizeof(VK2DDrawInstance) * gRenderer->drawQueueCount);
+		if (!vk2dPointerCheck(scratch)) {
+			gRenderer->drawQueueCount = 0;
+			return;
+		}
+		for (uint32_t i = 0; i < gRenderer->drawQueueCount; i++)
+			memcpy(&scratch[i], &gRenderer->drawQueue[i].instance, sizeof(VK2DDrawInstance));
+
+		// Each run of identical texture/blend mode becomes one instanced draw
+		VK2DBlendMode previousBlendMode = gRenderer->blendMode;
+		uint32_t start = 0;
+		while (start < gRenderer->drawQueueCount) {
+			uint32_t end = start + 1;
+			while (end < gRenderer->drawQueueCount && gRenderer->drawQueue[end].tex == gRenderer->drawQueue[start].tex &&
+					gRenderer->drawQueue[end].blendMode == gRenderer->drawQueue[start].blendMode)
+				end++;
+
+			gRenderer->blendMode = gRenderer->drawQueue[start].blendMode;
+			VkDescriptorSet sets[3];
+			sets[1] = gRenderer->samplerSet;
+			sets[2] = gRenderer->drawQueue[start].tex->img->set;
+
+			// Runs larger than one instanced draw are recorded in chunks
+			uint32_t offset = start;
+			while (offset < end) {
+				uint32_t chunk = end - offset < gRenderer->limits.maxInstancedDraws ? end - offset : gRenderer->limits.maxInstancedDraws;
+				_vk2dRendererDrawInstanced(sets, 3, &scratch[offset], chunk);
+				offset += chunk;
+			}
+			start = end;
+		}
+		gRenderer->blendMode = previousBlendMode;
+		gRenderer->drawQueueCount = 0;
+	}
+}
+
+/******************************* Sprite batching *******************************/
+
+static void _vk2dRendererFlushShapes();
+
+// Draws whatever is waiting in the sprite batch and empties it
+static void _vk2dRendererFlushSprites() {
+	// The batch belongs to the main recording thread, parallel threads never flush it
+	if (_vk2dRendererThreadOnSecondary())
+		return;
+
+	// The render queue is flushed first so queued draws always land before later ones
+	_vk2dRendererFlushQueue();
+	if (gRenderer->batchCount > 0) {
+		// The batch is drawn with the blend mode it was started with, not the current one
+		VK2DBlendMode previousBlendMode = gRenderer->blendMode;
+		gRenderer->blendMode = gRenderer->batchBlendMode;
+		VkDescriptorSet sets[3];
+		sets[1] = gRenderer->samplerSet;
+		sets[2] = gRenderer->batchTexture->img->set;
+		_vk2dRendererDrawInstanced(sets, 3, gRenderer->batch, gRenderer->batchCount);
+		gRenderer->blendMode = previousBlendMode;
+		gRenderer->batchCount = 0;
+		gRenderer->batchTexture = NULL;
+	}
+}
+
+// Draws everything waiting in the sprite and shape batches in submission order
+static void _vk2dRendererFlushBatch() {
+	_vk2dRendererFlushSprites();
+	_vk2dRendererFlushShapes();
+}
+
+// Adds a texture draw to the sprite batch, flushing first if the batch can't accept it
+static void _vk2dRendererAppendBatch(VK2DTexture tex, float x, float y, float xscale, float yscale, float rot, float originX, float originY, float xInTex, float yInTex, float texWidth, float texHeight) {
+	// Shapes drawn before this sprite must land first
+	_vk2dRendererFlushShapes();
+
+	// A batch may only contain one texture/blend mode, and may not outgrow one instanced draw
+	if (gRenderer->batchCount > 0 && (tex != gRenderer->batchTexture || gRenderer->blendMode != gRenderer->batchBlendMode || gRenderer->batchCount >= gRenderer->limits.maxInstancedDraws))
+		_vk2dRendererFlushBatch();
+
+	// Potentially grow the batch list
+	if (gRenderer->batchCount == gRenderer->batchListSize) {
+		uint32_t newSize = gRenderer->batchListSize == 0 ? 256 : gRenderer->batchListSize * 2;
+		gRenderer->batch = realloc(gRenderer->batch, sizeof(VK2DDrawInstance) * newSize);
+		vk2dPointerCheck(gRenderer->batch);
+		gRenderer->batchListSize = newSize;
+	}
+
+	if (gRenderer->batchCount == 0) {
+		gRenderer->batchTexture = tex;
+		gRenderer->batchBlendMode = gRenderer->blendMode;
+	}
+
+	VK2DDrawInstance *instance = &gRenderer->batch[gRenderer->batchCount++];
+	if (rot != 0 || xscale != 1 || yscale != 1)
+		vk2dInstanceSet(instance, x, y, xscale, yscale, rot, originX, originY, xInTex, yInTex, texWidth, texHeight, gRenderer->colourBlend);
+	else
+		vk2dInstanceSetFast(instance, x, y, xInTex, yInTex, texWidth, texHeight, gRenderer->colourBlend);
+}
+
+// Records a texture draw into the render queue to be sorted and drawn at the next flush
+static void _vk2dRendererAppendQueue(VK2DTexture tex, float x, float y, float xscale, float yscale, float rot, float originX, float originY, float xInTex, float yInTex, float texWidth, float texHeight) {
+	// Shapes drawn before this sprite must land first
+	_vk2dRendererFlushShapes();
+
+	// Potentially grow the queue
+	if (gRenderer->drawQueueCount == gRenderer->drawQueueListSize) {
+		uint32_t newSize = gRenderer->drawQueueListSize == 0 ? 256 : gRenderer->drawQueueListSize * 2;
+		gRenderer->drawQueue = realloc(gRenderer->drawQueue, sizeof(VK2DQueuedDraw) * newSize);
+		vk2dPointerCheck(gRenderer->drawQueue);
+		gRenderer->drawQueueListSize = newSize;
+	}
+
+	VK2DQueuedDraw *draw = &gRenderer->drawQueue[gRenderer->drawQueueCount];
+	draw->tex = tex;
+	draw->blendMode = gRenderer->blendMode;
+	draw->order = gRenderer->drawQueueCount++;
+	if (rot != 0 || xscale != 1 || yscale != 1)
+		vk2dInstanceSet(&draw->instance, x, y, xscale, yscale, rot, originX, originY, xInTex, yInTex, texWidth, texHeight, gRenderer->colourBlend);
+	else
+		vk2dInstanceSetFast(&draw->instance, x, y, xInTex, yInTex, texWidth, texHeight, gRenderer->colourBlend);
+}
+
+/******************************* Shape batching *******************************/
+
+// Draws whatever is waiting in the shape batch as one draw per camera and empties it
+static void _vk2dRendererFlushShapes() {
+	// The batch belongs to the main recording thread, parallel threads never flush it
+	if (_vk2dRendererThreadOnSecondary())
+		return;
+	if (gRenderer->shapeBatchCount > 0) {
+		// The batch is drawn with the blend mode it was started with, not the current one
+		VK2DBlendMode previousBlendMode = gRenderer->blendMode;
+		gRenderer->blendMode = gRenderer->shapeBatchBlendMode;
+		_vk2dRendererDrawShapes(gRenderer->shapeBatch, gRenderer->shapeBatchCount);
+		gRenderer->blendMode = previousBlendMode;
+		gRenderer->shapeBatchCount = 0;
+	}
+}
+
+// Reserves room for count triangle vertices in the shape batch and returns where to write
+// them, flushing whatever would break the batch first - returns NULL if it can't grow
+static VK2DVertexColour *_vk2dRendererAppendShapeVertices(uint32_t count) {
+	// Sprites drawn before this shape must land first, and one batch keeps one blend mode
+	_vk2dRendererFlushSprites();
+	if (gRenderer->shapeBatchCount > 0 && gRenderer->blendMode != gRenderer->shapeBatchBlendMode)
+		_vk2dRendererFlushShapes();
+
+	// Potentially grow the batch list
+	if (gRenderer->shapeBatchCount + count > gRenderer->shapeBatchListSize) {
+		uint32_t newSize = gRenderer->shapeBatchListSize == 0 ? 1024 : gRenderer->shapeBatchListSize * 2;
+		while (newSize < gRenderer->shapeBatchCount + count)
+			newSize *= 2;
+		gRenderer->shapeBatch = realloc(gRenderer->shapeBatch, sizeof(VK2DVertexColour) * newSize);
+		if (!vk2dPointerCheck(gRenderer->shapeBatch)) {
+			gRenderer->shapeBatchCount = 0;
+			gRenderer->shapeBatchListSize = 0;
+			return NULL;
+		}
+		gRenderer->shapeBatchListSize = newSize;
+	}
+
+	if (gRenderer->shapeBatchCount == 0)
+		gRenderer->shapeBatchBlendMode = gRenderer->blendMode;
+
+	VK2DVertexColour *out = &gRenderer->shapeBatch[gRenderer->shapeBatchCount];
+	gRenderer->shapeBatchCount += count;
+	return out;
+}
+
+// Writes one world-space vertex with the renderer's current colour mod
+static inline void _vk2dRendererShapeVertex(VK2DVertexColour *vertex, float x, float y) {
+	vertex->pos[0] = x;
+	vertex->pos[1] = y;
+	vertex->pos[2] = 0;
+	vertex->colour[0] = gRenderer->colourBlend[0];
+	vertex->colour[1] = gRenderer->colourBlend[1];
+	vertex->colour[2] = gRenderer->colourBlend[2];
+	vertex->colour[3] = gRenderer->colourBlend[3];
+}
+
 /******************************* User-visible functions *******************************/
 
-VK2DResult vk2dRendererInit(SDL_Window *window, VK2DRendererConfig config, VK2DStartupOptions *options) {
+// Common setup for windowed and headless initialization, window may be NULL in which case
+// width/height specify the size of the offscreen render targets
+static VK2DResult _vk2dRendererInit(SDL_Window *window, VK2DRendererConfig config, VK2DStartupOptions *options, uint32_t width, uint32_t height) {
 	gRenderer = calloc(1, sizeof(struct VK2DRenderer_t));
 	VK2DResult errorCode = VK2D_SUCCESS;
 	uint32_t totalExtensionCount, i, sdlExtensions;
@@ -73,6 +285,8 @@ VK2DResult vk2dRendererInit(SDL_Window *window, VK2DRendererConfig config, VK2DS
 		if (userOptions.vramPageSize == 0)
 			userOptions.vramPageSize = 256 * 1000;
 	}
+	if (userOptions.maxFramesInFlight == 0 || userOptions.maxFramesInFlight > VK2D_MAX_FRAMES_IN_FLIGHT)
+		userOptions.maxFramesInFlight = VK2D_MAX_FRAMES_IN_FLIGHT;
 
 	// Print all available layers
 	VkLayerProperties *systemLayers;
@@ -87,7 +301,12 @@ VK2DResult vk2dRendererInit(SDL_Window *window, VK2DRendererConfig config, VK2DS
 	free(systemLayers);
 
 	// Find number of total number of extensions
-	SDL_Vulkan_GetInstanceExtensions(window, &sdlExtensions, VK_NULL_HANDLE);
+	if (window != NULL) {
+		SDL_Vulkan_GetInstanceExtensions(window, &sdlExtensions, VK_NULL_HANDLE);
+	} else {
+		// No window means no platform surface extensions, just VK_KHR_surface to keep the device extensions valid
+		sdlExtensions = 1;
+	}
 	if (userOptions.enableDebug) {
 		totalExtensionCount = sdlExtensions + DEBUG_EXTENSION_COUNT;
 	} else {
@@ -98,9 +317,13 @@ VK2DResult vk2dRendererInit(SDL_Window *window, VK2DRendererConfig config, VK2DS
 	if (vk2dPointerCheck(gRenderer)) {
 		// Copy user options
 		gRenderer->options = userOptions;
+		gRenderer->framesInFlight = userOptions.maxFramesInFlight;
 
 		// Load extensions
-		SDL_Vulkan_GetInstanceExtensions(window, &sdlExtensions, totalExtensions);
+		if (window != NULL)
+			SDL_Vulkan_GetInstanceExtensions(window, &sdlExtensions, totalExtensions);
+		else
+			totalExtensions[0] = VK_KHR_SURFACE_EXTENSION_NAME;
 		if (userOptions.enableDebug) {
 			for (i = sdlExtensions; i < totalExtensionCount; i++) totalExtensions[i] = DEBUG_EXTENSIONS[i - sdlExtensions];
 		} else {
@@ -128,6 +351,7 @@ VK2DResult vk2dRendererInit(SDL_Window *window, VK2DRendererConfig config, VK2DS
 		gRenderer->pd = vk2dPhysicalDeviceFind(gRenderer->vk, VK2D_DEVICE_BEST_FIT);
 		gRenderer->ld = vk2dLogicalDeviceCreate(gRenderer->pd, false, true, userOptions.enableDebug, &gRenderer->limits);
 		gRenderer->window = window;
+		gRenderer->headless = window == NULL;
 		vk2dLogMessage("Vulkan Version: %i.%i.%i", VK_VERSION_MAJOR(gRenderer->pd->props.apiVersion), VK_VERSION_MINOR(gRenderer->pd->props.apiVersion), VK_VERSION_PATCH(gRenderer->pd->props.apiVersion));
 
 		// Assign user settings, except for screen mode which will be handled later
@@ -148,20 +372,29 @@ VK2DResult vk2dRendererInit(SDL_Window *window, VK2DRendererConfig config, VK2DS
 
 		// Initialize subsystems
 		_vk2dRendererCreateDebug();
-		_vk2dRendererCreateWindowSurface();
-		_vk2dRendererCreateSwapchain();
+		if (!gRenderer->headless) {
+			_vk2dRendererCreateWindowSurface();
+			_vk2dRendererCreateSwapchain();
+		} else {
+			gRenderer->surfaceWidth = width;
+			gRenderer->surfaceHeight = height;
+			_vk2dRendererCreateHeadlessImages();
+		}
 		_vk2dRendererCreateColourResources();
 		_vk2dRendererCreateDepthBuffer();
 		_vk2dRendererCreateRenderPass();
 		_vk2dRendererCreateDescriptorSetLayouts();
+		_vk2dRendererCreatePipelineCache();
 		_vk2dRendererCreatePipelines();
 		_vk2dRendererCreateFrameBuffer();
 		_vk2dRendererCreateDescriptorPool(false);
 		_vk2dRendererCreateDescriptorBuffers();
+		_vk2dRendererCreateTextureArray();
 		_vk2dRendererCreateUniformBuffers(true);
 		_vk2dRendererCreateSampler();
 		_vk2dRendererCreateUnits();
 		_vk2dRendererCreateSynchronization();
+		_vk2dRendererCreateGpuProfiling();
 
 		vk2dRendererSetColourMod((void*)VK2D_DEFAULT_COLOUR_MOD);
 		gRenderer->viewport.x = 0;
@@ -180,28 +413,71 @@ VK2DResult vk2dRendererInit(SDL_Window *window, VK2DRendererConfig config, VK2DS
 	return errorCode;
 }
 
+VK2DResult vk2dRendererInit(SDL_Window *window, VK2DRendererConfig config, VK2DStartupOptions *options) {
+	return _vk2dRendererInit(window, config, options, 0, 0);
+}
+
+VK2DResult vk2dRendererInitHeadless(VK2DRendererConfig config, VK2DStartupOptions *options, uint32_t width, uint32_t height) {
+	return _vk2dRendererInit(NULL, config, options, width, height);
+}
+
 void vk2dRendererQuit() {
 	if (gRenderer != NULL) {
 		vkQueueWaitIdle(gRenderer->ld->queue);
 
+		// Targets still sitting in the rent pool belong to the renderer, nobody else will free them
+		for (uint32_t i = 0; i < gRenderer->targetPoolCount; i++)
+			vk2dTextureFree(gRenderer->targetPool[i]);
+		gRenderer->targetPoolCount = 0;
+
+		// The GPU is idle so anything waiting on a fence can be destroyed immediately
+		for (uint32_t i = 0; i < VK2D_MAX_FRAMES_IN_FLIGHT; i++) {
+			_vk2dRendererProcessDeferredFrees(i);
+			free(gRenderer->deferredFrees[i]);
+			gRenderer->deferredFrees[i] = NULL;
+			gRenderer->deferredFreeListSizes[i] = 0;
+		}
+
+		// Parallel recording pools go with them
+		for (uint32_t i = 0; i < gRenderer->threadSlotCount; i++)
+			vkDestroyCommandPool(gRenderer->ld->dev, gRenderer->threadSlots[i].pool, VK_NULL_HANDLE);
+		free(gRenderer->threadSlots);
+		gRenderer->threadSlots = NULL;
+		gRenderer->threadSlotCount = 0;
+
 		// Destroy subsystems
+		_vk2dRendererDestroyGpuProfiling();
 		_vk2dRendererDestroySynchronization();
 		_vk2dRendererDestroyTargetsList();
 		_vk2dRendererDestroyUnits();
 		_vk2dRendererDestroySampler();
+		_vk2dRendererDestroyTextureArray();
 		_vk2dRendererDestroyDescriptorPool(false);
 		_vk2dRendererDestroyDescriptorBuffers();
 		_vk2dRendererDestroyUniformBuffers();
 		_vk2dRendererDestroyFrameBuffer();
 		_vk2dRendererDestroyPipelines(false);
+		_vk2dRendererDestroyPipelineCache();
 		_vk2dRendererDestroyDescriptorSetLayout();
 		_vk2dRendererDestroyRenderPass();
 		_vk2dRendererDestroyDepthBuffer();
 		_vk2dRendererDestroyColourResources();
-		_vk2dRendererDestroySwapchain();
-		_vk2dRendererDestroyWindowSurface();
+		if (!gRenderer->headless) {
+			_vk2dRendererDestroySwapchain();
+			_vk2dRendererDestroyWindowSurface();
+		} else {
+			_vk2dRendererDestroyHeadlessImages();
+		}
 		_vk2dRendererDestroyDebug();
 
+		// The destroy chain may have deferred frees of its own (camera UBO buffers)
+		for (uint32_t i = 0; i < VK2D_MAX_FRAMES_IN_FLIGHT; i++) {
+			_vk2dRendererProcessDeferredFrees(i);
+			free(gRenderer->deferredFrees[i]);
+			gRenderer->deferredFrees[i] = NULL;
+			gRenderer->deferredFreeListSizes[i] = 0;
+		}
+
 		vmaDestroyAllocator(gRenderer->vma);
 
 		// Destroy core bits
@@ -210,6 +486,17 @@ void vk2dRendererQuit() {
 
 		vk2dLogMessage("VK2D has been uninitialized.");
 		vk2dValidationEnd();
+		free(gRenderer->batch);
+		free(gRenderer->shapeBatch);
+		free(gRenderer->drawQueue);
+		free(gRenderer->targetPool);
+		free(gRenderer->sharedDepthBuffers);
+		free(gRenderer->targetHints);
+		free(gRenderer->readbacks);
+		for (uint32_t i = 0; i < gRenderer->frameArenaOverflowCount; i++)
+			free(gRenderer->frameArenaOverflow[i]);
+		free(gRenderer->frameArenaOverflow);
+		free(gRenderer->frameArena);
 		free(gRenderer);
 		gRenderer = NULL;
 	}
@@ -261,23 +548,66 @@ void vk2dRendererStartFrame(const vec4 clearColour) {
 
 			gRenderer->previousTime = SDL_GetPerformanceCounter();
 
-			// Wait for previous rendering to be finished
+			// Wait for previous rendering to be finished, timing how long the CPU sat blocked
+			double waitStart = SDL_GetPerformanceCounter();
 			vkWaitForFences(gRenderer->ld->dev, 1, &gRenderer->inFlightFences[gRenderer->currentFrame], VK_TRUE,
 							UINT64_MAX);
+			gRenderer->frameStats.fenceWaitTimeMS += (SDL_GetPerformanceCounter() - waitStart) * 1000 / (double)SDL_GetPerformanceFrequency();
+
+			// The last frame on this slot has retired, its resources can be destroyed for real now
+			_vk2dRendererProcessDeferredFrees(gRenderer->currentFrame);
+
+			// Last frame's transient allocations are all dead by now, recycle them in one shot
+			_vk2dRendererResetFrameArena();
+
+			// Readbacks recorded on this slot rode the fence that was just waited on
+			for (uint32_t i = 0; i < gRenderer->readbackCount;) {
+				if (gRenderer->readbacks[i]->recorded && gRenderer->readbacks[i]->frame == gRenderer->currentFrame) {
+					gRenderer->readbacks[i]->complete = true;
+					gRenderer->readbacks[i] = gRenderer->readbacks[gRenderer->readbackCount - 1];
+					gRenderer->readbackCount--;
+				} else {
+					i++;
+				}
+			}
 
-			// Acquire image
-			vkAcquireNextImageKHR(gRenderer->ld->dev, gRenderer->swapchain, UINT64_MAX,
-								  gRenderer->imageAvailableSemaphores[gRenderer->currentFrame], VK_NULL_HANDLE,
-								  &gRenderer->scImageIndex);
+			// And its GPU timestamps are ready to be read back
+			_vk2dRendererResolveGpuProfile(gRenderer->currentFrame);
 
-			if (gRenderer->imagesInFlight[gRenderer->scImageIndex] != VK_NULL_HANDLE) {
-				vkWaitForFences(gRenderer->ld->dev, 1, &gRenderer->imagesInFlight[gRenderer->scImageIndex], VK_TRUE,
-								UINT64_MAX);
+			// Acquire image
+			if (!gRenderer->headless) {
+				vkAcquireNextImageKHR(gRenderer->ld->dev, gRenderer->swapchain, UINT64_MAX,
+									  gRenderer->imageAvailableSemaphores[gRenderer->currentFrame], VK_NULL_HANDLE,
+									  &gRenderer->scImageIndex);
+
+				if (gRenderer->imagesInFlight[gRenderer->scImageIndex] != VK_NULL_HANDLE) {
+					waitStart = SDL_GetPerformanceCounter();
+					vkWaitForFences(gRenderer->ld->dev, 1, &gRenderer->imagesInFlight[gRenderer->scImageIndex], VK_TRUE,
+									UINT64_MAX);
+					gRenderer->frameStats.fenceWaitTimeMS += (SDL_GetPerformanceCounter() - waitStart) * 1000 / (double)SDL_GetPerformanceFrequency();
+				}
+				gRenderer->imagesInFlight[gRenderer->scImageIndex] = gRenderer->inFlightFences[gRenderer->currentFrame];
+			} else {
+				// There is nothing to acquire headless, the offscreen images just rotate with the
+				// frame counter and the fence wait above already guarantees this one is retired
+				gRenderer->scImageIndex = gRenderer->currentFrame;
 			}
-			gRenderer->imagesInFlight[gRenderer->scImageIndex] = gRenderer->inFlightFences[gRenderer->currentFrame];
+			gRenderer->acquireTime = SDL_GetPerformanceCounter();
 
 			/*********** Start-of-frame tasks ***********/
 
+			// Give the budget callback a chance to evict things before this frame allocates
+			if (gRenderer->memoryBudgetCallback != NULL) {
+				VmaBudget budgets[VK_MAX_MEMORY_HEAPS];
+				vmaGetHeapBudgets(gRenderer->vma, budgets);
+				for (uint32_t i = 0; i < gRenderer->pd->mem.memoryHeapCount; i++)
+					if (budgets[i].usage > budgets[i].budget)
+						gRenderer->memoryBudgetCallback(i, budgets[i].usage, budgets[i].budget, gRenderer->memoryBudgetContext);
+			}
+
+			// Swap in any full images the streaming workers finished since last frame
+			_vk2dTextureResolveStreams();
+
 			// Reset currently bound items
 			_vk2dRendererResetBoundPointers();
 
@@ -298,22 +628,31 @@ void vk2dRendererStartFrame(const vec4 clearColour) {
 			vk2dErrorCheck(vkBeginCommandBuffer(gRenderer->commandBuffer[gRenderer->scImageIndex], &beginInfo));
 			vk2dErrorCheck(vkBeginCommandBuffer(gRenderer->dbCommandBuffer[gRenderer->scImageIndex], &beginInfo));
 
+			// Reset this frame's profiling queries and stamp the top of the frame
+			if (gRenderer->gpuProfileSupported) {
+				vkCmdResetQueryPool(gRenderer->commandBuffer[gRenderer->scImageIndex], gRenderer->gpuProfileQueryPool,
+									gRenderer->currentFrame * VK2D_MAX_GPU_TIMESTAMPS, VK2D_MAX_GPU_TIMESTAMPS);
+				_vk2dRendererRecordTimestamp(gRenderer->commandBuffer[gRenderer->scImageIndex], VK2D_PIPELINE_TIME_NONE);
+			}
+
 			// Begin descriptor buffer
 			vk2dDescriptorBufferBeginFrame(gRenderer->descriptorBuffers[gRenderer->currentFrame], gRenderer->commandBuffer[gRenderer->scImageIndex]);
 
-			// Flush the current ubo into its buffer for the frame
+			// Flush dirty ubos into their buffers for the frame, clean cameras keep last frame's upload
 			for (int i = 0; i < VK2D_MAX_CAMERAS; i++) {
-				if (gRenderer->cameras[i].state == VK2D_CAMERA_STATE_NORMAL) {
+				if (gRenderer->cameras[i].state == VK2D_CAMERA_STATE_NORMAL && gRenderer->cameras[i].uboDirty[gRenderer->scImageIndex]) {
 					_vk2dCameraUpdateUBO(&gRenderer->cameras[i].ubos[gRenderer->scImageIndex],
 										 &gRenderer->cameras[i].spec);
-					_vk2dRendererFlushUBOBuffer(gRenderer->scImageIndex, gRenderer->currentFrame, i);
+					_vk2dRendererFlushUBOBuffer(gRenderer->scImageIndex, i);
+					gRenderer->cameras[i].uboDirty[gRenderer->scImageIndex] = false;
 				}
 			}
 
-			// Reset shader desc cons
+			// Reset shader desc cons - indexed by frame-in-flight slot, whose sets the
+			// fence wait above just retired (scImageIndex can exceed framesInFlight)
 			for (int i = 0; i < gRenderer->shaderListSize; i++)
 				if (gRenderer->customShaders[i] != NULL)
-					vk2dDescConReset(gRenderer->customShaders[i]->descCons[gRenderer->scImageIndex]);
+					vk2dDescConReset(gRenderer->customShaders[i]->descCons[gRenderer->currentFrame]);
 
 			// Setup render pass
 			VkRect2D rect = {0};
@@ -347,6 +686,12 @@ VK2DResult vk2dRendererEndFrame() {
 		if (gRenderer->procedStartFrame) {
 			gRenderer->procedStartFrame = false;
 
+			// Anything waiting in the sprite batch has to make it into this frame
+			_vk2dRendererFlushBatch();
+
+			// As does anything worker threads recorded into secondary buffers
+			_vk2dRendererExecuteParallelWork();
+
 			// Make sure we're not in the wrong pipeline
 			if (gRenderer->target != VK2D_TARGET_SCREEN) {
 				vk2dRendererSetTarget(VK2D_TARGET_SCREEN);
@@ -354,45 +699,134 @@ VK2DResult vk2dRendererEndFrame() {
 
 			// Finish the primary command buffer, its time to PRESENT things
 			vkCmdEndRenderPass(gRenderer->commandBuffer[gRenderer->scImageIndex]);
+
+			// A declared target sequence is per-frame, put any target still parked in
+			// attachment layout back before something samples it next frame
+			_vk2dRendererFlushDeferredTargetLayouts();
+
+			// Requested readbacks copy out now that every pass has landed, they ride this
+			// frame's fence instead of stalling the queue
+			_vk2dRendererRecordReadbacks();
+
+			// The frame's final timestamp closes off the profile
+			_vk2dRendererRecordTimestamp(gRenderer->commandBuffer[gRenderer->scImageIndex], VK2D_PIPELINE_TIME_NONE);
 			vk2dDescriptorBufferEndFrame(gRenderer->descriptorBuffers[gRenderer->currentFrame], gRenderer->dbCommandBuffer[gRenderer->scImageIndex]);
 			vk2dErrorCheck(vkEndCommandBuffer(gRenderer->commandBuffer[gRenderer->scImageIndex]));
 			vk2dErrorCheck(vkEndCommandBuffer(gRenderer->dbCommandBuffer[gRenderer->scImageIndex]));
 
-			// Wait for image before doing things
+			// Wait for image before doing things (headless frames have no image to wait on or present)
 			VkPipelineStageFlags waitStage[] = {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT};
 			VkCommandBuffer bufs[] = {gRenderer->commandBuffer[gRenderer->scImageIndex], gRenderer->dbCommandBuffer[gRenderer->scImageIndex]};
-			VkSubmitInfo submitInfo = vk2dInitSubmitInfo(
-					bufs,
-					2,
-					&gRenderer->renderFinishedSemaphores[gRenderer->currentFrame],
-					1,
-					&gRenderer->imageAvailableSemaphores[gRenderer->currentFrame],
-					1,
-					waitStage);
-
-			// Submit
+			VkSubmitInfo submitInfo;
 			vkResetFences(gRenderer->ld->dev, 1, &gRenderer->inFlightFences[gRenderer->currentFrame]);
-			vk2dErrorCheck(vkQueueSubmit(gRenderer->ld->queue, 1, &submitInfo,
-										 gRenderer->inFlightFences[gRenderer->currentFrame]));
+			if (gRenderer->ld->transferQueue != gRenderer->ld->queue) {
+				// The copy batch runs on the dedicated transfer family's DMA engine while the
+				// graphics queue is still busy, the draw submit waits for it at vertex input
+				submitInfo = vk2dInitSubmitInfo(
+						&gRenderer->dbCommandBuffer[gRenderer->scImageIndex],
+						1,
+						&gRenderer->dbFinishedSemaphores[gRenderer->currentFrame],
+						1,
+						VK_NULL_HANDLE,
+						0,
+						VK_NULL_HANDLE);
+				vk2dErrorCheck(vkQueueSubmit(gRenderer->ld->transferQueue, 1, &submitInfo, VK_NULL_HANDLE));
+
+				VkSemaphore waitSemaphores[] = {gRenderer->dbFinishedSemaphores[gRenderer->currentFrame],
+												gRenderer->imageAvailableSemaphores[gRenderer->currentFrame]};
+				VkPipelineStageFlags waitStages[] = {VK_PIPELINE_STAGE_VERTEX_INPUT_BIT,
+													 VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT};
+				submitInfo = vk2dInitSubmitInfo(
+						&gRenderer->commandBuffer[gRenderer->scImageIndex],
+						1,
+						gRenderer->headless ? VK_NULL_HANDLE : &gRenderer->renderFinishedSemaphores[gRenderer->currentFrame],
+						gRenderer->headless ? 0 : 1,
+						waitSemaphores,
+						gRenderer->headless ? 1 : 2,
+						waitStages);
+				vk2dErrorCheck(vkQueueSubmit(gRenderer->ld->queue, 1, &submitInfo,
+											 gRenderer->inFlightFences[gRenderer->currentFrame]));
+			} else {
+				if (!gRenderer->headless) {
+					submitInfo = vk2dInitSubmitInfo(
+							bufs,
+							2,
+							&gRenderer->renderFinishedSemaphores[gRenderer->currentFrame],
+							1,
+							&gRenderer->imageAvailableSemaphores[gRenderer->currentFrame],
+							1,
+							waitStage);
+				} else {
+					submitInfo = vk2dInitSubmitInfo(
+							bufs,
+							2,
+							VK_NULL_HANDLE,
+							0,
+							VK_NULL_HANDLE,
+							0,
+							waitStage);
+				}
+				vk2dErrorCheck(vkQueueSubmit(gRenderer->ld->queue, 1, &submitInfo,
+											 gRenderer->inFlightFences[gRenderer->currentFrame]));
+			}
 
 			// Final present info bit
-			VkResult result;
-			VkPresentInfoKHR presentInfo = vk2dInitPresentInfoKHR(&gRenderer->swapchain, 1, &gRenderer->scImageIndex,
-																  &result,
-																  &gRenderer->renderFinishedSemaphores[gRenderer->currentFrame],
-																  1);
-			VkResult queueRes = vkQueuePresentKHR(gRenderer->ld->queue, &presentInfo);
-			if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR || gRenderer->resetSwapchain ||
-				queueRes == VK_ERROR_OUT_OF_DATE_KHR) {
-				_vk2dRendererResetSwapchain();
-				gRenderer->resetSwapchain = false;
-				res = VK2D_RESET_SWAPCHAIN;
-			} else {
-				vk2dErrorCheck(result);
-				vk2dErrorCheck(queueRes);
+			if (!gRenderer->headless) {
+				VkResult result;
+				VkPresentInfoKHR presentInfo = vk2dInitPresentInfoKHR(&gRenderer->swapchain, 1, &gRenderer->scImageIndex,
+																	  &result,
+																	  &gRenderer->renderFinishedSemaphores[gRenderer->currentFrame],
+																	  1);
+				VkResult queueRes = vkQueuePresentKHR(gRenderer->ld->queue, &presentInfo);
+				if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR || gRenderer->resetSwapchain ||
+					queueRes == VK_ERROR_OUT_OF_DATE_KHR) {
+					_vk2dRendererResetSwapchain();
+					gRenderer->resetSwapchain = false;
+					res = VK2D_RESET_SWAPCHAIN;
+				} else {
+					vk2dErrorCheck(result);
+					vk2dErrorCheck(queueRes);
+				}
+			}
+
+			// Hold the frame to its deadline so the loop runs at an even cadence instead of
+			// whatever uneven rhythm submission and present happen to settle into
+			if (gRenderer->targetFrameTimeMS > 0) {
+				const uint64_t freq = SDL_GetPerformanceFrequency();
+				const uint64_t interval = (uint64_t)(gRenderer->targetFrameTimeMS * freq / 1000);
+				uint64_t now = SDL_GetPerformanceCounter();
+
+				if (gRenderer->pacingDeadline == 0)
+					gRenderer->pacingDeadline = now + interval;
+
+				if (now > gRenderer->pacingDeadline) {
+					// Missed - report how late and resync to now rather than running the
+					// next frames short trying to pay the debt back
+					gRenderer->frameStats.pacingMissMS = (now - gRenderer->pacingDeadline) * 1000 / (double)freq;
+					gRenderer->pacingDeadline = now + interval;
+				} else {
+					// SDL_Delay is only millisecond-coarse, so sleep until a couple
+					// milliseconds short of the deadline and spin out the remainder
+					const uint64_t sleepStart = now;
+					while (now < gRenderer->pacingDeadline && gRenderer->pacingDeadline - now > freq / 500) {
+						SDL_Delay(1);
+						now = SDL_GetPerformanceCounter();
+					}
+					while (now < gRenderer->pacingDeadline)
+						now = SDL_GetPerformanceCounter();
+					gRenderer->frameStats.pacingSleepMS = (now - sleepStart) * 1000 / (double)freq;
+					gRenderer->pacingDeadline += interval;
+				}
+				gRenderer->frameStats.pacingTargetMS = gRenderer->targetFrameTimeMS;
 			}
 
-			gRenderer->currentFrame = (gRenderer->currentFrame + 1) % VK2D_MAX_FRAMES_IN_FLIGHT;
+			// Snapshot the frame's counters so they can be queried while the next frame records
+			gRenderer->frameStats.descriptorBufferPages = gRenderer->descriptorBuffers[gRenderer->currentFrame]->bufferCount;
+			gRenderer->frameStats.acquireToPresentMS = (SDL_GetPerformanceCounter() - gRenderer->acquireTime) * 1000 / (double)SDL_GetPerformanceFrequency();
+			gRenderer->lastFrameStats = gRenderer->frameStats;
+			memset(&gRenderer->frameStats, 0, sizeof(VK2DFrameStats));
+
+			gRenderer->currentFrame = (gRenderer->currentFrame + 1) % gRenderer->framesInFlight;
 
 			// Calculate time
 			gRenderer->accumulatedTime += (((double) SDL_GetPerformanceCounter() - gRenderer->previousTime) /
@@ -419,13 +853,74 @@ VK2DLogicalDevice vk2dRendererGetDevice() {
 	return NULL;
 }
 
+// Returns whether the declared target sequence binds tex again this frame, meaning its
+// image can stay in attachment layout instead of transitioning back and forth
+static bool _vk2dRendererHintKeepsAttachment(VK2DTexture tex) {
+	for (uint32_t i = gRenderer->targetHintIndex; i < gRenderer->targetHintCount; i++)
+		if (gRenderer->targetHints[i] == tex)
+			return true;
+	return false;
+}
+
+// Moves every target still parked in attachment layout back to shader-read in one barrier
+// and drops the declared sequence, only call outside of a render pass
+static void _vk2dRendererFlushDeferredTargetLayouts() {
+	if (gRenderer->targetHintCount == 0)
+		return;
+	uint32_t parked = 0;
+	for (uint32_t i = 0; i < gRenderer->targetListSize; i++)
+		if (gRenderer->targets[i] != NULL && gRenderer->targets[i]->imgAttachmentLayout)
+			parked++;
+	if (parked > 0) {
+		VkImage *imgs = vk2dFrameAlloc(sizeof(VkImage) * parked);
+		VkImageLayout *olds = vk2dFrameAlloc(sizeof(VkImageLayout) * parked);
+		VkImageLayout *news = vk2dFrameAlloc(sizeof(VkImageLayout) * parked);
+		if (vk2dPointerCheck(imgs) && vk2dPointerCheck(olds) && vk2dPointerCheck(news)) {
+			parked = 0;
+			for (uint32_t i = 0; i < gRenderer->targetListSize; i++) {
+				if (gRenderer->targets[i] != NULL && gRenderer->targets[i]->imgAttachmentLayout) {
+					gRenderer->targets[i]->imgAttachmentLayout = false;
+					imgs[parked] = gRenderer->targets[i]->img->img;
+					olds[parked] = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+					news[parked] = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+					parked++;
+				}
+			}
+			_vk2dTransitionImageLayouts(imgs, olds, news, parked);
+		}
+	}
+	gRenderer->targetHintCount = 0;
+	gRenderer->targetHintIndex = 0;
+}
+
+void vk2dRendererHintTargetSequence(VK2DTexture *targets, uint32_t count) {
+	if (gRenderer != NULL) {
+		if (targets == NULL || count == 0) {
+			gRenderer->targetHintCount = 0;
+			gRenderer->targetHintIndex = 0;
+			return;
+		}
+		if (gRenderer->targetHintListSize < count) {
+			VK2DTexture *newList = realloc(gRenderer->targetHints, sizeof(VK2DTexture) * count);
+			if (!vk2dPointerCheck(newList))
+				return;
+			gRenderer->targetHints = newList;
+			gRenderer->targetHintListSize = count;
+		}
+		memcpy(gRenderer->targetHints, targets, sizeof(VK2DTexture) * count);
+		gRenderer->targetHintCount = count;
+		gRenderer->targetHintIndex = 0;
+	} else {
+		vk2dLogMessage("Renderer is not initialized");
+	}
+}
+
 void vk2dRendererSetTarget(VK2DTexture target) {
 	if (gRenderer != NULL) {
 		if (target != gRenderer->target) {
-			// In case the user attempts to switch targets from one texture to another
-			if (target != VK2D_TARGET_SCREEN && gRenderer->target != VK2D_TARGET_SCREEN) {
-				vk2dRendererSetTarget(VK2D_TARGET_SCREEN);
-			}
+			// Pending batches and secondary recordings belong to the old target
+			_vk2dRendererFlushBatch();
+			_vk2dRendererExecuteParallelWork();
 
 			// Dont let the user bind textures that are not targets
 			if (target != VK2D_TARGET_SCREEN && !vk2dTextureIsTarget(target)) {
@@ -433,6 +928,7 @@ void vk2dRendererSetTarget(VK2DTexture target) {
 				return;
 			}
 
+			VK2DTexture previous = gRenderer->target;
 			gRenderer->target = target;
 
 			// Figure out which render pass to use
@@ -448,13 +944,43 @@ void vk2dRendererSetTarget(VK2DTexture target) {
 
 			vkCmdEndRenderPass(gRenderer->commandBuffer[gRenderer->scImageIndex]);
 
-			// Now we either have to transition the image layout depending on whats going in and whats poppin out
-			if (target == VK2D_TARGET_SCREEN)
-				_vk2dTransitionImageLayout(gRenderer->targetImage, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
-										   VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-			else
-				_vk2dTransitionImageLayout(target->img->img, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-										   VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
+			// Consume the declared sequence, binds it didn't predict flush every parked layout
+			if (gRenderer->targetHintCount > 0 && target != VK2D_TARGET_SCREEN) {
+				if (gRenderer->targetHintIndex < gRenderer->targetHintCount &&
+						gRenderer->targetHints[gRenderer->targetHintIndex] == target)
+					gRenderer->targetHintIndex++;
+				else
+					_vk2dRendererFlushDeferredTargetLayouts();
+			}
+
+			// Both targets' layout moves ride one barrier, and a target the declared sequence
+			// binds again skips its round trip through shader-read entirely
+			VkImage barrierImgs[2];
+			VkImageLayout barrierOld[2];
+			VkImageLayout barrierNew[2];
+			uint32_t barrierCount = 0;
+			if (previous != VK2D_TARGET_SCREEN) {
+				if (_vk2dRendererHintKeepsAttachment(previous)) {
+					previous->imgAttachmentLayout = true;
+				} else {
+					barrierImgs[barrierCount] = previous->img->img;
+					barrierOld[barrierCount] = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+					barrierNew[barrierCount] = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+					barrierCount++;
+				}
+			}
+			if (target != VK2D_TARGET_SCREEN) {
+				if (target->imgAttachmentLayout) {
+					target->imgAttachmentLayout = false;
+				} else {
+					barrierImgs[barrierCount] = target->img->img;
+					barrierOld[barrierCount] = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+					barrierNew[barrierCount] = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+					barrierCount++;
+				}
+			}
+			if (barrierCount > 0)
+				_vk2dTransitionImageLayouts(barrierImgs, barrierOld, barrierNew, barrierCount);
 
 			// Assign new render targets
 			gRenderer->targetRenderPass = pass;
@@ -485,6 +1011,149 @@ void vk2dRendererSetTarget(VK2DTexture target) {
 	}
 }
 
+/******************************* Asynchronous readbacks *******************************/
+
+// Destroys a readback's Vulkan resources for real, only safe once its frame has retired
+static void _vk2dReadbackDestroy(void *readback) {
+	VK2DReadback rb = readback;
+	VK2DRenderer renderer = vk2dRendererGetPointer();
+	if (rb->data != NULL && renderer != NULL)
+		vmaUnmapMemory(renderer->vma, rb->buffer->mem);
+	vk2dBufferFree(rb->buffer);
+	free(rb);
+}
+
+// Drops a readback from the renderer's pending list if its still in there
+static void _vk2dRendererRemoveReadback(VK2DReadback readback) {
+	for (uint32_t i = 0; i < gRenderer->readbackCount; i++) {
+		if (gRenderer->readbacks[i] == readback) {
+			gRenderer->readbacks[i] = gRenderer->readbacks[gRenderer->readbackCount - 1];
+			gRenderer->readbackCount--;
+			return;
+		}
+	}
+}
+
+// Records every requested copy into the frame's command buffer, called at end-of-frame
+// once the final render pass has ended so the barriers are legal
+static void _vk2dRendererRecordReadbacks() {
+	for (uint32_t i = 0; i < gRenderer->readbackCount; i++) {
+		VK2DReadback rb = gRenderer->readbacks[i];
+		if (rb->recorded)
+			continue;
+
+		VkImage img;
+		VkImageLayout layout;
+		if (rb->target != NULL) {
+			img = rb->target->img->img;
+			layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+		} else {
+			img = gRenderer->swapchainImages[gRenderer->scImageIndex];
+			layout = gRenderer->headless ? VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL : VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+		}
+
+		VkBufferImageCopy region = {0};
+		region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+		region.imageSubresource.layerCount = 1;
+		region.imageExtent.width = rb->width;
+		region.imageExtent.height = rb->height;
+		region.imageExtent.depth = 1;
+
+		_vk2dTransitionImageLayout(img, layout, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL);
+		vkCmdCopyImageToBuffer(gRenderer->commandBuffer[gRenderer->scImageIndex], img,
+							   VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, rb->buffer->buf, 1, &region);
+		_vk2dTransitionImageLayout(img, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, layout);
+
+		rb->frame = gRenderer->currentFrame;
+		rb->recorded = true;
+	}
+}
+
+VK2DReadback vk2dRendererRequestReadback(VK2DTexture target) {
+	if (gRenderer == NULL) {
+		vk2dLogMessage("Renderer is not initialized");
+		return NULL;
+	}
+	if (target != NULL && !vk2dTextureIsTarget(target)) {
+		vk2dLogMessage("Texture is not a target, cannot read it back.");
+		return NULL;
+	}
+	if (target == NULL && !gRenderer->swapchainTransferSrc) {
+		vk2dLogMessage("Surface does not support copying from the swapchain, render to a target instead.");
+		return NULL;
+	}
+
+	VK2DReadback rb = calloc(1, sizeof(struct VK2DReadback_t));
+	if (!vk2dPointerCheck(rb))
+		return NULL;
+	rb->target = target;
+	rb->width = target != NULL ? target->img->width : gRenderer->surfaceWidth;
+	rb->height = target != NULL ? target->img->height : gRenderer->surfaceHeight;
+	rb->buffer = vk2dBufferCreate(gRenderer->ld, (VkDeviceSize)rb->width * rb->height * 4,
+								  VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+								  VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+	if (rb->buffer == NULL) {
+		free(rb);
+		return NULL;
+	}
+
+	if (gRenderer->readbackCount == gRenderer->readbackListSize) {
+		VK2DReadback *newList = realloc(gRenderer->readbacks, sizeof(VK2DReadback) * (gRenderer->readbackListSize + VK2D_DEFAULT_ARRAY_EXTENSION));
+		if (!vk2dPointerCheck(newList)) {
+			vk2dBufferFree(rb->buffer);
+			free(rb);
+			return NULL;
+		}
+		gRenderer->readbacks = newList;
+		gRenderer->readbackListSize += VK2D_DEFAULT_ARRAY_EXTENSION;
+	}
+	gRenderer->readbacks[gRenderer->readbackCount++] = rb;
+	return rb;
+}
+
+bool vk2dReadbackIsComplete(VK2DReadback readback) {
+	if (readback == NULL || gRenderer == NULL)
+		return false;
+	if (readback->complete)
+		return true;
+	if (!readback->recorded)
+		return false;
+
+	// Safe to poll - the frame's fence can't be reset again before the completion sweep
+	// in vk2dRendererStartFrame pulls this readback out of the pending list
+	if (vkGetFenceStatus(gRenderer->ld->dev, gRenderer->inFlightFences[readback->frame]) == VK_SUCCESS) {
+		readback->complete = true;
+		_vk2dRendererRemoveReadback(readback);
+	}
+	return readback->complete;
+}
+
+void *vk2dReadbackGetPixels(VK2DReadback readback, uint32_t *width, uint32_t *height) {
+	if (readback == NULL)
+		return NULL;
+	if (!vk2dReadbackIsComplete(readback))
+		return NULL;
+	if (readback->data == NULL)
+		vmaMapMemory(gRenderer->vma, readback->buffer->mem, &readback->data);
+	if (width != NULL)
+		*width = readback->width;
+	if (height != NULL)
+		*height = readback->height;
+	return readback->data;
+}
+
+void vk2dReadbackFree(VK2DReadback readback) {
+	if (readback != NULL) {
+		if (gRenderer != NULL) {
+			_vk2dRendererRemoveReadback(readback);
+			// A copy may still be in flight, the frame fence decides when the buffer really dies
+			if (readback->recorded && !readback->complete && _vk2dRendererDeferFree(_vk2dReadbackDestroy, readback))
+				return;
+		}
+		_vk2dReadbackDestroy(readback);
+	}
+}
+
 void vk2dRendererSetColourMod(const vec4 mod) {
 	if (gRenderer != NULL) {
 		gRenderer->colourBlend[0] = mod[0];
@@ -529,6 +1198,9 @@ void vk2dRendererSetCamera(VK2DCameraSpec camera) {
 		gRenderer->cameras[VK2D_DEFAULT_CAMERA].spec.hOnScreen = gRenderer->surfaceHeight;
 		gRenderer->cameras[VK2D_DEFAULT_CAMERA].spec.xOnScreen = 0;
 		gRenderer->cameras[VK2D_DEFAULT_CAMERA].spec.yOnScreen = 0;
+		if (gRenderer->cameras[VK2D_DEFAULT_CAMERA].uboDirty != NULL)
+			for (int i = 0; i < gRenderer->swapchainImageCount; i++)
+				gRenderer->cameras[VK2D_DEFAULT_CAMERA].uboDirty[i] = true;
 	} else {
 		vk2dLogMessage("Renderer is not initialized");
 	}
@@ -550,6 +1222,122 @@ void vk2dRendererSetTextureCamera(bool useCameraOnTextures) {
 		vk2dLogMessage("Renderer is not initialized");
 }
 
+void vk2dRendererSetBatching(bool enableBatching) {
+	if (gRenderer != NULL) {
+		// Whatever was queued under the old setting is drawn before the switch
+		_vk2dRendererFlushBatch();
+		gRenderer->batching = enableBatching;
+	} else {
+		vk2dLogMessage("Renderer is not initialized");
+	}
+}
+
+void vk2dRendererFlushBatch() {
+	if (gRenderer != NULL)
+		_vk2dRendererFlushBatch();
+	else
+		vk2dLogMessage("Renderer is not initialized");
+}
+
+void vk2dRendererSetRenderQueue(bool enableRenderQueue) {
+	if (gRenderer != NULL) {
+		// Whatever was queued under the old setting is drawn before the switch
+		_vk2dRendererFlushBatch();
+		gRenderer->renderQueue = enableRenderQueue;
+	} else {
+		vk2dLogMessage("Renderer is not initialized");
+	}
+}
+
+void vk2dRendererSetCulling(bool enableCulling) {
+	if (gRenderer != NULL)
+		gRenderer->enableCulling = enableCulling;
+	else
+		vk2dLogMessage("Renderer is not initialized");
+}
+
+bool vk2dRendererSetParallelRecordingSlots(uint32_t count) {
+	if (gRenderer != NULL) {
+		// Nothing the old slots recorded may still be in flight when their pools die
+		vkQueueWaitIdle(gRenderer->ld->queue);
+		for (uint32_t i = 0; i < gRenderer->threadSlotCount; i++)
+			vkDestroyCommandPool(gRenderer->ld->dev, gRenderer->threadSlots[i].pool, VK_NULL_HANDLE);
+		free(gRenderer->threadSlots);
+		gRenderer->threadSlots = NULL;
+		gRenderer->threadSlotCount = 0;
+
+		if (count == 0)
+			return true;
+
+		// The TLS slot is created once and reused for the renderer's whole life
+		if (gRenderer->threadSlotTLS == 0) {
+			gRenderer->threadSlotTLS = SDL_TLSCreate();
+			if (gRenderer->threadSlotTLS == 0) {
+				vk2dLogMessage("Failed to create thread-local storage for parallel recording");
+				return false;
+			}
+		}
+
+		gRenderer->threadSlots = calloc(count, sizeof(VK2DThreadSlot));
+		if (!vk2dPointerCheck(gRenderer->threadSlots))
+			return false;
+
+		// Each slot gets its own pool because command pools can't be shared between threads
+		for (uint32_t i = 0; i < count; i++) {
+			VkCommandPoolCreateInfo commandPoolCreateInfo = vk2dInitCommandPoolCreateInfo(gRenderer->pd->QueueFamily.graphicsFamily, VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT);
+			vk2dErrorCheck(vkCreateCommandPool(gRenderer->ld->dev, &commandPoolCreateInfo, VK_NULL_HANDLE, &gRenderer->threadSlots[i].pool));
+			VkCommandBufferAllocateInfo commandBufferAllocateInfo = vk2dInitCommandBufferAllocateInfo(gRenderer->threadSlots[i].pool, 1);
+			commandBufferAllocateInfo.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+			vk2dErrorCheck(vkAllocateCommandBuffers(gRenderer->ld->dev, &commandBufferAllocateInfo, &gRenderer->threadSlots[i].buffer));
+		}
+		gRenderer->threadSlotCount = count;
+		return true;
+	}
+	vk2dLogMessage("Renderer is not initialized");
+	return false;
+}
+
+void vk2dRendererBeginParallelRecording(uint32_t slot) {
+	if (gRenderer != NULL) {
+		if (slot >= gRenderer->threadSlotCount) {
+			vk2dLogMessage("Parallel recording slot %i does not exist", slot);
+			return;
+		}
+		VK2DThreadSlot *threadSlot = &gRenderer->threadSlots[slot];
+		if (!threadSlot->active) {
+			// The recording inherits the pass/framebuffer of whatever target is bound right now
+			VkCommandBufferInheritanceInfo inheritanceInfo = vk2dInitCommandBufferInheritanceInfo(
+					gRenderer->targetRenderPass,
+					gRenderer->targetSubPass,
+					gRenderer->targetFrameBuffer);
+			VkCommandBufferBeginInfo beginInfo = vk2dInitCommandBufferBeginInfo(
+					VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT | VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT,
+					&inheritanceInfo);
+			vk2dErrorCheck(vkBeginCommandBuffer(threadSlot->buffer, &beginInfo));
+			threadSlot->active = true;
+		}
+		SDL_TLSSet(gRenderer->threadSlotTLS, threadSlot, NULL);
+	} else {
+		vk2dLogMessage("Renderer is not initialized");
+	}
+}
+
+void vk2dRendererEndParallelRecording() {
+	if (gRenderer != NULL) {
+		if (gRenderer->threadSlotTLS != 0)
+			SDL_TLSSet(gRenderer->threadSlotTLS, NULL, NULL);
+	} else {
+		vk2dLogMessage("Renderer is not initialized");
+	}
+}
+
+void vk2dRendererExecuteParallelRecordings() {
+	if (gRenderer != NULL)
+		_vk2dRendererExecuteParallelWork();
+	else
+		vk2dLogMessage("Renderer is not initialized");
+}
+
 void vk2dRendererLockCameras(VK2DCameraIndex cam) {
 	if (gRenderer != NULL)
 		gRenderer->cameraLocked = cam;
@@ -572,8 +1360,35 @@ double vk2dRendererGetAverageFrameTime() {
 	return 0;
 }
 
+void vk2dRendererSetTargetFrameTime(double milliseconds) {
+	if (gRenderer != NULL) {
+		gRenderer->targetFrameTimeMS = milliseconds > 0 ? milliseconds : 0;
+		// The first paced frame anchors a fresh deadline instead of chasing a stale one
+		gRenderer->pacingDeadline = 0;
+	} else {
+		vk2dLogMessage("Renderer is not initialized");
+	}
+}
+
+VK2DFrameStats vk2dRendererGetFrameStats() {
+	VK2DFrameStats empty = {0};
+	if (gRenderer != NULL)
+		return gRenderer->lastFrameStats;
+	vk2dLogMessage("Renderer is not initialized");
+	return empty;
+}
+
+VK2DGpuProfile vk2dRendererGetGpuProfile() {
+	VK2DGpuProfile empty = {0};
+	if (gRenderer != NULL)
+		return gRenderer->gpuProfile;
+	vk2dLogMessage("Renderer is not initialized");
+	return empty;
+}
+
 void vk2dRendererClear() {
 	if (gRenderer != NULL) {
+		_vk2dRendererFlushBatch();
 		VkDescriptorSet set = gRenderer->unitUBOSet;
 		_vk2dRendererDrawRaw(&set, 1, gRenderer->unitSquare, gRenderer->primFillPipe, 0, 0, 1, 1, 0, 0, 0, 1, 0, 0, 0,
 							 0, VK2D_INVALID_CAMERA);
@@ -612,9 +1427,63 @@ VK2DRendererLimits vk2dRendererGetLimits() {
 	return l;
 }
 
+VK2DMemoryStats vk2dRendererGetMemoryStats() {
+	VK2DMemoryStats stats = {0};
+	if (gRenderer != NULL) {
+		VmaTotalStatistics total;
+		vmaCalculateStatistics(gRenderer->vma, &total);
+		stats.allocationCount = total.total.statistics.allocationCount;
+		stats.allocationBytes = total.total.statistics.allocationBytes;
+		stats.blockBytes = total.total.statistics.blockBytes;
+
+		VmaBudget budgets[VK_MAX_MEMORY_HEAPS];
+		vmaGetHeapBudgets(gRenderer->vma, budgets);
+		stats.heapCount = gRenderer->pd->mem.memoryHeapCount;
+		for (uint32_t i = 0; i < stats.heapCount; i++) {
+			stats.heapUsage[i] = budgets[i].usage;
+			stats.heapBudget[i] = budgets[i].budget;
+		}
+
+		// Both halves of every descriptor buffer page, across every frame slot
+		for (uint32_t i = 0; i < gRenderer->framesInFlight; i++) {
+			VK2DDescriptorBuffer db = gRenderer->descriptorBuffers[i];
+			for (int j = 0; j < db->bufferCount; j++)
+				stats.descriptorBufferBytes += db->buffers[j].deviceBuffer->size + db->buffers[j].stageBuffer->size;
+		}
+	} else {
+		vk2dLogMessage("Renderer is not initialized");
+	}
+	return stats;
+}
+
+void vk2dRendererSetMemoryBudgetCallback(VK2DMemoryBudgetCallback callback, void *context) {
+	if (gRenderer != NULL) {
+		gRenderer->memoryBudgetCallback = callback;
+		gRenderer->memoryBudgetContext = context;
+	} else {
+		vk2dLogMessage("Renderer is not initialized");
+	}
+}
+
 void vk2dRendererDrawRectangle(float x, float y, float w, float h, float r, float ox, float oy) {
 	if (gRenderer != NULL) {
-		vk2dRendererDrawPolygon(gRenderer->unitSquare, x, y, true, 1, w, h, r, ox / w, oy / h);
+		// Two world-space triangles into the shape batch instead of a draw per rectangle
+		VK2DVertexColour *vertices = _vk2dRendererAppendShapeVertices(6);
+		if (vertices == NULL)
+			return;
+		float c = 1;
+		float s = 0;
+		if (r != 0) {
+			c = cosf(r);
+			s = sinf(r);
+		}
+		const float cornerX[] = {0, w, w, w, 0, 0};
+		const float cornerY[] = {0, 0, h, h, h, 0};
+		for (int i = 0; i < 6; i++) {
+			float px = cornerX[i] - ox;
+			float py = cornerY[i] - oy;
+			_vk2dRendererShapeVertex(&vertices[i], x + ox + (px * c) - (py * s), y + oy + (px * s) + (py * c));
+		}
 	} else {
 		vk2dLogMessage("Renderer is not initialized");
 	}
@@ -630,7 +1499,19 @@ void vk2dRendererDrawRectangleOutline(float x, float y, float w, float h, float
 
 void vk2dRendererDrawCircle(float x, float y, float r) {
 	if (gRenderer != NULL) {
-		vk2dRendererDrawPolygon(gRenderer->unitCircle, x, y, true, 1, r * 2, r * 2, 0, 0, 0);
+		// A fan of world-space triangles into the shape batch, same vertex count the
+		// retained unit circle uses so the silhouette matches the outline variant
+		const int segments = (int)VK2D_CIRCLE_VERTICES;
+		VK2DVertexColour *vertices = _vk2dRendererAppendShapeVertices((segments - 2) * 3);
+		if (vertices == NULL)
+			return;
+		const float step = (VK2D_PI * 2) / segments;
+		uint32_t count = 0;
+		for (int i = 1; i < segments - 1; i++) {
+			_vk2dRendererShapeVertex(&vertices[count++], x + r, y);
+			_vk2dRendererShapeVertex(&vertices[count++], x + (cosf(i * step) * r), y + (sinf(i * step) * r));
+			_vk2dRendererShapeVertex(&vertices[count++], x + (cosf((i + 1) * step) * r), y + (sinf((i + 1) * step) * r));
+		}
 	} else {
 		vk2dLogMessage("Renderer is not initialized");
 	}
@@ -646,9 +1527,21 @@ void vk2dRendererDrawCircleOutline(float x, float y, float r, float lineWidth) {
 
 void vk2dRendererDrawLine(float x1, float y1, float x2, float y2) {
 	if (gRenderer != NULL) {
-		float x = sqrtf(powf(y2 - y1, 2) + powf(x2 - x1, 2));
-		float r = atan2f(y2 - y1, x2 - x1);
-		vk2dRendererDrawPolygon(gRenderer->unitLine, x1, y1, false, 1, x, 1, r, 0, 0);
+		// A pixel-wide world-space quad into the shape batch instead of a line draw
+		float length = sqrtf(powf(y2 - y1, 2) + powf(x2 - x1, 2));
+		if (length == 0)
+			return;
+		VK2DVertexColour *vertices = _vk2dRendererAppendShapeVertices(6);
+		if (vertices == NULL)
+			return;
+		float nx = -(y2 - y1) / length * 0.5f;
+		float ny = (x2 - x1) / length * 0.5f;
+		_vk2dRendererShapeVertex(&vertices[0], x1 - nx, y1 - ny);
+		_vk2dRendererShapeVertex(&vertices[1], x2 - nx, y2 - ny);
+		_vk2dRendererShapeVertex(&vertices[2], x2 + nx, y2 + ny);
+		_vk2dRendererShapeVertex(&vertices[3], x2 + nx, y2 + ny);
+		_vk2dRendererShapeVertex(&vertices[4], x1 + nx, y1 + ny);
+		_vk2dRendererShapeVertex(&vertices[5], x1 - nx, y1 - ny);
 	} else {
 		vk2dLogMessage("Renderer is not initialized");
 	}
@@ -657,14 +1550,21 @@ void vk2dRendererDrawLine(float x1, float y1, float x2, float y2) {
 void vk2dRendererDrawShader(VK2DShader shader, void *data, VK2DTexture tex, float x, float y, float xscale, float yscale, float rot, float originX, float originY, float xInTex, float yInTex, float texWidth, float texHeight) {
 	if (gRenderer != NULL) {
 		if (shader != NULL) {
-			VkDescriptorSet sets[4];
+			// Shaders still building on a background thread draw through the stock texture
+			// pipeline (ignoring the uniform) until their own pipeline comes online
+			if (!shader->pipeReady) {
+				vk2dRendererDrawTexture(tex, x, y, xscale, yscale, rot, originX, originY, xInTex, yInTex, texWidth, texHeight);
+				return;
+			}
+			_vk2dRendererFlushBatch();
+			VkDescriptorSet sets[5];
 			sets[1] = gRenderer->samplerSet;
 			sets[2] = tex->img->set;
 
 			// Create the data uniform
 			uint32_t setCount = 3;
 			if (shader->uniformSize != 0) {
-				sets[3] = vk2dDescConGetSet(shader->descCons[gRenderer->scImageIndex]);
+				sets[3] = vk2dDescConGetSet(shader->descCons[gRenderer->currentFrame]);
 				VkBuffer buffer;
 				VkDeviceSize offset;
 				vk2dDescriptorBufferCopyData(gRenderer->descriptorBuffers[gRenderer->currentFrame], data, shader->uniformSize, &buffer, &offset);
@@ -679,6 +1579,15 @@ void vk2dRendererDrawShader(VK2DShader shader, void *data, VK2DTexture tex, floa
 				setCount = 4;
 			}
 
+			// The texture array always binds at set 4 - shaders without a uniform bind an
+			// unwritten set 3 as a gap filler, which is fine since they never read from it
+			if (gRenderer->limits.supportsTextureArray) {
+				if (shader->uniformSize == 0)
+					sets[3] = vk2dDescConGetSet(shader->descCons[gRenderer->currentFrame]);
+				sets[4] = gRenderer->texArraySet;
+				setCount = 5;
+			}
+
 			_vk2dRendererDraw(sets, setCount, NULL, shader->pipe, x, y, xscale, yscale, rot, originX, originY, 1,
 							  xInTex,
 							  yInTex, texWidth, texHeight);
@@ -692,12 +1601,93 @@ void vk2dRendererDrawShader(VK2DShader shader, void *data, VK2DTexture tex, floa
 
 void vk2dRendererDrawInstanced(VK2DTexture tex, VK2DDrawInstance *instances, uint32_t count) {
 	if (gRenderer != NULL) {
+		_vk2dRendererFlushBatch();
 		VkDescriptorSet sets[3];
 		sets[1] = gRenderer->samplerSet;
 		sets[2] = tex->img->set;
-		if (count > gRenderer->limits.maxInstancedDraws)
-			count = gRenderer->limits.maxInstancedDraws;
-		_vk2dRendererDrawInstanced(sets, 3, instances, count);
+
+		// One instanced draw can only source a single descriptor-buffer page, so bigger
+		// arrays stream through back-to-back draws that each fill a page
+		uint32_t offset = 0;
+		while (offset < count) {
+			uint32_t chunk = count - offset < gRenderer->limits.maxInstancedDraws ? count - offset : gRenderer->limits.maxInstancedDraws;
+			_vk2dRendererDrawInstanced(sets, 3, &instances[offset], chunk);
+			offset += chunk;
+		}
+	} else {
+		vk2dLogMessage("Renderer is not initialized");
+	}
+}
+
+void vk2dRendererDrawInstancedCompact(VK2DTexture tex, VK2DDrawInstanceCompact *instances, uint32_t count) {
+	if (gRenderer != NULL) {
+		// Compact instances get expanded into a frame-arena list right before recording
+		VK2DDrawInstance *expanded = vk2dFrameAlloc(sizeof(VK2DDrawInstance) * count);
+		if (!vk2dPointerCheck(expanded))
+			return;
+
+		for (uint32_t i = 0; i < count; i++) {
+			VK2DDrawInstanceCompact *in = &instances[i];
+			if (in->rotation != 0 || in->scale[0] != 1 || in->scale[1] != 1)
+				vk2dInstanceSet(&expanded[i], in->pos[0], in->pos[1], in->scale[0], in->scale[1],
+								in->rotation, in->origin[0], in->origin[1], in->texturePos[0], in->texturePos[1],
+								in->texturePos[2], in->texturePos[3], in->colour);
+			else
+				vk2dInstanceSetFast(&expanded[i], in->pos[0], in->pos[1], in->texturePos[0],
+									in->texturePos[1], in->texturePos[2], in->texturePos[3], in->colour);
+		}
+
+		vk2dRendererDrawInstanced(tex, expanded, count);
+	} else {
+		vk2dLogMessage("Renderer is not initialized");
+	}
+}
+
+void vk2dRendererDrawInstancedIndirect(VK2DTexture tex, VK2DBuffer instances, VK2DBuffer commands, uint32_t commandIndex, uint32_t drawCount) {
+	if (gRenderer != NULL) {
+		if (instances != NULL && commands != NULL) {
+			_vk2dRendererFlushBatch();
+			VkDescriptorSet sets[3];
+			sets[1] = gRenderer->samplerSet;
+			sets[2] = tex->img->set;
+			_vk2dRendererDrawInstancedIndirect(sets, 3, instances, commands, commandIndex * sizeof(VK2DDrawCommand), drawCount);
+		} else {
+			vk2dLogMessage("Indirect draw buffers do not exist");
+		}
+	} else {
+		vk2dLogMessage("Renderer is not initialized");
+	}
+}
+
+void vk2dRendererDrawList(VK2DDrawList list) {
+	if (gRenderer != NULL) {
+		if (list != NULL) {
+			vk2dDrawListBake(list);
+			if (list->instances != NULL)
+				vk2dRendererDrawInstancedIndirect(list->tex, list->instances, list->commands, 0, 1);
+		} else {
+			vk2dLogMessage("Draw list does not exist");
+		}
+	} else {
+		vk2dLogMessage("Renderer is not initialized");
+	}
+}
+
+void vk2dRendererDrawParticles(VK2DParticleSystem system, VK2DTexture tex) {
+	if (gRenderer != NULL) {
+		if (system != NULL) {
+			_vk2dRendererFlushBatch();
+
+			// The update dispatch has to land before the draw sources its results
+			vk2dComputeShaderWait(system->shader);
+
+			VkDescriptorSet sets[3];
+			sets[1] = gRenderer->samplerSet;
+			sets[2] = tex->img->set;
+			_vk2dRendererDrawInstancedIndirect(sets, 3, system->instances, system->indirect, 0, 1);
+		} else {
+			vk2dLogMessage("Particle system does not exist");
+		}
 	} else {
 		vk2dLogMessage("Renderer is not initialized");
 	}
@@ -706,6 +1696,20 @@ void vk2dRendererDrawInstanced(VK2DTexture tex, VK2DDrawInstance *instances, uin
 void vk2dRendererDrawTexture(VK2DTexture tex, float x, float y, float xscale, float yscale, float rot, float originX, float originY, float xInTex, float yInTex, float texWidth, float texHeight) {
 	if (gRenderer != NULL) {
 		if (tex != NULL) {
+			// Batching and the render queue only collect draws from the main recording
+			// thread - parallel recording threads record straight into their own buffer
+			if (!_vk2dRendererThreadOnSecondary()) {
+				// Queued draws are recorded at the next flush sorted by state to minimize rebinds
+				if (gRenderer->renderQueue) {
+					_vk2dRendererAppendQueue(tex, x, y, xscale, yscale, rot, originX, originY, xInTex, yInTex, texWidth, texHeight);
+					return;
+				}
+				// Batched draws are accumulated and flushed all at once through the instancing pipeline
+				if (gRenderer->batching) {
+					_vk2dRendererAppendBatch(tex, x, y, xscale, yscale, rot, originX, originY, xInTex, yInTex, texWidth, texHeight);
+					return;
+				}
+			}
 			VkDescriptorSet sets[3];
 			sets[1] = gRenderer->samplerSet;
 			sets[2] = tex->img->set;
@@ -722,6 +1726,7 @@ void vk2dRendererDrawTexture(VK2DTexture tex, float x, float y, float xscale, fl
 void vk2dRendererDrawPolygon(VK2DPolygon polygon, float x, float y, bool filled, float lineWidth, float xscale, float yscale, float rot, float originX, float originY) {
 	if (gRenderer != NULL) {
 		if (polygon != NULL) {
+			_vk2dRendererFlushBatch();
 			VkDescriptorSet set;
 			_vk2dRendererDraw(&set, 1, polygon, filled ? gRenderer->primFillPipe : gRenderer->primLinePipe, x, y,
 							  xscale,
@@ -737,6 +1742,7 @@ void vk2dRendererDrawPolygon(VK2DPolygon polygon, float x, float y, bool filled,
 void vk2dRendererDrawModel(VK2DModel model, float x, float y, float z, float xscale, float yscale, float zscale, float rot, vec3 axis, float originX, float originY, float originZ) {
 	if (gRenderer != NULL) {
 		if (model != NULL) {
+			_vk2dRendererFlushBatch();
 			VkDescriptorSet sets[3];
 			sets[1] = gRenderer->modelSamplerSet;
 			sets[2] = model->tex->img->set;
@@ -750,9 +1756,26 @@ void vk2dRendererDrawModel(VK2DModel model, float x, float y, float z, float xsc
 	}
 }
 
+void vk2dRendererDrawModelInstanced(VK2DModel model, mat4 *transforms, uint32_t count) {
+	if (gRenderer != NULL) {
+		if (model != NULL && transforms != NULL && count > 0) {
+			_vk2dRendererFlushBatch();
+			VkDescriptorSet sets[3];
+			sets[1] = gRenderer->modelSamplerSet;
+			sets[2] = model->tex->img->set;
+			_vk2dRendererDraw3DInstanced(sets, 3, model, gRenderer->modelPipe, transforms, count);
+		} else {
+			vk2dLogMessage("Model does not exist");
+		}
+	} else {
+		vk2dLogMessage("Renderer is not initialized");
+	}
+}
+
 void vk2dRendererDrawWireframe(VK2DModel model, float x, float y, float z, float xscale, float yscale, float zscale, float rot, vec3 axis, float originX, float originY, float originZ, float lineWidth) {
 	if (gRenderer != NULL) {
 		if (model != NULL) {
+			_vk2dRendererFlushBatch();
 			VkDescriptorSet sets[3];
 			sets[1] = gRenderer->modelSamplerSet;
 			sets[2] = model->tex->img->set;
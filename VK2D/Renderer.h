@@ -24,6 +24,19 @@ extern "C" {
 /// null for options that would generally be fine for most things.
 VK2DResult vk2dRendererInit(SDL_Window *window, VK2DRendererConfig config, VK2DStartupOptions *options);
 
+/// \brief Initializes VK2D's renderer without a window for offscreen rendering
+/// \param config Initial renderer configuration settings (screen mode is ignored, there is nothing to present)
+/// \param options Renderer options, or just NULL for defaults
+/// \param width Width in pixels of the internal render targets that stand in for the screen
+/// \param height Height in pixels of the internal render targets
+/// \return Returns a VK2DResult enum
+///
+/// This is meant for batch jobs and servers without a display: no VkSurfaceKHR or swapchain
+/// is created, frames are rendered into internal images instead of being presented, and
+/// vk2dRendererStartFrame/vk2dRendererEndFrame work like they normally would. Render into
+/// textures made with vk2dTextureCreate and read the results back with vk2dTextureGetPixels.
+VK2DResult vk2dRendererInitHeadless(VK2DRendererConfig config, VK2DStartupOptions *options, uint32_t width, uint32_t height);
+
 /// \brief Waits until current GPU tasks are done before moving on
 ///
 /// Make sure you call this before freeing your assets in case they're still being used.
@@ -74,12 +87,52 @@ VK2DLogicalDevice vk2dRendererGetDevice();
 
 /// \brief Changes the render target to a texture or the screen
 /// \param target Target texture to switch to or VK2D_TARGET_SCREEN for the screen
-/// \warning This is mildly taxing on the GPU
+/// \warning This is mildly taxing on the GPU, see vk2dRendererHintTargetSequence if you switch a lot
 ///
 /// Switches drawing operations so that they will be performed on the specified target.
 /// Target must be either a texture that was created for rendering or VK2D_TARGET_SCREEN.
+/// Texture-to-texture switches go directly between the two targets.
 void vk2dRendererSetTarget(VK2DTexture target);
 
+/// \brief Declares the order of texture targets the frame will bind so switches cost less
+/// \param targets Every texture target the frame will pass to vk2dRendererSetTarget, in order (screen binds are not listed)
+/// \param count Number of binds in the list, or 0 to clear the declaration
+///
+/// When a target in the sequence will be bound again before the frame ends, its image is
+/// left in attachment layout across the switch instead of doing a round trip through
+/// shader-read, which is most of the cost of ping-ponging between lighting layers. A
+/// target may not be drawn (sampled) until after its last appearance in the sequence.
+/// Binding targets in a different order than declared is safe but forfeits the savings
+/// for the rest of the frame. The declaration is cleared at the end of every frame.
+void vk2dRendererHintTargetSequence(VK2DTexture *targets, uint32_t count);
+
+/// \brief Requests an asynchronous copy of a target or the screen into host memory
+/// \param target Target texture to copy, or NULL for the screen
+/// \return Returns a readback handle to poll, or NULL if it failed
+///
+/// The copy is recorded at the end of the current frame and rides that frame's fence,
+/// so there is no stall anywhere - the pixels are typically ready one or two frames
+/// later. Poll with vk2dReadbackIsComplete and fetch with vk2dReadbackGetPixels. Screen
+/// readbacks capture whatever the frame presents; requests made between frames capture
+/// the next frame. The pixels are 4 bytes each in the target's (or surface's) format.
+VK2DReadback vk2dRendererRequestReadback(VK2DTexture target);
+
+/// \brief Returns whether a readback's pixels have landed, never blocks
+/// \param readback Readback to poll, may be NULL
+/// \return Returns true once the copy is done on the GPU
+bool vk2dReadbackIsComplete(VK2DReadback readback);
+
+/// \brief Returns a readback's pixels, or NULL if they haven't landed yet
+/// \param readback Readback to fetch from
+/// \param width Filled with the width in pixels, may be NULL
+/// \param height Filled with the height in pixels, may be NULL
+/// \return Returns the pixel data, valid until vk2dReadbackFree
+void *vk2dReadbackGetPixels(VK2DReadback readback, uint32_t *width, uint32_t *height);
+
+/// \brief Frees a readback, safe to call while the copy is still in flight
+/// \param readback Readback to free, may be NULL
+void vk2dReadbackFree(VK2DReadback readback);
+
 /// \brief Sets the rendering blend mode (does nothing if VK2D_GENERATE_BLEND_MODES is disabled)
 /// \param blendMode Blend mode to use for drawing
 void vk2dRendererSetBlendMode(VK2DBlendMode blendMode);
@@ -108,10 +161,127 @@ void vk2dRendererGetColourMod(vec4 dst);
 /// may draw your game to a texture.
 void vk2dRendererSetTextureCamera(bool useCameraOnTextures);
 
+/// \brief Enables or disables automatic sprite batching, off by default
+/// \param enableBatching Whether or not texture draws should be batched
+///
+/// While batching is enabled, consecutive vk2dRendererDrawTexture calls that share a
+/// texture and blend mode are accumulated and drawn as a single instanced draw instead
+/// of one draw call each. Batches are flushed automatically whenever something other
+/// than a texture is drawn, the texture or blend mode changes, the render target
+/// changes, or the frame ends - which means draw order is still exactly what you asked
+/// for. This is a large performance win if you draw many sprites from the same texture
+/// back-to-back (use a texture atlas to make that the common case).
+void vk2dRendererSetBatching(bool enableBatching);
+
+/// \brief Draws whatever is waiting in the sprite batch right now
+///
+/// You generally don't need to call this yourself since batches are flushed
+/// automatically at every point where draw order could be affected, but it is
+/// available should you want to force the instanced draw to be recorded.
+void vk2dRendererFlushBatch();
+
+/// \brief Enables or disables the deferred render queue, off by default
+/// \param enableRenderQueue Whether or not texture draws should be queued and state-sorted
+///
+/// While the render queue is enabled, vk2dRendererDrawTexture calls are recorded into a
+/// CPU-side queue instead of the command buffer. The queue is sorted by blend mode and
+/// texture whenever it is flushed (any non-texture draw, render-target switch, or end of
+/// frame) and each run of identical state is recorded as a single instanced draw. Unlike
+/// the sprite batcher this helps even when textures are interleaved, at the cost that
+/// texture draws may be reordered relative to each other between flushes - don't enable
+/// this if you rely on overlapping sprites of different textures drawing in submission
+/// order. Takes precedence over vk2dRendererSetBatching when both are enabled.
+void vk2dRendererSetRenderQueue(bool enableRenderQueue);
+
+/// \brief Enables or disables camera-bounds culling, off by default
+/// \param enableCulling Whether or not draws should be tested against each camera's view of the world
+///
+/// While culling is enabled, texture draws and instance lists are tested against a
+/// conservative bounding rectangle of each enabled camera's view of the game world
+/// before anything is recorded for that camera - draws no camera can see cost nothing,
+/// and instanced draws only record the instances each camera can actually see. The
+/// test is conservative (rotated cameras and sprites are bounded by their diagonal)
+/// so nothing visible is ever skipped. Shape and polygon draws are unaffected because
+/// the renderer does not know their extents. This is a large win with several cameras,
+/// like split-screen, where most draws land outside any one camera's view.
+void vk2dRendererSetCulling(bool enableCulling);
+
+/// \brief Creates `count` recording slots so draws can be recorded from multiple threads
+/// \param count Number of slots to create, one per worker thread (0 disables the feature)
+/// \return Returns true if the slots were created
+///
+/// Each slot owns a secondary command buffer allocated from its own command pool, so a
+/// worker thread that has claimed a slot with vk2dRendererBeginParallelRecording may
+/// call the renderer's draw functions concurrently with other threads. The recordings
+/// are stitched into the frame with vkCmdExecuteCommands, either when you call
+/// vk2dRendererExecuteParallelRecordings or automatically at the end of the frame and
+/// whenever the render target changes. Waits for the GPU to go idle if slots already
+/// exist, so call this during setup and not every frame.
+bool vk2dRendererSetParallelRecordingSlots(uint32_t count);
+
+/// \brief Routes the calling thread's draws into the given recording slot
+/// \param slot Slot to record into, must be less than the count given to vk2dRendererSetParallelRecordingSlots
+///
+/// Call this from a worker thread after the frame has started; every draw the thread
+/// makes until vk2dRendererEndParallelRecording lands in the slot's secondary buffer
+/// instead of the frame's primary one. Each slot may only be claimed by one thread at a
+/// time and the recording belongs to whatever render target was bound when it began, so
+/// don't switch targets on the main thread while worker threads are recording. Sprite
+/// batching, the render queue, and shader/texture creation remain main-thread-only.
+void vk2dRendererBeginParallelRecording(uint32_t slot);
+
+/// \brief Stops routing the calling thread's draws into a recording slot
+///
+/// The recorded draws stay queued in the slot until they are executed; the same slot may
+/// be claimed again (by any thread) to append more draws before then.
+void vk2dRendererEndParallelRecording();
+
+/// \brief Executes every pending parallel recording into the current frame
+///
+/// This is called automatically in vk2dRendererEndFrame and when the render target
+/// changes, but you may call it yourself from the main thread to control where in the
+/// frame the recordings land. All worker threads must be done recording (in the sense of
+/// vk2dRendererEndParallelRecording) before this is called.
+void vk2dRendererExecuteParallelRecordings();
+
 /// \brief Gets the average amount of time frames are taking to process from the start of vk2dRendererStartFrame to the end of vk2dRendererEndFrame
 /// \return Returns average frame time over a course of a second in ms (1000 / vk2dRendererGetAverageFrameTime() will give FPS)
 double vk2dRendererGetAverageFrameTime();
 
+/// \brief Holds every frame to a fixed duration so the main loop runs at an even cadence
+/// \param milliseconds Frame time to pace to in milliseconds (16.6667 for 60 FPS), 0 or less disables pacing
+///
+/// After each present the renderer sleeps out whatever remains of the frame's deadline,
+/// using a coarse sleep for the bulk and a short spin for a precise wakeup. This evens
+/// out the uneven cadence VK2D_SCREEN_MODE_IMMEDIATE spins at, and under VSYNC a target
+/// slightly under the display interval keeps the loop from drifting into the interval
+/// and stuttering across it. A frame that blows past its deadline resyncs instead of
+/// shorting the frames after it, and each frame's sleep time and deadline miss are
+/// reported through vk2dRendererGetFrameStats so the target can be tuned against them.
+void vk2dRendererSetTargetFrameTime(double milliseconds);
+
+/// \brief Gets CPU-side statistics of the most recently completed frame
+/// \return Returns a VK2DFrameStats of the frame that just ended
+///
+/// The counters are cheap enough to stay on permanently: draw calls recorded, instanced
+/// draws and total instances, pipeline binds taken versus avoided by redundant-bind
+/// elision, bytes pushed through the frame's descriptor buffer, and how many pages that
+/// buffer has grown to. Draws recorded through parallel recording slots are not counted
+/// since the counters are not synchronized between threads.
+VK2DFrameStats vk2dRendererGetFrameStats();
+
+/// \brief Gets GPU timings of the most recently retired frame
+/// \return Returns a VK2DGpuProfile, all zeroes if the device can't write timestamps
+///
+/// The renderer writes a GPU timestamp at the start and end of every frame and one each
+/// time the bound pipeline changes, so the returned profile breaks the frame's GPU time
+/// down by pipeline - this tells you whether a slow frame is GPU-fill-bound (and in
+/// which pipeline) or CPU-bound when compared against vk2dRendererGetAverageFrameTime.
+/// Results lag VK2D_MAX_FRAMES_IN_FLIGHT frames behind since a frame's timestamps can
+/// only be read once it has fully retired, and frames with more than
+/// VK2D_MAX_GPU_TIMESTAMPS pipeline switches stop attributing after the cap.
+VK2DGpuProfile vk2dRendererGetGpuProfile();
+
 /// \brief Sets the current camera settings
 /// \param camera Camera settings to use
 ///
@@ -141,6 +311,25 @@ void vk2dRendererEmpty();
 /// \return Returns a struct containing all limit information
 VK2DRendererLimits vk2dRendererGetLimits();
 
+/// \brief Gets a snapshot of the renderer's video memory usage
+/// \return Returns a VK2DMemoryStats, all zeroes if the renderer isn't initialized
+///
+/// Allocation and block totals come from walking the allocator's internal state, which
+/// is not free - call this for debug overlays or periodic checks, not every draw. Heap
+/// usage and budgets are the driver's estimates and include memory this process didn't
+/// allocate, so they are the numbers to watch for VRAM exhaustion.
+VK2DMemoryStats vk2dRendererGetMemoryStats();
+
+/// \brief Sets a callback invoked when a memory heap goes over its reported budget
+/// \param callback Function to call, or NULL to disable the check
+/// \param context Arbitrary pointer handed back to the callback
+///
+/// The check runs once at the start of each frame and costs nothing beyond reading the
+/// driver's cached budget numbers. The callback fires once per over-budget heap per
+/// frame and is the place for a streaming system to evict textures before allocations
+/// start failing - resources freed inside it ride the usual deferred-free queue.
+void vk2dRendererSetMemoryBudgetCallback(VK2DMemoryBudgetCallback callback, void *context);
+
 /// \brief Draws a rectangle using the current rendering colour
 /// \param x X position to draw the rectangle
 /// \param y Y position to draw the rectangle
@@ -206,15 +395,56 @@ void vk2dRendererDrawTexture(VK2DTexture tex, float x, float y, float xscale, fl
 /// \param tex Texture to draw
 /// \param instances Array of `VK2DDrawInstance`s that will be used as what would be parameters to vk2dRendererDrawTexture (the data is copied)
 /// \param count Number of elements in the instances array
-/// \warning If `count` is greater than the `maxInstancedDraws` field of vk2dRendererGetLimits, `count` will instead be taken as `maxInstancedDraws`
 ///
 /// This function is intended to be used to draw a large amount of a single texture at once with
 /// less overhead than there would be by calling vk2dRendererDrawTexture `count` number of times.
+/// Any `count` works: arrays bigger than the `maxInstancedDraws` field of vk2dRendererGetLimits
+/// are split across descriptor-buffer pages internally and recorded as back-to-back draws.
 /// Use the `VK2DInstance*` function to control things like rotation/scaling but rotation and
 /// scaling are more computationally expensive so its best to avoid it when possible especially
 /// when processing thousands of instances.
 void vk2dRendererDrawInstanced(VK2DTexture tex, VK2DDrawInstance *instances, uint32_t count);
 
+/// \brief Draws a texture many times over using the compact instance format
+/// \param tex Texture to draw
+/// \param instances Array of `VK2DDrawInstanceCompact`s, one per instance (the data is copied)
+/// \param count Number of elements in the instances array
+///
+/// Same as vk2dRendererDrawInstanced except the instances are described by the much smaller
+/// VK2DDrawInstanceCompact, which stores raw transform parameters instead of a model matrix.
+/// This roughly halves the memory a large instance array occupies on the CPU side; the
+/// renderer expands the instances into an internal scratch list when the draw is recorded.
+void vk2dRendererDrawInstancedCompact(VK2DTexture tex, VK2DDrawInstanceCompact *instances, uint32_t count);
+
+/// \brief Draws instances whose data and draw parameters both live in device buffers
+/// \param tex Texture the instances draw with
+/// \param instances Buffer of VK2DDrawInstance structs, made with vk2dBufferCreateStorage
+/// \param commands Buffer of VK2DDrawCommand structs describing what to draw
+/// \param commandIndex Index of the first command in the buffer to execute
+/// \param drawCount Number of consecutive commands to execute
+///
+/// Unlike vk2dRendererDrawInstanced nothing is uploaded or re-recorded per frame -
+/// bake a static layer's instances and commands into buffers once and this records a
+/// single indirect draw from then on. The commands may also be written by a compute
+/// shader, which is how vk2dRendererDrawParticles works under the hood.
+void vk2dRendererDrawInstancedIndirect(VK2DTexture tex, VK2DBuffer instances, VK2DBuffer commands, uint32_t commandIndex, uint32_t drawCount);
+
+/// \brief Replays every draw recorded into a draw list with a single indirect draw
+/// \param list Draw list to replay, see vk2dDrawListCreate
+///
+/// Re-bakes the list first if it changed since the last bake (which blocks on a GPU
+/// transfer, so record static layers up front).
+void vk2dRendererDrawList(VK2DDrawList list);
+
+/// \brief Draws every live particle of a particle system through the instancing pipeline
+/// \param system Particle system to draw, created with vk2dParticleSystemCreate
+/// \param tex Texture the particles draw with
+///
+/// The particle instances and the draw's parameters both live on the GPU, so this
+/// records a single indirect draw no matter how many particles are alive. If an
+/// update dispatch is still in flight it is waited out first.
+void vk2dRendererDrawParticles(VK2DParticleSystem system, VK2DTexture tex);
+
 /// \brief Renders a texture
 /// \param shader Shader to draw with
 /// \param data Uniform buffer data the shader expects; should be the size specified when the shader was created or NULL if a size of 0 was given
@@ -273,6 +503,19 @@ void
 vk2dRendererDrawModel(VK2DModel model, float x, float y, float z, float xscale, float yscale, float zscale, float rot,
 					  vec3 axis, float originX, float originY, float originZ);
 
+/// \brief Renders many copies of the same 3D model in one pass
+/// \param model Model to render
+/// \param transforms Array of model matrices, one per instance (build them with the Math.h helpers)
+/// \param count Number of instances in the transforms array
+/// \warning This function will only render to 3D-enabled cameras (which you must set up yourself) and if there are
+/// none available this function will simply do nothing.
+///
+/// Use this for fields of identical props (grass, coins, debris) - pipeline, descriptor
+/// sets, vertex/index buffers and viewport bind once per camera and each instance only
+/// costs its push constants and a draw, instead of the full state record per model that
+/// vk2dRendererDrawModel pays. Every instance shares the renderer's current colour mod.
+void vk2dRendererDrawModelInstanced(VK2DModel model, mat4 *transforms, uint32_t count);
+
 /// \brief Renders a 3D model as a wireframe
 /// \param model Model to render
 /// \param x x position to draw at
@@ -353,6 +596,28 @@ void
 vk2dInstanceUpdate(VK2DDrawInstance *instance, float x, float y, float xScale, float yScale, float rot, float xOrigin,
 				   float yOrigin);
 
+/// \brief Sets up many instances that share a transform in one pass
+/// \param instances Array of instances to set up
+/// \param count Number of instances in the array
+/// \param positions Array of count positions, one per instance
+/// \param xScale X scale applied to every instance
+/// \param yScale Y scale applied to every instance
+/// \param rot Rotation applied to every instance
+/// \param xOrigin X origin of every instance
+/// \param yOrigin Y origin of every instance
+/// \param xInTex X position in the texture to begin rendering from
+/// \param yInTex Y position in the texture to begin rendering from
+/// \param wInTex Width of the texture to draw
+/// \param hInTex Height of the texture to draw
+/// \param colour Colour mod for every instance
+///
+/// This is much faster than calling vk2dInstanceSet in a loop because the model
+/// matrix is only constructed once and stamped across the whole array, which is
+/// the bulk of the per-instance CPU cost for large batches.
+void vk2dInstanceSetBatch(VK2DDrawInstance *instances, uint32_t count, const vec2 *positions, float xScale,
+						  float yScale, float rot, float xOrigin, float yOrigin, float xInTex, float yInTex,
+						  float wInTex, float hInTex, vec4 colour);
+
 /// \brief Returns a random number between min and max, thread safe
 /// \param min Minimum value that can be returned
 /// \param max Maximum value that can be returns
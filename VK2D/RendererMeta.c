@@ -2,6 +2,7 @@
 /// \author Paolo Mazzon
 #include <vulkan/vulkan.h>
 #include <SDL2/SDL_vulkan.h>
+#include <stdio.h>
 
 #include "VK2D/RendererMeta.h"
 #include "VK2D/Renderer.h"
@@ -104,6 +105,203 @@ void _vk2dRendererResetBoundPointers() {
 	gRenderer->prevVBO = VK_NULL_HANDLE;
 }
 
+bool _vk2dRendererDeferFree(void (*freeFunc)(void*), void *resource) {
+	VK2DRenderer gRenderer = vk2dRendererGetPointer();
+	if (gRenderer == NULL)
+		return false;
+	const uint32_t frame = gRenderer->currentFrame;
+
+	// Potentially grow the list for this frame slot
+	if (gRenderer->deferredFreeCounts[frame] == gRenderer->deferredFreeListSizes[frame]) {
+		gRenderer->deferredFrees[frame] = realloc(gRenderer->deferredFrees[frame], sizeof(VK2DDeferredFree) * (gRenderer->deferredFreeListSizes[frame] + VK2D_DEFAULT_ARRAY_EXTENSION));
+		vk2dPointerCheck(gRenderer->deferredFrees[frame]);
+		gRenderer->deferredFreeListSizes[frame] += VK2D_DEFAULT_ARRAY_EXTENSION;
+	}
+
+	gRenderer->deferredFrees[frame][gRenderer->deferredFreeCounts[frame]].freeFunc = freeFunc;
+	gRenderer->deferredFrees[frame][gRenderer->deferredFreeCounts[frame]].resource = resource;
+	gRenderer->deferredFreeCounts[frame] += 1;
+	return true;
+}
+
+void _vk2dRendererProcessDeferredFrees(uint32_t frame) {
+	VK2DRenderer gRenderer = vk2dRendererGetPointer();
+	for (uint32_t i = 0; i < gRenderer->deferredFreeCounts[frame]; i++)
+		gRenderer->deferredFrees[frame][i].freeFunc(gRenderer->deferredFrees[frame][i].resource);
+	gRenderer->deferredFreeCounts[frame] = 0;
+}
+
+void *vk2dFrameAlloc(uint32_t size) {
+	VK2DRenderer gRenderer = vk2dRendererGetPointer();
+
+	// Every allocation is 16-byte aligned so instance data can go straight into the arena
+	size = (size + 15) & ~(uint32_t)15;
+
+	if (gRenderer->frameArenaOffset + size <= gRenderer->frameArenaSize) {
+		void *out = &gRenderer->frameArena[gRenderer->frameArenaOffset];
+		gRenderer->frameArenaOffset += size;
+		return out;
+	}
+
+	// The arena is full, hand out a plain heap block and let the reset grow the arena to fit
+	if (gRenderer->frameArenaOverflowCount == gRenderer->frameArenaOverflowSize) {
+		void **newList = realloc(gRenderer->frameArenaOverflow, sizeof(void*) * (gRenderer->frameArenaOverflowSize + VK2D_DEFAULT_ARRAY_EXTENSION));
+		if (!vk2dPointerCheck(newList))
+			return NULL;
+		gRenderer->frameArenaOverflow = newList;
+		gRenderer->frameArenaOverflowSize += VK2D_DEFAULT_ARRAY_EXTENSION;
+	}
+	void *block = malloc(size);
+	if (!vk2dPointerCheck(block))
+		return NULL;
+	gRenderer->frameArenaOverflow[gRenderer->frameArenaOverflowCount++] = block;
+	gRenderer->frameArenaOverflowBytes += size;
+	return block;
+}
+
+void _vk2dRendererResetFrameArena() {
+	VK2DRenderer gRenderer = vk2dRendererGetPointer();
+
+	// Anything that spilled to the heap means the arena was too small, so it grows to cover
+	// the whole previous frame - safe to move the backing memory here since every pointer
+	// handed out last frame is dead by now
+	if (gRenderer->frameArenaOverflowBytes > 0) {
+		uint8_t *newArena = realloc(gRenderer->frameArena, gRenderer->frameArenaSize + gRenderer->frameArenaOverflowBytes);
+		if (vk2dPointerCheck(newArena)) {
+			gRenderer->frameArena = newArena;
+			gRenderer->frameArenaSize += gRenderer->frameArenaOverflowBytes;
+		}
+		for (uint32_t i = 0; i < gRenderer->frameArenaOverflowCount; i++)
+			free(gRenderer->frameArenaOverflow[i]);
+		gRenderer->frameArenaOverflowCount = 0;
+		gRenderer->frameArenaOverflowBytes = 0;
+	}
+	gRenderer->frameArenaOffset = 0;
+}
+
+VkCommandBuffer _vk2dRendererGetRecordingBuffer(bool *secondary) {
+	VK2DRenderer gRenderer = vk2dRendererGetPointer();
+	if (gRenderer->threadSlotCount > 0) {
+		VK2DThreadSlot *slot = SDL_TLSGet(gRenderer->threadSlotTLS);
+		if (slot != NULL && slot->active) {
+			*secondary = true;
+			return slot->buffer;
+		}
+	}
+	*secondary = false;
+	return gRenderer->commandBuffer[gRenderer->scImageIndex];
+}
+
+bool _vk2dRendererThreadOnSecondary() {
+	VK2DRenderer gRenderer = vk2dRendererGetPointer();
+	if (gRenderer->threadSlotCount == 0)
+		return false;
+	VK2DThreadSlot *slot = SDL_TLSGet(gRenderer->threadSlotTLS);
+	return slot != NULL && slot->active;
+}
+
+void _vk2dRendererExecuteParallelWork() {
+	VK2DRenderer gRenderer = vk2dRendererGetPointer();
+	uint32_t executeCount = 0;
+	for (uint32_t i = 0; i < gRenderer->threadSlotCount; i++)
+		if (gRenderer->threadSlots[i].active)
+			executeCount++;
+	if (executeCount == 0)
+		return;
+
+	// End every active recording and gather the buffers
+	VkCommandBuffer *buffers = vk2dFrameAlloc(sizeof(VkCommandBuffer) * executeCount);
+	if (!vk2dPointerCheck(buffers))
+		return;
+	executeCount = 0;
+	for (uint32_t i = 0; i < gRenderer->threadSlotCount; i++) {
+		if (gRenderer->threadSlots[i].active) {
+			vk2dErrorCheck(vkEndCommandBuffer(gRenderer->threadSlots[i].buffer));
+			buffers[executeCount++] = gRenderer->threadSlots[i].buffer;
+			gRenderer->threadSlots[i].active = false;
+		}
+	}
+
+	// Secondary buffers can't execute inside an inline render pass, so the current pass
+	// is swapped out for a new instance of the load-op pass for the same target around
+	// the execute, just like vk2dRendererSetTarget does mid-frame
+	VkCommandBuffer primary = gRenderer->commandBuffer[gRenderer->scImageIndex];
+	VkRenderPass pass = gRenderer->target == VK2D_TARGET_SCREEN ? gRenderer->midFrameSwapRenderPass
+																: gRenderer->externalTargetRenderPass;
+	VkRect2D rect = {0};
+	rect.extent.width = gRenderer->target == VK2D_TARGET_SCREEN ? gRenderer->surfaceWidth : gRenderer->target->img->width;
+	rect.extent.height = gRenderer->target == VK2D_TARGET_SCREEN ? gRenderer->surfaceHeight : gRenderer->target->img->height;
+	VkClearValue clear[2] = {0};
+	clear[1].depthStencil.depth = 1;
+	VkRenderPassBeginInfo renderPassBeginInfo = vk2dInitRenderPassBeginInfo(
+			pass,
+			gRenderer->targetFrameBuffer,
+			rect,
+			clear,
+			2);
+
+	vkCmdEndRenderPass(primary);
+	vkCmdBeginRenderPass(primary, &renderPassBeginInfo, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+	vkCmdExecuteCommands(primary, executeCount, buffers);
+	vkCmdEndRenderPass(primary);
+	vkCmdBeginRenderPass(primary, &renderPassBeginInfo, VK_SUBPASS_CONTENTS_INLINE);
+	_vk2dRendererResetBoundPointers();
+}
+
+void _vk2dRendererRecordTimestamp(VkCommandBuffer buf, int pipelineTime) {
+	VK2DRenderer gRenderer = vk2dRendererGetPointer();
+	const uint32_t frame = gRenderer->currentFrame;
+	if (!gRenderer->gpuProfileSupported || gRenderer->gpuTimestampCounts[frame] >= VK2D_MAX_GPU_TIMESTAMPS)
+		return;
+	const uint32_t query = (frame * VK2D_MAX_GPU_TIMESTAMPS) + gRenderer->gpuTimestampCounts[frame];
+	vkCmdWriteTimestamp(buf, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, gRenderer->gpuProfileQueryPool, query);
+	gRenderer->gpuTimestampPipes[frame][gRenderer->gpuTimestampCounts[frame]] = (uint8_t)pipelineTime;
+	gRenderer->gpuTimestampCounts[frame] += 1;
+}
+
+void _vk2dRendererResolveGpuProfile(uint32_t frame) {
+	VK2DRenderer gRenderer = vk2dRendererGetPointer();
+	const uint32_t count = gRenderer->gpuTimestampCounts[frame];
+	memset(&gRenderer->gpuProfile, 0, sizeof(VK2DGpuProfile));
+
+	if (gRenderer->gpuProfileSupported && count >= 2) {
+		uint64_t results[VK2D_MAX_GPU_TIMESTAMPS];
+		VkResult result = vkGetQueryPoolResults(
+				gRenderer->ld->dev,
+				gRenderer->gpuProfileQueryPool,
+				frame * VK2D_MAX_GPU_TIMESTAMPS,
+				count,
+				sizeof(uint64_t) * count,
+				results,
+				sizeof(uint64_t),
+				VK_QUERY_RESULT_64_BIT);
+
+		// The time between two timestamps belongs to whatever pipeline the first one was tagged with
+		if (result == VK_SUCCESS) {
+			const double msPerTick = (double)gRenderer->timestampPeriod / 1000000.0;
+			gRenderer->gpuProfile.frameTimeMS = (double)(results[count - 1] - results[0]) * msPerTick;
+			for (uint32_t i = 0; i < count - 1; i++)
+				gRenderer->gpuProfile.pipelineTimeMS[gRenderer->gpuTimestampPipes[frame][i]] += (double)(results[i + 1] - results[i]) * msPerTick;
+		}
+	}
+
+	gRenderer->gpuTimestampCounts[frame] = 0;
+}
+
+// Returns which VK2DPipelineTime category a pipeline's GPU time is attributed to
+static int _vk2dPipelineTimeCategory(VK2DPipeline pipe) {
+	VK2DRenderer gRenderer = vk2dRendererGetPointer();
+	if (pipe == gRenderer->texPipe)
+		return VK2D_PIPELINE_TIME_TEXTURE;
+	if (pipe == gRenderer->instancedPipe)
+		return VK2D_PIPELINE_TIME_INSTANCED;
+	if (pipe == gRenderer->primFillPipe || pipe == gRenderer->primLinePipe)
+		return VK2D_PIPELINE_TIME_PRIMITIVE;
+	if (pipe == gRenderer->modelPipe || pipe == gRenderer->wireframePipe)
+		return VK2D_PIPELINE_TIME_MODEL;
+	return VK2D_PIPELINE_TIME_SHADER;
+}
+
 // This is called when a render-target texture is created to make the renderer aware of it
 void _vk2dRendererAddTarget(VK2DTexture tex) {
 	VK2DRenderer gRenderer = vk2dRendererGetPointer();
@@ -143,40 +341,125 @@ void _vk2dRendererRemoveTarget(VK2DTexture tex) {
 			gRenderer->targets[i] = NULL;
 }
 
+// Gives a texture a slot in the bindless array and writes its image into it
+void _vk2dRendererAddTextureToArray(VK2DTexture tex) {
+	VK2DRenderer gRenderer = vk2dRendererGetPointer();
+	tex->arrayIndex = UINT32_MAX;
+	if (gRenderer->texArraySet == VK_NULL_HANDLE)
+		return;
+
+	SDL_LockMutex(gRenderer->texArrayMutex);
+	uint32_t found = UINT32_MAX;
+	for (uint32_t i = 0; i < gRenderer->texArraySlotCount && found == UINT32_MAX; i++)
+		if (gRenderer->texArrayTextures[i] == NULL)
+			found = i;
+
+	if (found != UINT32_MAX) {
+		gRenderer->texArrayTextures[found] = tex;
+
+		// The set has update-after-bind semantics so the write is safe while frames are in flight
+		VkDescriptorImageInfo imageInfo = {VK_NULL_HANDLE, tex->img->view, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL};
+		VkWriteDescriptorSet write = {VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET};
+		write.descriptorCount = 1;
+		write.descriptorType = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+		write.pImageInfo = &imageInfo;
+		write.dstSet = gRenderer->texArraySet;
+		write.dstArrayElement = found;
+		vkUpdateDescriptorSets(gRenderer->ld->dev, 1, &write, 0, VK_NULL_HANDLE);
+		tex->arrayIndex = found;
+	} else {
+		vk2dLogMessage("Bindless texture array is full, texture will not get a slot.");
+	}
+	SDL_UnlockMutex(gRenderer->texArrayMutex);
+}
+
+// Called on texture free, the stale descriptor stays behind but the slot can be rewritten
+void _vk2dRendererRemoveTextureFromArray(VK2DTexture tex) {
+	VK2DRenderer gRenderer = vk2dRendererGetPointer();
+	if (gRenderer->texArraySet != VK_NULL_HANDLE && tex->arrayIndex != UINT32_MAX) {
+		SDL_LockMutex(gRenderer->texArrayMutex);
+		gRenderer->texArrayTextures[tex->arrayIndex] = NULL;
+		SDL_UnlockMutex(gRenderer->texArrayMutex);
+		tex->arrayIndex = UINT32_MAX;
+	}
+}
+
+// Re-points a texture's bindless slot at its current image, used when streaming swaps images
+// in and out - the index stays put so user shaders holding it keep working across the swap
+void _vk2dRendererUpdateTextureArraySlot(VK2DTexture tex) {
+	VK2DRenderer gRenderer = vk2dRendererGetPointer();
+	if (gRenderer->texArraySet != VK_NULL_HANDLE && tex->arrayIndex != UINT32_MAX) {
+		SDL_LockMutex(gRenderer->texArrayMutex);
+		VkDescriptorImageInfo imageInfo = {VK_NULL_HANDLE, tex->img->view, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL};
+		VkWriteDescriptorSet write = {VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET};
+		write.descriptorCount = 1;
+		write.descriptorType = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+		write.pImageInfo = &imageInfo;
+		write.dstSet = gRenderer->texArraySet;
+		write.dstArrayElement = tex->arrayIndex;
+		vkUpdateDescriptorSets(gRenderer->ld->dev, 1, &write, 0, VK_NULL_HANDLE);
+		SDL_UnlockMutex(gRenderer->texArrayMutex);
+	}
+}
+
 // This is used when changing the render target to make sure the texture is either ready to be drawn itself or rendered to
-void _vk2dTransitionImageLayout(VkImage img, VkImageLayout old, VkImageLayout new) {
+void _vk2dTransitionImageLayouts(VkImage *imgs, VkImageLayout *old, VkImageLayout *new, uint32_t count) {
 	VK2DRenderer gRenderer = vk2dRendererGetPointer();
 	VkPipelineStageFlags sourceStage = 0;
 	VkPipelineStageFlags destinationStage = 0;
-
-	VkImageMemoryBarrier barrier = {0};
-	barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-	barrier.oldLayout = old;
-	barrier.newLayout = new;
-	barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-	barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-	barrier.image = img;
-	barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-	barrier.subresourceRange.baseMipLevel = 0;
-	barrier.subresourceRange.levelCount = 1;
-	barrier.subresourceRange.baseArrayLayer = 0;
-	barrier.subresourceRange.layerCount = 1;
-
-	if (old == VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL && new == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL) {
-		barrier.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
-		barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
-
-		sourceStage = VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-		destinationStage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
-	} else if (new == VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL && old == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL) {
-		barrier.srcAccessMask = VK_ACCESS_SHADER_READ_BIT;
-		barrier.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
-
-		sourceStage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
-		destinationStage = VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-	} else {
-		vk2dLogMessage("!!!Unsupported image transition!!!");
-		vk2dErrorCheck(-1);
+	VkImageMemoryBarrier *barriers = vk2dFrameAlloc(sizeof(VkImageMemoryBarrier) * count);
+	if (!vk2dPointerCheck(barriers))
+		return;
+
+	for (uint32_t i = 0; i < count; i++) {
+		VkImageMemoryBarrier *barrier = &barriers[i];
+		memset(barrier, 0, sizeof(VkImageMemoryBarrier));
+		barrier->sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+		barrier->oldLayout = old[i];
+		barrier->newLayout = new[i];
+		barrier->dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		barrier->srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		barrier->image = imgs[i];
+		barrier->subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+		barrier->subresourceRange.baseMipLevel = 0;
+		barrier->subresourceRange.levelCount = 1;
+		barrier->subresourceRange.baseArrayLayer = 0;
+		barrier->subresourceRange.layerCount = 1;
+
+		if (old[i] == VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL && new[i] == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL) {
+			barrier->srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+			barrier->dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+
+			sourceStage |= VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+			destinationStage |= VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+		} else if (new[i] == VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL && old[i] == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL) {
+			barrier->srcAccessMask = VK_ACCESS_SHADER_READ_BIT;
+			barrier->dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+
+			sourceStage |= VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+			destinationStage |= VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+		} else if (new[i] == VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL) {
+			// Readback copies pull from shader-read targets or the just-presented screen image
+			barrier->srcAccessMask = old[i] == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL ? VK_ACCESS_SHADER_READ_BIT
+																						: VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+			barrier->dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+
+			sourceStage |= old[i] == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL ? VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT
+																			  : VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+			destinationStage |= VK_PIPELINE_STAGE_TRANSFER_BIT;
+		} else if (old[i] == VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL) {
+			barrier->srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+			barrier->dstAccessMask = new[i] == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL ? VK_ACCESS_SHADER_READ_BIT
+					: new[i] == VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL ? VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT : 0;
+
+			sourceStage |= VK_PIPELINE_STAGE_TRANSFER_BIT;
+			destinationStage |= new[i] == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL ? VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT
+					: new[i] == VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL ? VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT
+					: VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
+		} else {
+			vk2dLogMessage("!!!Unsupported image transition!!!");
+			vk2dErrorCheck(-1);
+		}
 	}
 
 	vkCmdPipelineBarrier(
@@ -185,10 +468,14 @@ void _vk2dTransitionImageLayout(VkImage img, VkImageLayout old, VkImageLayout ne
 			0,
 			0, VK_NULL_HANDLE,
 			0, VK_NULL_HANDLE,
-			1, &barrier
+			count, barriers
 	);
 }
 
+void _vk2dTransitionImageLayout(VkImage img, VkImageLayout old, VkImageLayout new) {
+	_vk2dTransitionImageLayouts(&img, &old, &new, 1);
+}
+
 // Rebuilds the matrices for a given buffer and camera
 void _vk2dPrintMatrix(FILE* out, mat4 m, const char* prefix);
 void _vk2dCameraUpdateUBO(VK2DUniformBufferObject *ubo, VK2DCameraSpec *camera) {
@@ -227,19 +514,14 @@ void _vk2dCameraUpdateUBO(VK2DUniformBufferObject *ubo, VK2DCameraSpec *camera)
 }
 
 // Flushes the data from a ubo to its respective buffer, frame being the swapchain buffer to flush
-void _vk2dRendererFlushUBOBuffer(uint32_t frame, uint32_t descriptorFrame, int camera) {
+void _vk2dRendererFlushUBOBuffer(uint32_t frame, int camera) {
+	// The camera's descriptor set permanently points at this image's persistent UBO buffer,
+	// so flushing is just a copy into its mapping - it only happens when the camera is dirty
 	VK2DRenderer gRenderer = vk2dRendererGetPointer();
-	VkBuffer buffer;
-	VkDeviceSize offset;
-	vk2dDescriptorBufferCopyData(gRenderer->descriptorBuffers[descriptorFrame], &gRenderer->cameras[camera].ubos[frame], sizeof(VK2DUniformBufferObject), &buffer, &offset);
-	VkDescriptorBufferInfo bufferInfo = {buffer, offset, sizeof(VK2DUniformBufferObject)};
-	VkWriteDescriptorSet write = {0};
-	write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-	write.descriptorCount = 1;
-	write.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-	write.pBufferInfo = &bufferInfo;
-	write.dstSet = gRenderer->cameras[camera].uboSets[frame];
-	vkUpdateDescriptorSets(gRenderer->ld->dev, 1, &write, 0, VK_NULL_HANDLE);
+	void *location;
+	vk2dErrorCheck(vmaMapMemory(gRenderer->vma, gRenderer->cameras[camera].uboBuffers[frame]->mem, &location));
+	memcpy(location, &gRenderer->cameras[camera].ubos[frame], sizeof(VK2DUniformBufferObject));
+	vmaUnmapMemory(gRenderer->vma, gRenderer->cameras[camera].uboBuffers[frame]->mem);
 }
 
 void _vk2dRendererCreateDebug() {
@@ -336,6 +618,11 @@ void _vk2dRendererCreateSwapchain() {
 			VK_NULL_HANDLE,
 			gRenderer->surfaceCapabilities.minImageCount + (gRenderer->config.screenMode == VK2D_SCREEN_MODE_TRIPLE_BUFFER ? 1 : 0)
 	);
+	// Screen readbacks copy straight out of the swapchain, nearly every surface allows it
+	gRenderer->swapchainTransferSrc = (gRenderer->surfaceCapabilities.supportedUsageFlags & VK_IMAGE_USAGE_TRANSFER_SRC_BIT) != 0;
+	if (gRenderer->swapchainTransferSrc)
+		swapchainCreateInfoKHR.imageUsage |= VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+
 	VkBool32 supported;
 	vkGetPhysicalDeviceSurfaceSupportKHR(gRenderer->pd->dev, gRenderer->pd->QueueFamily.graphicsFamily, gRenderer->surface, &supported);
 	if (vk2dErrorInline(supported != VK_TRUE ? -1 : VK_SUCCESS))
@@ -367,6 +654,55 @@ void _vk2dRendererDestroySwapchain() {
 	free(gRenderer->swapchainImages);
 }
 
+void _vk2dRendererCreateHeadlessImages() {
+	VK2DRenderer gRenderer = vk2dRendererGetPointer();
+	uint32_t i;
+
+	// Without a surface the format can't be queried, but the swapchain path assumes this format anyway
+	gRenderer->surfaceFormat.format = VK_FORMAT_B8G8R8A8_SRGB;
+	gRenderer->surfaceFormat.colorSpace = VK_COLOR_SPACE_SRGB_NONLINEAR_KHR;
+	gRenderer->presentModes = NULL;
+	gRenderer->presentModeCount = 0;
+	gRenderer->limits.supportsImmediate = false;
+	gRenderer->limits.supportsTripleBuffering = false;
+
+	// One offscreen image per frame in flight stands in for the swapchain so the rest of
+	// the renderer (framebuffers, render passes, targets) doesn't need to know the difference
+	gRenderer->swapchainImageCount = gRenderer->framesInFlight;
+	gRenderer->headlessImages = malloc(gRenderer->swapchainImageCount * sizeof(VK2DImage));
+	gRenderer->swapchainImages = malloc(gRenderer->swapchainImageCount * sizeof(VkImage));
+	gRenderer->swapchainImageViews = malloc(gRenderer->swapchainImageCount * sizeof(VkImageView));
+	if (vk2dPointerCheck(gRenderer->headlessImages) && vk2dPointerCheck(gRenderer->swapchainImages) && vk2dPointerCheck(gRenderer->swapchainImageViews)) {
+		for (i = 0; i < gRenderer->swapchainImageCount; i++) {
+			gRenderer->headlessImages[i] = vk2dImageCreate(
+					gRenderer->ld,
+					gRenderer->surfaceWidth,
+					gRenderer->surfaceHeight,
+					gRenderer->surfaceFormat.format,
+					VK_IMAGE_ASPECT_COLOR_BIT,
+					VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+					VK_SAMPLE_COUNT_1_BIT);
+			gRenderer->swapchainImages[i] = gRenderer->headlessImages[i]->img;
+			gRenderer->swapchainImageViews[i] = gRenderer->headlessImages[i]->view;
+		}
+	}
+
+	// Headless images are created with transfer-src usage, so screen readbacks always work
+	gRenderer->swapchainTransferSrc = true;
+
+	vk2dLogMessage("Headless targets (%i images) initialized...", gRenderer->swapchainImageCount);
+}
+
+void _vk2dRendererDestroyHeadlessImages() {
+	VK2DRenderer gRenderer = vk2dRendererGetPointer();
+	uint32_t i;
+	for (i = 0; i < gRenderer->swapchainImageCount; i++)
+		vk2dImageFree(gRenderer->headlessImages[i]);
+	free(gRenderer->headlessImages);
+	free(gRenderer->swapchainImageViews);
+	free(gRenderer->swapchainImages);
+}
+
 void _vk2dRendererCreateDepthBuffer() {
 	VK2DRenderer gRenderer = vk2dRendererGetPointer();
 
@@ -424,10 +760,10 @@ void _vk2dRendererDestroyColourResources() {
 
 void _vk2dRendererCreateDescriptorBuffers() {
 	VK2DRenderer gRenderer = vk2dRendererGetPointer();
-	gRenderer->descriptorBuffers = malloc(sizeof(VK2DDescriptorBuffer) * VK2D_MAX_FRAMES_IN_FLIGHT);
+	gRenderer->descriptorBuffers = malloc(sizeof(VK2DDescriptorBuffer) * gRenderer->framesInFlight);
 
 	vk2dPointerCheck(gRenderer->descriptorBuffers);
-	for (int i = 0; i < VK2D_MAX_FRAMES_IN_FLIGHT; i++) {
+	for (int i = 0; i < gRenderer->framesInFlight; i++) {
 		gRenderer->descriptorBuffers[i] = vk2dDescriptorBufferCreate();
 	}
 
@@ -440,11 +776,67 @@ void _vk2dRendererCreateDescriptorBuffers() {
 
 void _vk2dRendererDestroyDescriptorBuffers() {
 	VK2DRenderer gRenderer = vk2dRendererGetPointer();
-	for (int i = 0; i < VK2D_MAX_FRAMES_IN_FLIGHT; i++)
+	for (int i = 0; i < gRenderer->framesInFlight; i++)
 		vk2dDescriptorBufferFree(gRenderer->descriptorBuffers[i]);
 	free(gRenderer->descriptorBuffers);
 }
 
+void _vk2dRendererCreateTextureArray() {
+	VK2DRenderer gRenderer = vk2dRendererGetPointer();
+	if (!gRenderer->limits.supportsTextureArray) {
+		vk2dLogMessage("Bindless texture array not supported...");
+		return;
+	}
+
+	uint32_t slots = VK2D_MAX_BOUND_TEXTURES;
+	if (gRenderer->pd->props.limits.maxPerStageDescriptorSampledImages < slots)
+		slots = gRenderer->pd->props.limits.maxPerStageDescriptorSampledImages;
+
+	// The layout is one big partially-bound sampled image array that can be written while bound
+	VkDescriptorBindingFlagsEXT bindingFlags = VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT_EXT | VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT_EXT;
+	VkDescriptorSetLayoutBindingFlagsCreateInfoEXT bindingFlagsCreateInfo = {VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO_EXT};
+	bindingFlagsCreateInfo.bindingCount = 1;
+	bindingFlagsCreateInfo.pBindingFlags = &bindingFlags;
+	VkDescriptorSetLayoutBinding descriptorSetLayoutBinding = vk2dInitDescriptorSetLayoutBinding(0, VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, slots, VK_SHADER_STAGE_FRAGMENT_BIT, VK_NULL_HANDLE);
+	VkDescriptorSetLayoutCreateInfo descriptorSetLayoutCreateInfo = vk2dInitDescriptorSetLayoutCreateInfo(&descriptorSetLayoutBinding, 1);
+	descriptorSetLayoutCreateInfo.pNext = &bindingFlagsCreateInfo;
+	descriptorSetLayoutCreateInfo.flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT_EXT;
+	vk2dErrorCheck(vkCreateDescriptorSetLayout(gRenderer->ld->dev, &descriptorSetLayoutCreateInfo, VK_NULL_HANDLE, &gRenderer->dslTextureArray));
+
+	// One pool holding the single set that lives for the whole renderer
+	VkDescriptorPoolSize poolSize = {VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, slots};
+	VkDescriptorPoolCreateInfo poolCreateInfo = {VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO};
+	poolCreateInfo.flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT_EXT;
+	poolCreateInfo.maxSets = 1;
+	poolCreateInfo.poolSizeCount = 1;
+	poolCreateInfo.pPoolSizes = &poolSize;
+	vk2dErrorCheck(vkCreateDescriptorPool(gRenderer->ld->dev, &poolCreateInfo, VK_NULL_HANDLE, &gRenderer->texArrayPool));
+
+	VkDescriptorSetAllocateInfo allocateInfo = {VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO};
+	allocateInfo.descriptorPool = gRenderer->texArrayPool;
+	allocateInfo.descriptorSetCount = 1;
+	allocateInfo.pSetLayouts = &gRenderer->dslTextureArray;
+	vk2dErrorCheck(vkAllocateDescriptorSets(gRenderer->ld->dev, &allocateInfo, &gRenderer->texArraySet));
+
+	gRenderer->texArrayTextures = calloc(slots, sizeof(VK2DTexture));
+	vk2dPointerCheck(gRenderer->texArrayTextures);
+	gRenderer->texArraySlotCount = slots;
+	gRenderer->texArrayMutex = SDL_CreateMutex();
+	vk2dPointerCheck(gRenderer->texArrayMutex);
+
+	vk2dLogMessage("Bindless texture array (%i slots) initialized...", slots);
+}
+
+void _vk2dRendererDestroyTextureArray() {
+	VK2DRenderer gRenderer = vk2dRendererGetPointer();
+	if (gRenderer->texArraySet != VK_NULL_HANDLE) {
+		vkDestroyDescriptorPool(gRenderer->ld->dev, gRenderer->texArrayPool, VK_NULL_HANDLE);
+		vkDestroyDescriptorSetLayout(gRenderer->ld->dev, gRenderer->dslTextureArray, VK_NULL_HANDLE);
+		SDL_DestroyMutex(gRenderer->texArrayMutex);
+		free(gRenderer->texArrayTextures);
+	}
+}
+
 
 void _vk2dRendererCreateRenderPass() {
 	VK2DRenderer gRenderer = vk2dRendererGetPointer();
@@ -454,6 +846,8 @@ void _vk2dRendererCreateRenderPass() {
 	} else {
 		attachCount = 2; // colour, depth
 	}
+	// Headless images are never presented so they stay in colour attachment layout between frames
+	VkImageLayout presentedLayout = gRenderer->headless ? VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL : VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
 	VkAttachmentReference resolveAttachment;
 	VkAttachmentDescription attachments[attachCount];
 	memset(attachments, 0, sizeof(VkAttachmentDescription) * attachCount);
@@ -462,7 +856,7 @@ void _vk2dRendererCreateRenderPass() {
 	attachments[0].loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
 	attachments[0].storeOp = VK_ATTACHMENT_STORE_OP_STORE;
 	attachments[0].initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-	attachments[0].finalLayout = gRenderer->config.msaa > 1 ? VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL : VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+	attachments[0].finalLayout = gRenderer->config.msaa > 1 ? VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL : presentedLayout;
 	attachments[1].format = gRenderer->depthBufferFormat;
 	attachments[1].samples = (VkSampleCountFlagBits)gRenderer->config.msaa;
 	attachments[1].loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
@@ -479,7 +873,7 @@ void _vk2dRendererCreateRenderPass() {
 		attachments[2].stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
 		attachments[2].stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
 		attachments[2].initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-		attachments[2].finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+		attachments[2].finalLayout = presentedLayout;
 		resolveAttachment.attachment = 2;
 		resolveAttachment.layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
 	}
@@ -527,12 +921,12 @@ void _vk2dRendererCreateRenderPass() {
 		attachments[1].initialLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
 		attachments[1].finalLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
 		attachments[1].loadOp = VK_ATTACHMENT_LOAD_OP_LOAD;
-		attachments[2].initialLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
-		attachments[2].finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+		attachments[2].initialLayout = presentedLayout;
+		attachments[2].finalLayout = presentedLayout;
 		attachments[2].loadOp = VK_ATTACHMENT_LOAD_OP_LOAD;
 	} else {
-		attachments[0].initialLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
-		attachments[0].finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+		attachments[0].initialLayout = presentedLayout;
+		attachments[0].finalLayout = presentedLayout;
 		attachments[0].loadOp = VK_ATTACHMENT_LOAD_OP_LOAD;
 		attachments[1].initialLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
 		attachments[1].finalLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
@@ -611,9 +1005,98 @@ void _vk2dRendererDestroyDescriptorSetLayout() {
 	vkDestroyDescriptorSetLayout(gRenderer->ld->dev, gRenderer->dslTexture, VK_NULL_HANDLE);
 }
 
+void _vk2dRendererCreatePipelineCache() {
+	VK2DRenderer gRenderer = vk2dRendererGetPointer();
+	VkPipelineCacheCreateInfo pipelineCacheCreateInfo = {VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO};
+	void *initialData = NULL;
+	uint32_t initialDataSize = 0;
+
+	// Seed the cache from disk if the user asked for one and it exists
+	if (gRenderer->options.pipelineCacheFile != NULL && _vk2dFileExists(gRenderer->options.pipelineCacheFile)) {
+		initialData = _vk2dLoadFile(gRenderer->options.pipelineCacheFile, &initialDataSize);
+		pipelineCacheCreateInfo.pInitialData = initialData;
+		pipelineCacheCreateInfo.initialDataSize = initialDataSize;
+	}
+
+	VkResult result = vkCreatePipelineCache(gRenderer->ld->dev, &pipelineCacheCreateInfo, VK_NULL_HANDLE, &gRenderer->pipelineCache);
+	if (result != VK_SUCCESS && initialData != NULL) {
+		// Stale cache (likely a different gpu or driver version), just start fresh
+		pipelineCacheCreateInfo.pInitialData = NULL;
+		pipelineCacheCreateInfo.initialDataSize = 0;
+		result = vkCreatePipelineCache(gRenderer->ld->dev, &pipelineCacheCreateInfo, VK_NULL_HANDLE, &gRenderer->pipelineCache);
+	}
+	vk2dErrorCheck(result);
+	free(initialData);
+
+	if (initialDataSize > 0)
+		vk2dLogMessage("Pipeline cache seeded from \"%s\"...", gRenderer->options.pipelineCacheFile);
+	else
+		vk2dLogMessage("Pipeline cache initialized...");
+}
+
+void _vk2dRendererDestroyPipelineCache() {
+	VK2DRenderer gRenderer = vk2dRendererGetPointer();
+
+	// Serialize the cache back out so the next launch skips shader compilation
+	if (gRenderer->options.pipelineCacheFile != NULL) {
+		size_t size;
+		if (vkGetPipelineCacheData(gRenderer->ld->dev, gRenderer->pipelineCache, &size, NULL) == VK_SUCCESS && size > 0) {
+			void *data = malloc(size);
+			if (vk2dPointerCheck(data) && vkGetPipelineCacheData(gRenderer->ld->dev, gRenderer->pipelineCache, &size, data) == VK_SUCCESS) {
+				FILE *file = fopen(gRenderer->options.pipelineCacheFile, "wb");
+				if (file != NULL) {
+					fwrite(data, 1, size, file);
+					fclose(file);
+				} else {
+					vk2dLogMessage("Failed to write pipeline cache to \"%s\"", gRenderer->options.pipelineCacheFile);
+				}
+			}
+			free(data);
+		}
+	}
+
+	vkDestroyPipelineCache(gRenderer->ld->dev, gRenderer->pipelineCache, VK_NULL_HANDLE);
+}
+
 VkPipelineVertexInputStateCreateInfo _vk2dGetTextureVertexInputState();
 VkPipelineVertexInputStateCreateInfo _vk2dGetColourVertexInputState();
 void _vk2dShaderBuildPipe(VK2DShader shader);
+void _vk2dShaderJoinBuild(VK2DShader shader);
+// One base pipeline to hand to a worker thread during _vk2dRendererCreatePipelines
+typedef struct _VK2DPipelineJob {
+	VK2DPipeline *out;                                ///< Where the finished pipeline lands
+	unsigned char *vert;                              ///< Vertex shader SPIR-V
+	uint32_t vertSize;                                ///< Vertex shader size in bytes
+	unsigned char *frag;                              ///< Fragment shader SPIR-V
+	uint32_t fragSize;                                ///< Fragment shader size in bytes
+	VkDescriptorSetLayout *layouts;                   ///< Descriptor set layouts for the pipeline
+	uint32_t layoutCount;                             ///< Number of set layouts
+	VkPipelineVertexInputStateCreateInfo *vertexInfo; ///< Vertex input description
+	bool fill;                                        ///< Fill or line topology
+	VK2DPipelineType type;                            ///< What kind of pipeline this is
+} _VK2DPipelineJob;
+
+static int _vk2dPipelineJobThread(void *data) {
+	_VK2DPipelineJob *job = data;
+	VK2DRenderer gRenderer = vk2dRendererGetPointer();
+	*job->out = vk2dPipelineCreate(
+			gRenderer->ld,
+			gRenderer->renderPass,
+			gRenderer->surfaceWidth,
+			gRenderer->surfaceHeight,
+			job->vert,
+			job->vertSize,
+			job->frag,
+			job->fragSize,
+			job->layouts,
+			job->layoutCount,
+			job->vertexInfo,
+			job->fill,
+			gRenderer->config.msaa,
+			job->type);
+	return 0;
+}
+
 void _vk2dRendererCreatePipelines() {
 	VK2DRenderer gRenderer = vk2dRendererGetPointer();
 	uint32_t i;
@@ -684,106 +1167,34 @@ void _vk2dRendererCreatePipelines() {
 		}
 	}
 
-	// Texture pipeline
+	// The base pipelines are independent of each other, so each one builds on its own
+	// worker thread - vkCreateGraphicsPipelines is thread-safe and the pipeline cache
+	// synchronizes itself internally. This is most of cold-startup time on slow drivers.
 	VkDescriptorSetLayout layout[] = {gRenderer->dslBufferVP, gRenderer->dslSampler, gRenderer->dslTexture};
-	gRenderer->texPipe = vk2dPipelineCreate(
-			gRenderer->ld,
-			gRenderer->renderPass,
-			gRenderer->surfaceWidth,
-			gRenderer->surfaceHeight,
-			shaderTexVert,
-			shaderTexVertSize,
-			shaderTexFrag,
-			shaderTexFragSize,
-			layout,
-			3,
-			&textureVertexInfo,
-			true,
-			gRenderer->config.msaa,
-			false);
-
-	// Polygon pipelines
-	gRenderer->primFillPipe = vk2dPipelineCreate(
-			gRenderer->ld,
-			gRenderer->renderPass,
-			gRenderer->surfaceWidth,
-			gRenderer->surfaceHeight,
-			shaderColourVert,
-			shaderColourVertSize,
-			shaderColourFrag,
-			shaderColourFragSize,
-			&gRenderer->dslBufferVP,
-			1,
-			&colourVertexInfo,
-			true,
-			gRenderer->config.msaa,
-			false);
-	gRenderer->primLinePipe = vk2dPipelineCreate(
-			gRenderer->ld,
-			gRenderer->renderPass,
-			gRenderer->surfaceWidth,
-			gRenderer->surfaceHeight,
-			shaderColourVert,
-			shaderColourVertSize,
-			shaderColourFrag,
-			shaderColourFragSize,
-			&gRenderer->dslBufferVP,
-			1,
-			&colourVertexInfo,
-			false,
-			gRenderer->config.msaa,
-			false);
-
-	// 3D pipelines
-	gRenderer->modelPipe = vk2dPipelineCreate(
-			gRenderer->ld,
-			gRenderer->renderPass,
-			gRenderer->surfaceWidth,
-			gRenderer->surfaceHeight,
-			shaderModelVert,
-			shaderModelVertSize,
-			shaderModelFrag,
-			shaderModelFragSize,
-			layout,
-			3,
-			&modelVertexInfo,
-			true,
-			gRenderer->config.msaa,
-			true);
-	gRenderer->wireframePipe = vk2dPipelineCreate(
-			gRenderer->ld,
-			gRenderer->renderPass,
-			gRenderer->surfaceWidth,
-			gRenderer->surfaceHeight,
-			shaderModelVert,
-			shaderModelVertSize,
-			shaderModelFrag,
-			shaderModelFragSize,
-			layout,
-			3,
-			&modelVertexInfo,
-			false,
-			gRenderer->config.msaa,
-			true);
-	gRenderer->instancedPipe = vk2dPipelineCreate(
-			gRenderer->ld,
-			gRenderer->renderPass,
-			gRenderer->surfaceWidth,
-			gRenderer->surfaceHeight,
-			shaderInstancedVert,
-			shaderInstancedVertSize,
-			shaderInstancedFrag,
-			shaderInstancedFragSize,
-			layout,
-			3,
-			&instanceVertexInfo,
-			true,
-			gRenderer->config.msaa,
-			false);
+	_VK2DPipelineJob jobs[] = {
+			{&gRenderer->texPipe, shaderTexVert, shaderTexVertSize, shaderTexFrag, shaderTexFragSize, layout, 3, &textureVertexInfo, true, VK2D_PIPELINE_TYPE_DEFAULT},
+			{&gRenderer->primFillPipe, shaderColourVert, shaderColourVertSize, shaderColourFrag, shaderColourFragSize, &gRenderer->dslBufferVP, 1, &colourVertexInfo, true, VK2D_PIPELINE_TYPE_DEFAULT},
+			{&gRenderer->primLinePipe, shaderColourVert, shaderColourVertSize, shaderColourFrag, shaderColourFragSize, &gRenderer->dslBufferVP, 1, &colourVertexInfo, false, VK2D_PIPELINE_TYPE_DEFAULT},
+			{&gRenderer->modelPipe, shaderModelVert, shaderModelVertSize, shaderModelFrag, shaderModelFragSize, layout, 3, &modelVertexInfo, true, VK2D_PIPELINE_TYPE_3D},
+			{&gRenderer->wireframePipe, shaderModelVert, shaderModelVertSize, shaderModelFrag, shaderModelFragSize, layout, 3, &modelVertexInfo, false, VK2D_PIPELINE_TYPE_3D},
+			{&gRenderer->instancedPipe, shaderInstancedVert, shaderInstancedVertSize, shaderInstancedFrag, shaderInstancedFragSize, layout, 3, &instanceVertexInfo, true, VK2D_PIPELINE_TYPE_DEFAULT},
+	};
+	const int jobCount = sizeof(jobs) / sizeof(_VK2DPipelineJob);
+	SDL_Thread *jobThreads[sizeof(jobs) / sizeof(_VK2DPipelineJob)];
+	for (int job = 0; job < jobCount; job++)
+		jobThreads[job] = SDL_CreateThread(_vk2dPipelineJobThread, "VK2D_Pipeline", &jobs[job]);
+	for (int job = 0; job < jobCount; job++) {
+		if (jobThreads[job] != NULL)
+			SDL_WaitThread(jobThreads[job], NULL);
+		else // Thread creation failed, build it here instead
+			_vk2dPipelineJobThread(&jobs[job]);
+	}
 
-	// Shader pipelines
+	// Shader pipelines - in-flight background builds are joined first so they can't
+	// race the rebuild or publish a pipeline against the old surface
 	for (i = 0; i < gRenderer->shaderListSize; i++) {
 		if (gRenderer->customShaders[i] != NULL) {
+			_vk2dShaderJoinBuild(gRenderer->customShaders[i]);
 			vk2dPipelineFree(gRenderer->customShaders[i]->pipe);
 			_vk2dShaderBuildPipe(gRenderer->customShaders[i]);
 		}
@@ -895,6 +1306,9 @@ void _vk2dRendererCreateUniformBuffers(bool newCamera) {
 	gRenderer->cameras[VK2D_DEFAULT_CAMERA].spec.hOnScreen = gRenderer->surfaceHeight;
 	gRenderer->cameras[VK2D_DEFAULT_CAMERA].spec.w = gRenderer->surfaceWidth;
 	gRenderer->cameras[VK2D_DEFAULT_CAMERA].spec.h = gRenderer->surfaceHeight;
+	if (gRenderer->cameras[VK2D_DEFAULT_CAMERA].uboDirty != NULL)
+		for (int i = 0; i < gRenderer->swapchainImageCount; i++)
+			gRenderer->cameras[VK2D_DEFAULT_CAMERA].uboDirty[i] = true;
 
 	VK2DCameraSpec unitCam = {
 			VK2D_CAMERA_TYPE_DEFAULT,
@@ -909,6 +1323,13 @@ void _vk2dRendererCreateUniformBuffers(bool newCamera) {
 	gRenderer->unitUBO = vk2dBufferLoad(gRenderer->ld, sizeof(VK2DUniformBufferObject), VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, &unitUBO, true);
 	gRenderer->unitUBOSet = vk2dDescConGetBufferSet(gRenderer->descConVP, gRenderer->unitUBO);
 
+	// 2D draws premultiply each camera's VP into the model push constant so every draw can
+	// share this identity VP at set 0 - alternating cameras then never costs a set bind
+	VK2DUniformBufferObject identityUBO = {0};
+	identityMatrix(identityUBO.viewproj);
+	gRenderer->identityUBO = vk2dBufferLoad(gRenderer->ld, sizeof(VK2DUniformBufferObject), VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, &identityUBO, true);
+	gRenderer->identityUBOSet = vk2dDescConGetBufferSet(gRenderer->descConVP, gRenderer->identityUBO);
+
 	vk2dLogMessage("UBO initialized...");
 }
 
@@ -919,6 +1340,7 @@ void _vk2dRendererDestroyUniformBuffers() {
 		if (vk2dCameraGetState(i) == VK2D_CAMERA_STATE_NORMAL || vk2dCameraGetState(i) == VK2D_CAMERA_STATE_DISABLED)
 			vk2dCameraSetState(i, VK2D_CAMERA_STATE_RESET);
 	vk2dBufferFree(gRenderer->unitUBO);
+	vk2dBufferFree(gRenderer->identityUBO);
 }
 
 void _vk2dRendererCreateDescriptorPool(bool preserveDescCons) {
@@ -958,26 +1380,31 @@ void _vk2dRendererCreateSynchronization() {
 	uint32_t i;
 	VkSemaphoreCreateInfo semaphoreCreateInfo = vk2dInitSemaphoreCreateInfo(0);
 	VkFenceCreateInfo fenceCreateInfo = vk2dInitFenceCreateInfo(VK_FENCE_CREATE_SIGNALED_BIT);
-	gRenderer->imageAvailableSemaphores = malloc(sizeof(VkSemaphore) * VK2D_MAX_FRAMES_IN_FLIGHT);
-	gRenderer->renderFinishedSemaphores = malloc(sizeof(VkSemaphore) * VK2D_MAX_FRAMES_IN_FLIGHT);
-	gRenderer->inFlightFences = malloc(sizeof(VkFence) * VK2D_MAX_FRAMES_IN_FLIGHT);
+	gRenderer->imageAvailableSemaphores = malloc(sizeof(VkSemaphore) * gRenderer->framesInFlight);
+	gRenderer->renderFinishedSemaphores = malloc(sizeof(VkSemaphore) * gRenderer->framesInFlight);
+	gRenderer->dbFinishedSemaphores = malloc(sizeof(VkSemaphore) * gRenderer->framesInFlight);
+	gRenderer->inFlightFences = malloc(sizeof(VkFence) * gRenderer->framesInFlight);
 	gRenderer->imagesInFlight = calloc(1, sizeof(VkFence) * gRenderer->swapchainImageCount);
 	gRenderer->commandBuffer = malloc(sizeof(VkCommandBuffer) * gRenderer->swapchainImageCount);
 	gRenderer->dbCommandBuffer = malloc(sizeof(VkCommandBuffer) * gRenderer->swapchainImageCount);
 
 	if (vk2dPointerCheck(gRenderer->imageAvailableSemaphores) && vk2dPointerCheck(gRenderer->renderFinishedSemaphores)
-		&& vk2dPointerCheck(gRenderer->inFlightFences) && vk2dPointerCheck(gRenderer->imagesInFlight)) {
-		for (i = 0; i < VK2D_MAX_FRAMES_IN_FLIGHT; i++) {
+		&& vk2dPointerCheck(gRenderer->dbFinishedSemaphores) && vk2dPointerCheck(gRenderer->inFlightFences)
+		&& vk2dPointerCheck(gRenderer->imagesInFlight)) {
+		for (i = 0; i < gRenderer->framesInFlight; i++) {
 			vk2dErrorCheck(vkCreateSemaphore(gRenderer->ld->dev, &semaphoreCreateInfo, VK_NULL_HANDLE, &gRenderer->imageAvailableSemaphores[i]));
 			vk2dErrorCheck(vkCreateSemaphore(gRenderer->ld->dev, &semaphoreCreateInfo, VK_NULL_HANDLE, &gRenderer->renderFinishedSemaphores[i]));
+			vk2dErrorCheck(vkCreateSemaphore(gRenderer->ld->dev, &semaphoreCreateInfo, VK_NULL_HANDLE, &gRenderer->dbFinishedSemaphores[i]));
 			vk2dErrorCheck(vkCreateFence(gRenderer->ld->dev, &fenceCreateInfo, VK_NULL_HANDLE, &gRenderer->inFlightFences[i]));
 		}
 	}
 
+	// The descriptor-buffer copy batch records on the transfer queue's pool so it can
+	// overlap with draws when the host has a dedicated transfer family
 	if (vk2dPointerCheck(gRenderer->commandBuffer) && vk2dPointerCheck(gRenderer->dbCommandBuffer)) {
 		for (i = 0; i < gRenderer->swapchainImageCount; i++) {
 			gRenderer->commandBuffer[i] = vk2dLogicalDeviceGetCommandBuffer(gRenderer->ld, true);
-			gRenderer->dbCommandBuffer[i] = vk2dLogicalDeviceGetCommandBuffer(gRenderer->ld, true);
+			gRenderer->dbCommandBuffer[i] = vk2dLogicalDeviceGetTransferCommandBuffer(gRenderer->ld);
 		}
 	}
 
@@ -988,18 +1415,44 @@ void _vk2dRendererDestroySynchronization() {
 	VK2DRenderer gRenderer = vk2dRendererGetPointer();
 	uint32_t i;
 
-	for (i = 0; i < VK2D_MAX_FRAMES_IN_FLIGHT; i++) {
+	for (i = 0; i < gRenderer->framesInFlight; i++) {
 		vkDestroySemaphore(gRenderer->ld->dev, gRenderer->renderFinishedSemaphores[i], VK_NULL_HANDLE);
 		vkDestroySemaphore(gRenderer->ld->dev, gRenderer->imageAvailableSemaphores[i], VK_NULL_HANDLE);
+		vkDestroySemaphore(gRenderer->ld->dev, gRenderer->dbFinishedSemaphores[i], VK_NULL_HANDLE);
 		vkDestroyFence(gRenderer->ld->dev, gRenderer->inFlightFences[i], VK_NULL_HANDLE);
 	}
 	free(gRenderer->imagesInFlight);
 	free(gRenderer->inFlightFences);
 	free(gRenderer->imageAvailableSemaphores);
 	free(gRenderer->renderFinishedSemaphores);
+	free(gRenderer->dbFinishedSemaphores);
 	free(gRenderer->commandBuffer);
 }
 
+void _vk2dRendererCreateGpuProfiling() {
+	VK2DRenderer gRenderer = vk2dRendererGetPointer();
+	gRenderer->timestampPeriod = gRenderer->pd->props.limits.timestampPeriod;
+	gRenderer->gpuProfileSupported = gRenderer->pd->props.limits.timestampComputeAndGraphics && gRenderer->timestampPeriod > 0;
+
+	if (gRenderer->gpuProfileSupported) {
+		VkQueryPoolCreateInfo queryPoolCreateInfo = {0};
+		queryPoolCreateInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+		queryPoolCreateInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+		queryPoolCreateInfo.queryCount = VK2D_MAX_FRAMES_IN_FLIGHT * VK2D_MAX_GPU_TIMESTAMPS;
+		vk2dErrorCheck(vkCreateQueryPool(gRenderer->ld->dev, &queryPoolCreateInfo, VK_NULL_HANDLE, &gRenderer->gpuProfileQueryPool));
+		vk2dLogMessage("GPU profiling is enabled...");
+	} else {
+		gRenderer->gpuProfileQueryPool = VK_NULL_HANDLE;
+		vk2dLogMessage("GPU profiling is not available on this device...");
+	}
+}
+
+void _vk2dRendererDestroyGpuProfiling() {
+	VK2DRenderer gRenderer = vk2dRendererGetPointer();
+	if (gRenderer->gpuProfileQueryPool != VK_NULL_HANDLE)
+		vkDestroyQueryPool(gRenderer->ld->dev, gRenderer->gpuProfileQueryPool, VK_NULL_HANDLE);
+}
+
 void _vk2dRendererCreateSampler() {
 	VK2DRenderer gRenderer = vk2dRendererGetPointer();
 
@@ -1011,11 +1464,21 @@ void _vk2dRendererCreateSampler() {
 	VkWriteDescriptorSet write = vk2dInitWriteDescriptorSet(VK_DESCRIPTOR_TYPE_SAMPLER, 1, gRenderer->samplerSet, VK_NULL_HANDLE, 1, &imageInfo);
 	vkUpdateDescriptorSets(gRenderer->ld->dev, 1, &write, 0, VK_NULL_HANDLE);
 
-	// 3D sampler
+	// 3D sampler - normalized UVs make mip and anisotropic sampling legal here, the 2D
+	// sampler's unnormalized coordinates require it to stay at LOD 0
 	samplerCreateInfo.unnormalizedCoordinates = VK_FALSE;
 	samplerCreateInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_REPEAT;
 	samplerCreateInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_REPEAT;
 	samplerCreateInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+	if (gRenderer->config.enableMipmaps) {
+		samplerCreateInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_LINEAR;
+		samplerCreateInfo.maxLod = VK_LOD_CLAMP_NONE;
+	}
+	if (gRenderer->config.anisotropy > 1 && gRenderer->pd->feats.samplerAnisotropy) {
+		const float maxAnisotropy = gRenderer->pd->props.limits.maxSamplerAnisotropy;
+		samplerCreateInfo.anisotropyEnable = VK_TRUE;
+		samplerCreateInfo.maxAnisotropy = gRenderer->config.anisotropy > maxAnisotropy ? maxAnisotropy : gRenderer->config.anisotropy;
+	}
 	vk2dErrorCheck(vkCreateSampler(gRenderer->ld->dev, &samplerCreateInfo, VK_NULL_HANDLE, &gRenderer->modelSampler));
 	imageInfo.sampler = gRenderer->modelSampler;
 	write = vk2dInitWriteDescriptorSet(VK_DESCRIPTOR_TYPE_SAMPLER, 1, gRenderer->modelSamplerSet, VK_NULL_HANDLE, 1, &imageInfo);
@@ -1058,6 +1521,52 @@ void _vk2dRendererDestroyUnits() {
 	vk2dPolygonFree(gRenderer->unitLine);
 }
 
+VK2DImage _vk2dRendererGetSharedDepthBuffer(uint32_t w, uint32_t h) {
+	VK2DRenderer gRenderer = vk2dRendererGetPointer();
+
+	// Depth contents never survive a render pass (they load cleared from undefined), so every
+	// same-size target can lean on one attachment instead of paying full VRAM each
+	for (uint32_t i = 0; i < gRenderer->sharedDepthBufferCount; i++) {
+		VK2DSharedAttachment *shared = &gRenderer->sharedDepthBuffers[i];
+		if (shared->img->width == w && shared->img->height == h && shared->msaa == (VkSampleCountFlagBits)gRenderer->config.msaa) {
+			shared->refs++;
+			return shared->img;
+		}
+	}
+
+	if (gRenderer->sharedDepthBufferCount == gRenderer->sharedDepthBufferListSize) {
+		VK2DSharedAttachment *newList = realloc(gRenderer->sharedDepthBuffers, sizeof(VK2DSharedAttachment) * (gRenderer->sharedDepthBufferListSize + VK2D_DEFAULT_ARRAY_EXTENSION));
+		if (!vk2dPointerCheck(newList))
+			return NULL;
+		gRenderer->sharedDepthBuffers = newList;
+		gRenderer->sharedDepthBufferListSize += VK2D_DEFAULT_ARRAY_EXTENSION;
+	}
+
+	VK2DImage img = vk2dImageCreate(gRenderer->ld, w, h, gRenderer->depthBufferFormat, VK_IMAGE_ASPECT_DEPTH_BIT, VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT, (VkSampleCountFlagBits)gRenderer->config.msaa);
+	if (img == NULL)
+		return NULL;
+	VK2DSharedAttachment *shared = &gRenderer->sharedDepthBuffers[gRenderer->sharedDepthBufferCount++];
+	shared->img = img;
+	shared->msaa = (VkSampleCountFlagBits)gRenderer->config.msaa;
+	shared->refs = 1;
+	return img;
+}
+
+void _vk2dRendererReleaseSharedDepthBuffer(VK2DImage img) {
+	VK2DRenderer gRenderer = vk2dRendererGetPointer();
+	for (uint32_t i = 0; i < gRenderer->sharedDepthBufferCount; i++) {
+		if (gRenderer->sharedDepthBuffers[i].img == img) {
+			gRenderer->sharedDepthBuffers[i].refs--;
+			if (gRenderer->sharedDepthBuffers[i].refs == 0) {
+				vk2dImageFree(img);
+				gRenderer->sharedDepthBuffers[i] = gRenderer->sharedDepthBuffers[gRenderer->sharedDepthBufferCount - 1];
+				gRenderer->sharedDepthBufferCount--;
+			}
+			return;
+		}
+	}
+}
+
 void _vk2dImageTransitionImageLayout(VK2DLogicalDevice dev, VkImage image, VkImageLayout oldLayout, VkImageLayout newLayout);
 void _vk2dRendererRefreshTargets() {
 	VK2DRenderer gRenderer = vk2dRendererGetPointer();
@@ -1069,7 +1578,9 @@ void _vk2dRendererRefreshTargets() {
 
 			// Sampled image
 			vk2dImageFree(gRenderer->targets[i]->sampledImg);
-			vk2dImageFree(gRenderer->targets[i]->depthBuffer);
+			// Re-acquired rather than freed so targets sharing it trade the old attachment
+			// for the new sample count one by one
+			_vk2dRendererReleaseSharedDepthBuffer(gRenderer->targets[i]->depthBuffer);
 			gRenderer->targets[i]->sampledImg = vk2dImageCreate(
 					gRenderer->ld,
 					gRenderer->targets[i]->img->width,
@@ -1080,7 +1591,7 @@ void _vk2dRendererRefreshTargets() {
 					(VkSampleCountFlagBits)gRenderer->config.msaa);
 			_vk2dImageTransitionImageLayout(gRenderer->ld, gRenderer->targets[i]->sampledImg->img, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
 			//_vk2dImageTransitionImageLayout(gRenderer->ld, gRenderer->targets[i]->depthBuffer->img, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL);
-			gRenderer->targets[i]->depthBuffer = vk2dImageCreate(gRenderer->ld, gRenderer->targets[i]->img->width, gRenderer->targets[i]->img->height, gRenderer->depthBufferFormat, VK_IMAGE_ASPECT_DEPTH_BIT, VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT, (VkSampleCountFlagBits)gRenderer->config.msaa);
+			gRenderer->targets[i]->depthBuffer = _vk2dRendererGetSharedDepthBuffer(gRenderer->targets[i]->img->width, gRenderer->targets[i]->img->height);
 
 			// Framebuffer
 			vkDestroyFramebuffer(gRenderer->ld->dev, gRenderer->targets[i]->fbo, VK_NULL_HANDLE);
@@ -1119,14 +1630,21 @@ void _vk2dRendererResetSwapchain() {
 	}
 	vkDeviceWaitIdle(gRenderer->ld->dev);
 
+	// Pipelines and render passes don't depend on the surface size (viewport/scissor are
+	// dynamic state) - only on MSAA - so plain window resizes keep them and skip the most
+	// expensive part of the rebuild
+	bool keepPipelines = gRenderer->config.msaa == gRenderer->newConfig.msaa;
+
 	// Free swapchain
 	_vk2dRendererDestroySynchronization();
 	_vk2dRendererDestroySampler();
 	_vk2dRendererDestroyDescriptorPool(true);
 	_vk2dRendererDestroyUniformBuffers();
 	_vk2dRendererDestroyFrameBuffer();
-	_vk2dRendererDestroyPipelines(true);
-	_vk2dRendererDestroyRenderPass();
+	if (!keepPipelines) {
+		_vk2dRendererDestroyPipelines(true);
+		_vk2dRendererDestroyRenderPass();
+	}
 	_vk2dRendererDestroyDepthBuffer();
 	_vk2dRendererDestroyColourResources();
 	_vk2dRendererDestroySwapchain();
@@ -1141,8 +1659,10 @@ void _vk2dRendererResetSwapchain() {
 	_vk2dRendererCreateSwapchain();
 	_vk2dRendererCreateColourResources();
 	_vk2dRendererCreateDepthBuffer();
-	_vk2dRendererCreateRenderPass();
-	_vk2dRendererCreatePipelines();
+	if (!keepPipelines) {
+		_vk2dRendererCreateRenderPass();
+		_vk2dRendererCreatePipelines();
+	}
 	_vk2dRendererCreateFrameBuffer();
 	_vk2dRendererCreateDescriptorPool(true);
 	_vk2dRendererCreateUniformBuffers(false);
@@ -1155,7 +1675,8 @@ void _vk2dRendererResetSwapchain() {
 
 void _vk2dRendererDrawRaw(VkDescriptorSet *sets, uint32_t setCount, VK2DPolygon poly, VK2DPipeline pipe, float x, float y, float xscale, float yscale, float rot, float originX, float originY, float lineWidth, float xInTex, float yInTex, float texWidth, float texHeight, VK2DCameraIndex cam) {
 	VK2DRenderer gRenderer = vk2dRendererGetPointer();
-	VkCommandBuffer buf = gRenderer->commandBuffer[gRenderer->scImageIndex];
+	bool secondary;
+	VkCommandBuffer buf = _vk2dRendererGetRecordingBuffer(&secondary);
 
 	// Account for various coordinate-based qualms
 	originX *= -xscale;
@@ -1192,20 +1713,37 @@ void _vk2dRendererDrawRaw(VkDescriptorSet *sets, uint32_t setCount, VK2DPolygon
 	push.texCoords[2] = texWidth;
 	push.texCoords[3] = texHeight;
 
-	// Check if we actually need to bind things
+	// Check if we actually need to bind things - the elision state is shared between
+	// threads so secondary buffers always bind and never touch it
 	uint64_t hash = _vk2dHashSets(sets, setCount);
-	if (gRenderer->prevPipe != vk2dPipelineGetPipe(pipe, gRenderer->blendMode)) {
+	if (secondary || gRenderer->prevPipe != vk2dPipelineGetPipe(pipe, gRenderer->blendMode)) {
 		vkCmdBindPipeline(buf, VK_PIPELINE_BIND_POINT_GRAPHICS, vk2dPipelineGetPipe(pipe, gRenderer->blendMode));
-		gRenderer->prevPipe = vk2dPipelineGetPipe(pipe, gRenderer->blendMode);
+		if (!secondary) {
+			gRenderer->prevPipe = vk2dPipelineGetPipe(pipe, gRenderer->blendMode);
+			gRenderer->frameStats.pipelineBindsTaken += 1;
+			_vk2dRendererRecordTimestamp(buf, _vk2dPipelineTimeCategory(pipe));
+		}
+	} else {
+		gRenderer->frameStats.pipelineBindsAvoided += 1;
 	}
-	if (gRenderer->prevSetHash != hash) {
+	if (secondary || gRenderer->prevSetHash != hash) {
 		vkCmdBindDescriptorSets(buf, VK_PIPELINE_BIND_POINT_GRAPHICS, pipe->layout, 0, setCount, sets, 0, VK_NULL_HANDLE);
-		gRenderer->prevSetHash = hash;
+		if (!secondary)
+			gRenderer->prevSetHash = hash;
 	}
-	if (poly != NULL && gRenderer->prevVBO != poly->vertices->buf) {
+	if (poly != NULL && poly->dynamic) {
+		// Dynamic polygons live at changing offsets inside shared per-frame buffers, so they
+		// always rebind and invalidate the elision state instead of fooling it
+		if (poly->dynamicBuffer == VK_NULL_HANDLE)
+			return;
+		vkCmdBindVertexBuffers(buf, 0, 1, &poly->dynamicBuffer, &poly->dynamicOffset);
+		if (!secondary)
+			gRenderer->prevVBO = VK_NULL_HANDLE;
+	} else if (poly != NULL && (secondary || gRenderer->prevVBO != poly->vertices->buf)) {
 		VkDeviceSize offsets[] = {0};
 		vkCmdBindVertexBuffers(buf, 0, 1, &poly->vertices->buf, offsets);
-		gRenderer->prevVBO = poly->vertices->buf;
+		if (!secondary)
+			gRenderer->prevVBO = poly->vertices->buf;
 	}
 
 	// Dynamic state that can't be optimized further and the draw call
@@ -1246,14 +1784,20 @@ void _vk2dRendererDrawRaw(VkDescriptorSet *sets, uint32_t setCount, VK2DPolygon
 		vkCmdDraw(buf, poly->vertexCount, 1, 0, 0);
 	else // The only time this would be the case is for textures, where the shader provides the vertices
 		vkCmdDraw(buf, 6, 1, 0, 0);
+	if (!secondary)
+		gRenderer->frameStats.drawCalls += 1;
 }
 
 void _vk2dRendererDrawRawInstanced(VkDescriptorSet *sets, uint32_t setCount, VK2DDrawInstance *instances, int count, VK2DCameraIndex cam) {
 	VK2DRenderer gRenderer = vk2dRendererGetPointer();
-	VkCommandBuffer buf = gRenderer->commandBuffer[gRenderer->scImageIndex];
+	bool secondary;
+	VkCommandBuffer buf = _vk2dRendererGetRecordingBuffer(&secondary);
 
 	// We don't do any binding saving for instanced drawing
-	_vk2dRendererResetBoundPointers();
+	if (!secondary) {
+		_vk2dRendererResetBoundPointers();
+		_vk2dRendererRecordTimestamp(buf, VK2D_PIPELINE_TIME_INSTANCED);
+	}
 	vkCmdBindPipeline(buf, VK_PIPELINE_BIND_POINT_GRAPHICS, vk2dPipelineGetPipe(gRenderer->instancedPipe, gRenderer->blendMode));
 	vkCmdBindDescriptorSets(buf, VK_PIPELINE_BIND_POINT_GRAPHICS, gRenderer->instancedPipe->layout, 0, setCount, sets, 0, VK_NULL_HANDLE);
 
@@ -1294,12 +1838,75 @@ void _vk2dRendererDrawRawInstanced(VkDescriptorSet *sets, uint32_t setCount, VK2
 	vkCmdSetScissor(buf, 0, 1, &scissor);
 	vkCmdSetLineWidth(buf, 1);
 	vkCmdDraw(buf, 6, count, 0, 0);
+	if (!secondary) {
+		gRenderer->frameStats.drawCalls += 1;
+		gRenderer->frameStats.instancedDraws += 1;
+		gRenderer->frameStats.instancesDrawn += count;
+		gRenderer->frameStats.pipelineBindsTaken += 1;
+	}
+}
+
+// Same as above except the instances already live in a device buffer and the draw
+// parameters come from an indirect buffer, so nothing is copied or re-recorded per frame
+void _vk2dRendererDrawRawInstancedIndirect(VkDescriptorSet *sets, uint32_t setCount, VK2DBuffer instances, VK2DBuffer commands, VkDeviceSize commandOffset, uint32_t drawCount, VK2DCameraIndex cam) {
+	VK2DRenderer gRenderer = vk2dRendererGetPointer();
+	bool secondary;
+	VkCommandBuffer buf = _vk2dRendererGetRecordingBuffer(&secondary);
+
+	// We don't do any binding saving for instanced drawing
+	if (!secondary) {
+		_vk2dRendererResetBoundPointers();
+		_vk2dRendererRecordTimestamp(buf, VK2D_PIPELINE_TIME_INSTANCED);
+	}
+	vkCmdBindPipeline(buf, VK_PIPELINE_BIND_POINT_GRAPHICS, vk2dPipelineGetPipe(gRenderer->instancedPipe, gRenderer->blendMode));
+	vkCmdBindDescriptorSets(buf, VK_PIPELINE_BIND_POINT_GRAPHICS, gRenderer->instancedPipe->layout, 0, setCount, sets, 0, VK_NULL_HANDLE);
+
+	// Dynamic state that can't be optimized further and the draw call
+	cam = cam == VK2D_INVALID_CAMERA ? VK2D_DEFAULT_CAMERA : cam; // Account for invalid camera
+	VkRect2D scissor;
+	VkViewport viewport;
+	if (gRenderer->target == NULL) {
+		viewport.x = gRenderer->cameras[cam].spec.xOnScreen;
+		viewport.y = gRenderer->cameras[cam].spec.yOnScreen;
+		viewport.width = gRenderer->cameras[cam].spec.wOnScreen;
+		viewport.height = gRenderer->cameras[cam].spec.hOnScreen;
+		viewport.minDepth = 0;
+		viewport.maxDepth = 1;
+		scissor.extent.width = gRenderer->cameras[cam].spec.wOnScreen;
+		scissor.extent.height = gRenderer->cameras[cam].spec.hOnScreen;
+		scissor.offset.x = gRenderer->cameras[cam].spec.xOnScreen;
+		scissor.offset.y = gRenderer->cameras[cam].spec.yOnScreen;
+	} else {
+		viewport.x = 0;
+		viewport.y = 0;
+		viewport.width = gRenderer->target->img->width;
+		viewport.height = gRenderer->target->img->height;
+		viewport.minDepth = 0;
+		viewport.maxDepth = 1;
+		scissor.extent.width = gRenderer->target->img->width;
+		scissor.extent.height = gRenderer->target->img->height;
+		scissor.offset.x = 0;
+		scissor.offset.y = 0;
+	}
+	VkDeviceSize offset = 0;
+	vkCmdBindVertexBuffers(buf, 0, 1, &instances->buf, &offset);
+	vkCmdSetViewport(buf, 0, 1, &viewport);
+	vkCmdSetScissor(buf, 0, 1, &scissor);
+	vkCmdSetLineWidth(buf, 1);
+	vkCmdDrawIndirect(buf, commands->buf, commandOffset, drawCount, sizeof(VkDrawIndirectCommand));
+	if (!secondary) {
+		// The instance count lives GPU-side so it can't be added to the frame stats
+		gRenderer->frameStats.drawCalls += 1;
+		gRenderer->frameStats.instancedDraws += 1;
+		gRenderer->frameStats.pipelineBindsTaken += 1;
+	}
 }
 
 // Same as above but for 3D rendering
 void _vk2dRendererDrawRaw3D(VkDescriptorSet *sets, uint32_t setCount, VK2DModel model, VK2DPipeline pipe, float x, float y, float z, float xscale, float yscale, float zscale, float rot, vec3 axis, float originX, float originY, float originZ, VK2DCameraIndex cam, float lineWidth) {
 	VK2DRenderer gRenderer = vk2dRendererGetPointer();
-	VkCommandBuffer buf = gRenderer->commandBuffer[gRenderer->scImageIndex];
+	bool secondary;
+	VkCommandBuffer buf = _vk2dRendererGetRecordingBuffer(&secondary);
 
 	// Account for various coordinate-based qualms
 	originX *= xscale;
@@ -1324,19 +1931,28 @@ void _vk2dRendererDrawRaw3D(VkDescriptorSet *sets, uint32_t setCount, VK2DModel
 	push.colourMod[2] = gRenderer->colourBlend[2];
 	push.colourMod[3] = gRenderer->colourBlend[3];
 
-	// Check if we actually need to bind things
+	// Check if we actually need to bind things - the elision state is shared between
+	// threads so secondary buffers always bind and never touch it
 	uint64_t hash = _vk2dHashSets(sets, setCount);
-	if (gRenderer->prevPipe != vk2dPipelineGetPipe(pipe, gRenderer->blendMode)) {
+	if (secondary || gRenderer->prevPipe != vk2dPipelineGetPipe(pipe, gRenderer->blendMode)) {
 		vkCmdBindPipeline(buf, VK_PIPELINE_BIND_POINT_GRAPHICS, vk2dPipelineGetPipe(pipe, gRenderer->blendMode));
-		gRenderer->prevPipe = vk2dPipelineGetPipe(pipe, gRenderer->blendMode);
+		if (!secondary) {
+			gRenderer->prevPipe = vk2dPipelineGetPipe(pipe, gRenderer->blendMode);
+			gRenderer->frameStats.pipelineBindsTaken += 1;
+			_vk2dRendererRecordTimestamp(buf, _vk2dPipelineTimeCategory(pipe));
+		}
+	} else {
+		gRenderer->frameStats.pipelineBindsAvoided += 1;
 	}
-	if (gRenderer->prevSetHash != hash) {
+	if (secondary || gRenderer->prevSetHash != hash) {
 		vkCmdBindDescriptorSets(buf, VK_PIPELINE_BIND_POINT_GRAPHICS, pipe->layout, 0, setCount, sets, 0, VK_NULL_HANDLE);
-		gRenderer->prevSetHash = hash;
+		if (!secondary)
+			gRenderer->prevSetHash = hash;
 	}
 	VkDeviceSize offsets[] = {model->vertexOffset};
 	vkCmdBindVertexBuffers(buf, 0, 1, &model->vertices->buf, offsets);
-	gRenderer->prevVBO = model->vertices->buf;
+	if (!secondary)
+		gRenderer->prevVBO = model->vertices->buf;
 	vkCmdBindIndexBuffer(buf, model->vertices->buf, model->indexOffset, VK_INDEX_TYPE_UINT16);
 
 	// Dynamic state that can't be optimized further and the draw call
@@ -1374,6 +1990,72 @@ void _vk2dRendererDrawRaw3D(VkDescriptorSet *sets, uint32_t setCount, VK2DModel
 		vkCmdSetLineWidth(buf, 1);
 	vkCmdPushConstants(buf, pipe->layout, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(VK2D3DPushBuffer), &push);
 	vkCmdDrawIndexed(buf, model->indexCount, 1, 0, 0, 0);
+	if (!secondary)
+		gRenderer->frameStats.drawCalls += 1;
+}
+
+// Records many copies of the same model in one pass - shared state (pipeline, descriptor
+// sets, vertex/index buffers, viewport) binds once and each instance only records its push
+// constants and an indexed draw. The model pipeline's vertex layout carries no per-instance
+// attributes so the transforms can't ride a vertex buffer like sprite instances do
+void _vk2dRendererDrawRaw3DInstanced(VkDescriptorSet *sets, uint32_t setCount, VK2DModel model, VK2DPipeline pipe, mat4 *transforms, uint32_t count, VK2DCameraIndex cam) {
+	VK2DRenderer gRenderer = vk2dRendererGetPointer();
+	bool secondary;
+	VkCommandBuffer buf = _vk2dRendererGetRecordingBuffer(&secondary);
+
+	// Check if we actually need to bind things - the elision state is shared between
+	// threads so secondary buffers always bind and never touch it
+	uint64_t hash = _vk2dHashSets(sets, setCount);
+	if (secondary || gRenderer->prevPipe != vk2dPipelineGetPipe(pipe, gRenderer->blendMode)) {
+		vkCmdBindPipeline(buf, VK_PIPELINE_BIND_POINT_GRAPHICS, vk2dPipelineGetPipe(pipe, gRenderer->blendMode));
+		if (!secondary) {
+			gRenderer->prevPipe = vk2dPipelineGetPipe(pipe, gRenderer->blendMode);
+			gRenderer->frameStats.pipelineBindsTaken += 1;
+			_vk2dRendererRecordTimestamp(buf, _vk2dPipelineTimeCategory(pipe));
+		}
+	} else {
+		gRenderer->frameStats.pipelineBindsAvoided += 1;
+	}
+	if (secondary || gRenderer->prevSetHash != hash) {
+		vkCmdBindDescriptorSets(buf, VK_PIPELINE_BIND_POINT_GRAPHICS, pipe->layout, 0, setCount, sets, 0, VK_NULL_HANDLE);
+		if (!secondary)
+			gRenderer->prevSetHash = hash;
+	}
+	VkDeviceSize offsets[] = {model->vertexOffset};
+	vkCmdBindVertexBuffers(buf, 0, 1, &model->vertices->buf, offsets);
+	if (!secondary)
+		gRenderer->prevVBO = model->vertices->buf;
+	vkCmdBindIndexBuffer(buf, model->vertices->buf, model->indexOffset, VK_INDEX_TYPE_UINT16);
+
+	cam = cam == VK2D_INVALID_CAMERA ? VK2D_DEFAULT_CAMERA : cam; // Account for invalid camera
+	_vk2dRendererRecordCameraViewport(gRenderer, buf, cam);
+	vkCmdSetLineWidth(buf, 1);
+
+	// Each instance is just a push and a draw
+	VK2D3DPushBuffer push = {0};
+	push.colourMod[0] = gRenderer->colourBlend[0];
+	push.colourMod[1] = gRenderer->colourBlend[1];
+	push.colourMod[2] = gRenderer->colourBlend[2];
+	push.colourMod[3] = gRenderer->colourBlend[3];
+	for (uint32_t i = 0; i < count; i++) {
+		memcpy(push.model, transforms[i], sizeof(mat4));
+		vkCmdPushConstants(buf, pipe->layout, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(VK2D3DPushBuffer), &push);
+		vkCmdDrawIndexed(buf, model->indexCount, 1, 0, 0, 0);
+	}
+	if (!secondary)
+		gRenderer->frameStats.drawCalls += count;
+}
+
+// Same as _vk2dRendererDraw3D below but for instanced model draws
+void _vk2dRendererDraw3DInstanced(VkDescriptorSet *sets, uint32_t setCount, VK2DModel model, VK2DPipeline pipe, mat4 *transforms, uint32_t count) {
+	VK2DRenderer gRenderer = vk2dRendererGetPointer();
+	// Only render to 3D cameras
+	for (int i = 0; i < VK2D_MAX_CAMERAS; i++) {
+		if (gRenderer->cameras[i].state == VK2D_CAMERA_STATE_NORMAL && gRenderer->cameras[i].spec.type != VK2D_CAMERA_TYPE_DEFAULT && (i == gRenderer->cameraLocked || gRenderer->cameraLocked == VK2D_INVALID_CAMERA)) {
+			sets[0] = gRenderer->cameras[i].uboSets[gRenderer->scImageIndex];
+			_vk2dRendererDrawRaw3DInstanced(sets, setCount, model, pipe, transforms, count, i);
+		}
+	}
 }
 
 // Same as _vk2dRendererDraw below but specifically for 3D rendering
@@ -1388,20 +2070,330 @@ void _vk2dRendererDraw3D(VkDescriptorSet *sets, uint32_t setCount, VK2DModel mod
 	}
 }
 
+// Returns whether a circle of the given radius around a world point could be visible to a camera,
+// conservatively - the camera's view is bounded by its diagonal so rotation/zoom can never cull
+// something visible
+static bool _vk2dCameraSeesBounds(VK2DCameraSpec *spec, float x, float y, float radius) {
+	float zoom = spec->zoom > 0 ? spec->zoom : 1;
+	float cameraRadius = 0.5f * sqrtf((spec->w * spec->w) + (spec->h * spec->h)) / zoom;
+	float cameraX = spec->x + (spec->w * 0.5f);
+	float cameraY = spec->y + (spec->h * 0.5f);
+	return fabsf(x - cameraX) <= cameraRadius + radius && fabsf(y - cameraY) <= cameraRadius + radius;
+}
+
+// Packs every instance a camera could see into a frame-arena list, returning how many survived
+static int _vk2dRendererCullInstances(VK2DRenderer gRenderer, VK2DCameraSpec *spec, VK2DDrawInstance *instances, int count, VK2DDrawInstance **visibleList) {
+	int visible = 0;
+	*visibleList = vk2dFrameAlloc(sizeof(VK2DDrawInstance) * count);
+	if (!vk2dPointerCheck(*visibleList))
+		return 0;
+	for (int i = 0; i < count; i++) {
+		VK2DDrawInstance *in = &instances[i];
+		// Bound the transformed quad by its model matrix's absolute row sums, translation lives
+		// either in the matrix (rotated instances) or the pos vector (fast instances)
+		float radius = ((fabsf(in->model[0]) + fabsf(in->model[4])) * in->texturePos[2]) +
+					   ((fabsf(in->model[1]) + fabsf(in->model[5])) * in->texturePos[3]);
+		if (_vk2dCameraSeesBounds(spec, in->pos[0] + in->model[12], in->pos[1] + in->model[13], radius))
+			(*visibleList)[visible++] = *in;
+	}
+	return visible;
+}
+
+// Records a camera's viewport and scissor, or the target's when one is bound
+static void _vk2dRendererRecordCameraViewport(VK2DRenderer gRenderer, VkCommandBuffer buf, VK2DCameraIndex cam) {
+	VkRect2D scissor;
+	VkViewport viewport;
+	if (gRenderer->target == NULL) {
+		viewport.x = gRenderer->cameras[cam].spec.xOnScreen;
+		viewport.y = gRenderer->cameras[cam].spec.yOnScreen;
+		viewport.width = gRenderer->cameras[cam].spec.wOnScreen;
+		viewport.height = gRenderer->cameras[cam].spec.hOnScreen;
+		viewport.minDepth = 0;
+		viewport.maxDepth = 1;
+		scissor.extent.width = gRenderer->cameras[cam].spec.wOnScreen;
+		scissor.extent.height = gRenderer->cameras[cam].spec.hOnScreen;
+		scissor.offset.x = gRenderer->cameras[cam].spec.xOnScreen;
+		scissor.offset.y = gRenderer->cameras[cam].spec.yOnScreen;
+	} else {
+		viewport.x = 0;
+		viewport.y = 0;
+		viewport.width = gRenderer->target->img->width;
+		viewport.height = gRenderer->target->img->height;
+		viewport.minDepth = 0;
+		viewport.maxDepth = 1;
+		scissor.extent.width = gRenderer->target->img->width;
+		scissor.extent.height = gRenderer->target->img->height;
+		scissor.offset.x = 0;
+		scissor.offset.y = 0;
+	}
+	vkCmdSetViewport(buf, 0, 1, &viewport);
+	vkCmdSetScissor(buf, 0, 1, &scissor);
+}
+
+// Same as _vk2dRendererDrawRaw but records the draw for a list of cameras in one pass - state
+// shared between cameras (pipeline, descriptor sets past the UBO, vertex buffer, push
+// constants) is recorded once and each camera only re-records its UBO set, viewport/scissor
+// and the draw itself
+static void _vk2dRendererDrawRawMultiCam(VkDescriptorSet *sets, uint32_t setCount, VK2DPolygon poly, VK2DPipeline pipe, float x, float y, float xscale, float yscale, float rot, float originX, float originY, float lineWidth, float xInTex, float yInTex, float texWidth, float texHeight, int *cameras, int cameraCount) {
+	VK2DRenderer gRenderer = vk2dRendererGetPointer();
+	bool secondary;
+	VkCommandBuffer buf = _vk2dRendererGetRecordingBuffer(&secondary);
+
+	// Account for various coordinate-based qualms
+	originX *= -xscale;
+	originY *= yscale;
+
+	// Push constants
+	VK2DPushBuffer push = {0};
+	identityMatrix(push.model);
+	// Only do rotation matrices if a rotation is specified for optimization purposes
+	if (rot != 0) {
+		vec3 axis = {0, 0, 1};
+		vec3 origin = {-originX + x, originY + y, 0};
+		vec3 originTranslation = {originX, -originY, 0};
+		translateMatrix(push.model, origin);
+		rotateMatrix(push.model, axis, rot);
+		translateMatrix(push.model, originTranslation);
+	} else {
+		vec3 origin = {x, y, 0};
+		translateMatrix(push.model, origin);
+	}
+	// Only scale matrix if specified for optimization purposes
+	if (xscale != 1 || yscale != 1) {
+		vec3 scale = {xscale, yscale, 1};
+		scaleMatrix(push.model, scale);
+	}
+	push.colourMod[0] = gRenderer->colourBlend[0];
+	push.colourMod[1] = gRenderer->colourBlend[1];
+	push.colourMod[2] = gRenderer->colourBlend[2];
+	push.colourMod[3] = gRenderer->colourBlend[3];
+	push.texCoords[0] = xInTex;
+	push.texCoords[1] = yInTex;
+	push.texCoords[2] = texWidth;
+	push.texCoords[3] = texHeight;
+
+	// Every 2D draw binds the shared identity VP at set 0 and premultiplies each camera's
+	// VP into the model push constant instead, so switching cameras (or interleaving draws
+	// between them) never invalidates the set hash - pushes happen per draw anyway
+	mat4 model;
+	memcpy(model, push.model, sizeof(mat4));
+	sets[0] = gRenderer->identityUBOSet;
+	uint64_t hash = _vk2dHashSets(sets, setCount);
+	if (secondary || gRenderer->prevPipe != vk2dPipelineGetPipe(pipe, gRenderer->blendMode)) {
+		vkCmdBindPipeline(buf, VK_PIPELINE_BIND_POINT_GRAPHICS, vk2dPipelineGetPipe(pipe, gRenderer->blendMode));
+		if (!secondary) {
+			gRenderer->prevPipe = vk2dPipelineGetPipe(pipe, gRenderer->blendMode);
+			gRenderer->frameStats.pipelineBindsTaken += 1;
+			_vk2dRendererRecordTimestamp(buf, _vk2dPipelineTimeCategory(pipe));
+		}
+	} else {
+		gRenderer->frameStats.pipelineBindsAvoided += 1;
+	}
+	if (secondary || gRenderer->prevSetHash != hash) {
+		vkCmdBindDescriptorSets(buf, VK_PIPELINE_BIND_POINT_GRAPHICS, pipe->layout, 0, setCount, sets, 0, VK_NULL_HANDLE);
+		if (!secondary)
+			gRenderer->prevSetHash = hash;
+	}
+	if (poly != NULL && poly->dynamic) {
+		// Dynamic polygons live at changing offsets inside shared per-frame buffers, so they
+		// always rebind and invalidate the elision state instead of fooling it
+		if (poly->dynamicBuffer == VK_NULL_HANDLE)
+			return;
+		vkCmdBindVertexBuffers(buf, 0, 1, &poly->dynamicBuffer, &poly->dynamicOffset);
+		if (!secondary)
+			gRenderer->prevVBO = VK_NULL_HANDLE;
+	} else if (poly != NULL && (secondary || gRenderer->prevVBO != poly->vertices->buf)) {
+		VkDeviceSize offsets[] = {0};
+		vkCmdBindVertexBuffers(buf, 0, 1, &poly->vertices->buf, offsets);
+		if (!secondary)
+			gRenderer->prevVBO = poly->vertices->buf;
+	}
+	if (gRenderer->limits.maxLineWidth != 1)
+		vkCmdSetLineWidth(buf, lineWidth);
+	else
+		vkCmdSetLineWidth(buf, 1);
+
+	// Per-camera state and the draw calls - each camera's VP folds into the push constant
+	for (int i = 0; i < cameraCount; i++) {
+		memset(push.model, 0, sizeof(mat4));
+		multiplyMatrix(model, gRenderer->cameras[cameras[i]].ubos[gRenderer->scImageIndex].viewproj, push.model);
+		vkCmdPushConstants(buf, pipe->layout, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(VK2DPushBuffer), &push);
+		_vk2dRendererRecordCameraViewport(gRenderer, buf, cameras[i]);
+		if (poly != NULL)
+			vkCmdDraw(buf, poly->vertexCount, 1, 0, 0);
+		else // The only time this would be the case is for textures, where the shader provides the vertices
+			vkCmdDraw(buf, 6, 1, 0, 0);
+		if (!secondary)
+			gRenderer->frameStats.drawCalls += 1;
+	}
+}
+
+// Same as _vk2dRendererDrawRawInstanced for a list of cameras - the instances upload once
+// and each camera only re-records its UBO set, viewport/scissor and the draw
+static void _vk2dRendererDrawRawInstancedMultiCam(VkDescriptorSet *sets, uint32_t setCount, VK2DDrawInstance *instances, int count, int *cameras, int cameraCount) {
+	VK2DRenderer gRenderer = vk2dRendererGetPointer();
+	bool secondary;
+	VkCommandBuffer buf = _vk2dRendererGetRecordingBuffer(&secondary);
+
+	// We don't do any binding saving for instanced drawing
+	if (!secondary) {
+		_vk2dRendererResetBoundPointers();
+		_vk2dRendererRecordTimestamp(buf, VK2D_PIPELINE_TIME_INSTANCED);
+	}
+	vkCmdBindPipeline(buf, VK_PIPELINE_BIND_POINT_GRAPHICS, vk2dPipelineGetPipe(gRenderer->instancedPipe, gRenderer->blendMode));
+	sets[0] = gRenderer->cameras[cameras[0]].uboSets[gRenderer->scImageIndex];
+	vkCmdBindDescriptorSets(buf, VK_PIPELINE_BIND_POINT_GRAPHICS, gRenderer->instancedPipe->layout, 0, setCount, sets, 0, VK_NULL_HANDLE);
+
+	// Make vertex buffer - one upload serves every camera
+	VkBuffer buffer;
+	VkDeviceSize offset;
+	vk2dDescriptorBufferCopyData(gRenderer->descriptorBuffers[gRenderer->currentFrame], instances, count * sizeof(VK2DDrawInstance), &buffer, &offset);
+	vkCmdBindVertexBuffers(buf, 0, 1, &buffer, &offset);
+	vkCmdSetLineWidth(buf, 1);
+
+	for (int i = 0; i < cameraCount; i++) {
+		if (i > 0) {
+			sets[0] = gRenderer->cameras[cameras[i]].uboSets[gRenderer->scImageIndex];
+			vkCmdBindDescriptorSets(buf, VK_PIPELINE_BIND_POINT_GRAPHICS, gRenderer->instancedPipe->layout, 0, 1, sets, 0, VK_NULL_HANDLE);
+		}
+		_vk2dRendererRecordCameraViewport(gRenderer, buf, cameras[i]);
+		vkCmdDraw(buf, 6, count, 0, 0);
+		if (!secondary) {
+			gRenderer->frameStats.drawCalls += 1;
+			gRenderer->frameStats.instancedDraws += 1;
+			gRenderer->frameStats.instancesDrawn += count;
+		}
+	}
+	if (!secondary)
+		gRenderer->frameStats.pipelineBindsTaken += 1;
+}
+
+// Same as _vk2dRendererDrawRawInstancedIndirect for a list of cameras
+static void _vk2dRendererDrawRawInstancedIndirectMultiCam(VkDescriptorSet *sets, uint32_t setCount, VK2DBuffer instances, VK2DBuffer commands, VkDeviceSize commandOffset, uint32_t drawCount, int *cameras, int cameraCount) {
+	VK2DRenderer gRenderer = vk2dRendererGetPointer();
+	bool secondary;
+	VkCommandBuffer buf = _vk2dRendererGetRecordingBuffer(&secondary);
+
+	// We don't do any binding saving for instanced drawing
+	if (!secondary) {
+		_vk2dRendererResetBoundPointers();
+		_vk2dRendererRecordTimestamp(buf, VK2D_PIPELINE_TIME_INSTANCED);
+	}
+	vkCmdBindPipeline(buf, VK_PIPELINE_BIND_POINT_GRAPHICS, vk2dPipelineGetPipe(gRenderer->instancedPipe, gRenderer->blendMode));
+	sets[0] = gRenderer->cameras[cameras[0]].uboSets[gRenderer->scImageIndex];
+	vkCmdBindDescriptorSets(buf, VK_PIPELINE_BIND_POINT_GRAPHICS, gRenderer->instancedPipe->layout, 0, setCount, sets, 0, VK_NULL_HANDLE);
+	VkDeviceSize offset = 0;
+	vkCmdBindVertexBuffers(buf, 0, 1, &instances->buf, &offset);
+	vkCmdSetLineWidth(buf, 1);
+
+	for (int i = 0; i < cameraCount; i++) {
+		if (i > 0) {
+			sets[0] = gRenderer->cameras[cameras[i]].uboSets[gRenderer->scImageIndex];
+			vkCmdBindDescriptorSets(buf, VK_PIPELINE_BIND_POINT_GRAPHICS, gRenderer->instancedPipe->layout, 0, 1, sets, 0, VK_NULL_HANDLE);
+		}
+		_vk2dRendererRecordCameraViewport(gRenderer, buf, cameras[i]);
+		vkCmdDrawIndirect(buf, commands->buf, commandOffset, drawCount, sizeof(VkDrawIndirectCommand));
+		if (!secondary) {
+			// The instance count lives GPU-side so it can't be added to the frame stats
+			gRenderer->frameStats.drawCalls += 1;
+			gRenderer->frameStats.instancedDraws += 1;
+		}
+	}
+	if (!secondary)
+		gRenderer->frameStats.pipelineBindsTaken += 1;
+}
+
+// Records a batch of world-space coloured triangles accumulated by the shape batcher - the
+// vertices stream through the frame's descriptor buffer once and every camera only re-records
+// its premultiplied VP push constant, viewport and the draw
+void _vk2dRendererDrawShapes(VK2DVertexColour *vertices, uint32_t count) {
+	VK2DRenderer gRenderer = vk2dRendererGetPointer();
+	bool secondary;
+	VkCommandBuffer buf = _vk2dRendererGetRecordingBuffer(&secondary);
+	VK2DPipeline pipe = gRenderer->primFillPipe;
+
+	// One upload serves every camera
+	VkBuffer buffer;
+	VkDeviceSize offset;
+	vk2dDescriptorBufferCopyData(gRenderer->descriptorBuffers[gRenderer->currentFrame], vertices, count * sizeof(VK2DVertexColour), &buffer, &offset);
+
+	// The vertices already carry their colour so the push colour mod stays neutral
+	VK2DPushBuffer push = {0};
+	push.colourMod[0] = 1;
+	push.colourMod[1] = 1;
+	push.colourMod[2] = 1;
+	push.colourMod[3] = 1;
+
+	VkDescriptorSet set = gRenderer->target != VK2D_TARGET_SCREEN && !gRenderer->enableTextureCameraUBO ?
+			gRenderer->targetUBOSet : gRenderer->identityUBOSet;
+	uint64_t hash = _vk2dHashSets(&set, 1);
+	if (secondary || gRenderer->prevPipe != vk2dPipelineGetPipe(pipe, gRenderer->blendMode)) {
+		vkCmdBindPipeline(buf, VK_PIPELINE_BIND_POINT_GRAPHICS, vk2dPipelineGetPipe(pipe, gRenderer->blendMode));
+		if (!secondary) {
+			gRenderer->prevPipe = vk2dPipelineGetPipe(pipe, gRenderer->blendMode);
+			gRenderer->frameStats.pipelineBindsTaken += 1;
+			_vk2dRendererRecordTimestamp(buf, _vk2dPipelineTimeCategory(pipe));
+		}
+	} else {
+		gRenderer->frameStats.pipelineBindsAvoided += 1;
+	}
+	if (secondary || gRenderer->prevSetHash != hash) {
+		vkCmdBindDescriptorSets(buf, VK_PIPELINE_BIND_POINT_GRAPHICS, pipe->layout, 0, 1, &set, 0, VK_NULL_HANDLE);
+		if (!secondary)
+			gRenderer->prevSetHash = hash;
+	}
+	vkCmdBindVertexBuffers(buf, 0, 1, &buffer, &offset);
+	if (!secondary)
+		gRenderer->prevVBO = buffer;
+	vkCmdSetLineWidth(buf, 1);
+
+	if (gRenderer->target != VK2D_TARGET_SCREEN && !gRenderer->enableTextureCameraUBO) {
+		// The target UBO supplies the projection, the vertices are already placed
+		identityMatrix(push.model);
+		vkCmdPushConstants(buf, pipe->layout, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(VK2DPushBuffer), &push);
+		_vk2dRendererRecordCameraViewport(gRenderer, buf, VK2D_DEFAULT_CAMERA);
+		vkCmdDraw(buf, count, 1, 0, 0);
+		if (!secondary)
+			gRenderer->frameStats.drawCalls += 1;
+	} else {
+		// World-space vertices mean each camera's whole VP just rides the push constant
+		for (int i = 0; i < VK2D_MAX_CAMERAS; i++) {
+			if (gRenderer->cameras[i].state == VK2D_CAMERA_STATE_NORMAL && gRenderer->cameras[i].spec.type == VK2D_CAMERA_TYPE_DEFAULT && (i == gRenderer->cameraLocked || gRenderer->cameraLocked == VK2D_INVALID_CAMERA)) {
+				memcpy(push.model, gRenderer->cameras[i].ubos[gRenderer->scImageIndex].viewproj, sizeof(mat4));
+				vkCmdPushConstants(buf, pipe->layout, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(VK2DPushBuffer), &push);
+				_vk2dRendererRecordCameraViewport(gRenderer, buf, i);
+				vkCmdDraw(buf, count, 1, 0, 0);
+				if (!secondary)
+					gRenderer->frameStats.drawCalls += 1;
+			}
+		}
+	}
+}
+
 // This is the upper level internal draw function that draws to each camera and not just with a scissor/viewport
 void _vk2dRendererDraw(VkDescriptorSet *sets, uint32_t setCount, VK2DPolygon poly, VK2DPipeline pipe, float x, float y, float xscale, float yscale, float rot, float originX, float originY, float lineWidth, float xInTex, float yInTex, float texWidth, float texHeight) {
 	VK2DRenderer gRenderer = vk2dRendererGetPointer();
+	// Only texture draws carry their extents, so shapes and polygons are never culled
+	bool cull = gRenderer->enableCulling && poly == NULL;
+	float radius = 0;
+	if (cull)
+		radius = fabsf(texWidth * xscale) + fabsf(texHeight * yscale) + fabsf(originX * xscale) + fabsf(originY * yscale);
 	if (gRenderer->target != VK2D_TARGET_SCREEN && !gRenderer->enableTextureCameraUBO) {
 		sets[0] = gRenderer->targetUBOSet;
 		_vk2dRendererDrawRaw(sets, setCount, poly, pipe, x, y, xscale, yscale, rot, originX, originY, lineWidth, xInTex, yInTex, texWidth, texHeight, VK2D_INVALID_CAMERA);
 	} else {
-		// Only render to 2D cameras
+		// Gather every 2D camera this draw lands on so shared state only records once
+		int cameras[VK2D_MAX_CAMERAS];
+		int cameraCount = 0;
 		for (int i = 0; i < VK2D_MAX_CAMERAS; i++) {
 			if (gRenderer->cameras[i].state == VK2D_CAMERA_STATE_NORMAL && gRenderer->cameras[i].spec.type == VK2D_CAMERA_TYPE_DEFAULT && (i == gRenderer->cameraLocked || gRenderer->cameraLocked == VK2D_INVALID_CAMERA)) {
-				sets[0] = gRenderer->cameras[i].uboSets[gRenderer->scImageIndex];
-				_vk2dRendererDrawRaw(sets, setCount, poly, pipe, x, y, xscale, yscale, rot, originX, originY, lineWidth, xInTex, yInTex, texWidth, texHeight, i);
+				if (cull && !_vk2dCameraSeesBounds(&gRenderer->cameras[i].spec, x, y, radius))
+					continue;
+				cameras[cameraCount++] = i;
 			}
 		}
+		if (cameraCount > 0)
+			_vk2dRendererDrawRawMultiCam(sets, setCount, poly, pipe, x, y, xscale, yscale, rot, originX, originY, lineWidth, xInTex, yInTex, texWidth, texHeight, cameras, cameraCount);
 	}
 }
 
@@ -1410,14 +2402,45 @@ void _vk2dRendererDrawInstanced(VkDescriptorSet *sets, uint32_t setCount, VK2DDr
 	if (gRenderer->target != VK2D_TARGET_SCREEN && !gRenderer->enableTextureCameraUBO) {
 		sets[0] = gRenderer->targetUBOSet;
 		_vk2dRendererDrawRawInstanced(sets, setCount, instances, count, VK2D_INVALID_CAMERA);
-	} else {
-		// Only render to 2D cameras
+	} else if (gRenderer->enableCulling) {
+		// Each camera may see a different subset, so each records its own filtered copy
 		for (int i = 0; i < VK2D_MAX_CAMERAS; i++) {
 			if (gRenderer->cameras[i].state == VK2D_CAMERA_STATE_NORMAL && gRenderer->cameras[i].spec.type == VK2D_CAMERA_TYPE_DEFAULT && (i == gRenderer->cameraLocked || gRenderer->cameraLocked == VK2D_INVALID_CAMERA)) {
 				sets[0] = gRenderer->cameras[i].uboSets[gRenderer->scImageIndex];
-				_vk2dRendererDrawRawInstanced(sets, setCount, instances, count, i);
+				VK2DDrawInstance *visible;
+				int visibleCount = _vk2dRendererCullInstances(gRenderer, &gRenderer->cameras[i].spec, instances, count, &visible);
+				if (visibleCount > 0)
+					_vk2dRendererDrawRawInstanced(sets, setCount, visible, visibleCount, i);
 			}
 		}
+	} else {
+		// Gather every 2D camera so the instances only upload once
+		int cameras[VK2D_MAX_CAMERAS];
+		int cameraCount = 0;
+		for (int i = 0; i < VK2D_MAX_CAMERAS; i++) {
+			if (gRenderer->cameras[i].state == VK2D_CAMERA_STATE_NORMAL && gRenderer->cameras[i].spec.type == VK2D_CAMERA_TYPE_DEFAULT && (i == gRenderer->cameraLocked || gRenderer->cameraLocked == VK2D_INVALID_CAMERA))
+				cameras[cameraCount++] = i;
+		}
+		if (cameraCount > 0)
+			_vk2dRendererDrawRawInstancedMultiCam(sets, setCount, instances, count, cameras, cameraCount);
+	}
+}
+
+void _vk2dRendererDrawInstancedIndirect(VkDescriptorSet *sets, uint32_t setCount, VK2DBuffer instances, VK2DBuffer commands, VkDeviceSize commandOffset, uint32_t drawCount) {
+	VK2DRenderer gRenderer = vk2dRendererGetPointer();
+	if (gRenderer->target != VK2D_TARGET_SCREEN && !gRenderer->enableTextureCameraUBO) {
+		sets[0] = gRenderer->targetUBOSet;
+		_vk2dRendererDrawRawInstancedIndirect(sets, setCount, instances, commands, commandOffset, drawCount, VK2D_INVALID_CAMERA);
+	} else {
+		// Gather every 2D camera so the buffers and pipeline only bind once
+		int cameras[VK2D_MAX_CAMERAS];
+		int cameraCount = 0;
+		for (int i = 0; i < VK2D_MAX_CAMERAS; i++) {
+			if (gRenderer->cameras[i].state == VK2D_CAMERA_STATE_NORMAL && gRenderer->cameras[i].spec.type == VK2D_CAMERA_TYPE_DEFAULT && (i == gRenderer->cameraLocked || gRenderer->cameraLocked == VK2D_INVALID_CAMERA))
+				cameras[cameraCount++] = i;
+		}
+		if (cameraCount > 0)
+			_vk2dRendererDrawRawInstancedIndirectMultiCam(sets, setCount, instances, commands, commandOffset, drawCount, cameras, cameraCount);
 	}
 }
 
@@ -1492,4 +2515,26 @@ void vk2dInstanceUpdate(VK2DDrawInstance *instance, float x, float y, float xSca
 		vec3 scale = {xScale, yScale, 1};
 		scaleMatrix(instance->model, scale);
 	}
+}
+
+void vk2dInstanceSetBatch(VK2DDrawInstance *instances, uint32_t count, const vec2 *positions, float xScale, float yScale, float rot, float xOrigin, float yOrigin, float xInTex, float yInTex, float wInTex, float hInTex, vec4 colour) {
+	// The transform is shared across the batch so the model matrix only gets built once
+	VK2DDrawInstance prototype;
+	vk2dInstanceSet(&prototype, 0, 0, xScale, yScale, rot, xOrigin, yOrigin, xInTex, yInTex, wInTex, hInTex, colour);
+
+	if (rot == 0) {
+		for (uint32_t i = 0; i < count; i++) {
+			instances[i] = prototype;
+			instances[i].pos[0] = positions[i][0];
+			instances[i].pos[1] = positions[i][1];
+		}
+	} else {
+		// Rotated instances bake their position into the matrix (the shader applies pos before
+		// the matrix), so each copy just offsets the prototype's translation column
+		for (uint32_t i = 0; i < count; i++) {
+			instances[i] = prototype;
+			instances[i].model[12] += positions[i][0];
+			instances[i].model[13] += positions[i][1];
+		}
+	}
 }
\ No newline at end of file
@@ -16,14 +16,30 @@ void _vk2dRendererAddTarget(VK2DTexture tex);
 // Called when a render-target texture is destroyed so the renderer can remove it from its list
 void _vk2dRendererRemoveTarget(VK2DTexture tex);
 
+// Returns a depth attachment shared with every other same-size render target, creating it
+// if this is the first - safe to share because depth contents never survive a render pass
+VK2DImage _vk2dRendererGetSharedDepthBuffer(uint32_t w, uint32_t h);
+
+// Drops a reference on a shared depth attachment, destroying it once no target uses it
+void _vk2dRendererReleaseSharedDepthBuffer(VK2DImage img);
+
+// Gives a texture a slot in the bindless array and writes its image into it (no-op if unsupported)
+void _vk2dRendererAddTextureToArray(VK2DTexture tex);
+
+// Frees a texture's slot in the bindless array so it can be reused
+void _vk2dRendererRemoveTextureFromArray(VK2DTexture tex);
+
 // This is used when changing the render target to make sure the texture is either ready to be drawn itself or rendered to
 void _vk2dTransitionImageLayout(VkImage img, VkImageLayout old, VkImageLayout new);
 
+// Same as _vk2dTransitionImageLayout but moves several images in a single pipeline barrier
+void _vk2dTransitionImageLayouts(VkImage *imgs, VkImageLayout *old, VkImageLayout *new, uint32_t count);
+
 // Rebuilds the matrices for a given buffer and camera
 void _vk2dCameraUpdateUBO(VK2DUniformBufferObject *ubo, VK2DCameraSpec *camera);
 
 // Flushes the data from a ubo to its respective buffer, frame being the swapchain buffer to flush
-void _vk2dRendererFlushUBOBuffer(uint32_t frame, uint32_t descriptorFrame, int camera);
+void _vk2dRendererFlushUBOBuffer(uint32_t frame, int camera);
 
 // Grabs a preferred present mode if available returning FIFO if its unavailable
 VkPresentModeKHR _vk2dRendererGetPresentMode(VkPresentModeKHR mode);
@@ -40,6 +56,41 @@ uint64_t _vk2dHashSets(VkDescriptorSet *sets, uint32_t setCount);
 // Resets the bound pipeline information
 void _vk2dRendererResetBoundPointers();
 
+// Queues a resource to be destroyed with freeFunc once the frame currently being
+// recorded has retired on the GPU, returning false if the renderer can't defer it
+// (in which case the caller should just destroy the resource itself)
+bool _vk2dRendererDeferFree(void (*freeFunc)(void*), void *resource);
+
+// Destroys every resource waiting on the given frame slot, called once its fence has been waited on
+void _vk2dRendererProcessDeferredFrees(uint32_t frame);
+
+// Bump-allocates transient memory that lives until the next start-of-frame, never
+// hold one of these pointers across vk2dRendererStartFrame
+void *vk2dFrameAlloc(uint32_t size);
+
+// Recycles everything handed out by vk2dFrameAlloc since the last reset, growing the
+// arena if allocations spilled to the heap - called at the top of every frame
+void _vk2dRendererResetFrameArena();
+
+// Returns the command buffer the calling thread should record into - the primary draw
+// buffer normally, or the thread's secondary buffer when one is activated - and reports
+// which it was (draws into secondary buffers can't use the renderer's bind elision)
+VkCommandBuffer _vk2dRendererGetRecordingBuffer(bool *secondary);
+
+// Returns true if the calling thread is recording into a secondary command buffer
+bool _vk2dRendererThreadOnSecondary();
+
+// Ends every active secondary command buffer and executes them in the primary buffer,
+// must be called from the main thread while the slots' render target is still current
+void _vk2dRendererExecuteParallelWork();
+
+// Writes a timestamp into the frame's profiling queries tagged with the pipeline that
+// runs after it (a VK2DPipelineTime value), only call on the primary command buffer
+void _vk2dRendererRecordTimestamp(VkCommandBuffer buf, int pipelineTime);
+
+// Reads back a retired frame slot's timestamps and rebuilds the GPU profile from them
+void _vk2dRendererResolveGpuProfile(uint32_t frame);
+
 // Gets the size of the rendered surface
 void _vk2dRendererGetSurfaceSize();
 
@@ -51,16 +102,22 @@ void _vk2dRendererCreateWindowSurface();
 void _vk2dRendererDestroyWindowSurface();
 void _vk2dRendererCreateSwapchain();
 void _vk2dRendererDestroySwapchain();
+void _vk2dRendererCreateHeadlessImages();
+void _vk2dRendererDestroyHeadlessImages();
 void _vk2dRendererCreateDepthBuffer();
 void _vk2dRendererDestroyDepthBuffer();
 void _vk2dRendererCreateDescriptorBuffers();
 void _vk2dRendererDestroyDescriptorBuffers();
+void _vk2dRendererCreateTextureArray();
+void _vk2dRendererDestroyTextureArray();
 void _vk2dRendererCreateColourResources();
 void _vk2dRendererDestroyColourResources();
 void _vk2dRendererCreateRenderPass();
 void _vk2dRendererDestroyRenderPass();
 void _vk2dRendererCreateDescriptorSetLayouts();
 void _vk2dRendererDestroyDescriptorSetLayout();
+void _vk2dRendererCreatePipelineCache();
+void _vk2dRendererDestroyPipelineCache();
 void _vk2dRendererCreatePipelines();
 void _vk2dRendererDestroyPipelines(bool preserveCustomPipes);
 void _vk2dRendererCreateFrameBuffer();
@@ -71,6 +128,8 @@ void _vk2dRendererCreateDescriptorPool(bool preserveDescCons);
 void _vk2dRendererDestroyDescriptorPool(bool preserveDescCons);
 void _vk2dRendererCreateSynchronization();
 void _vk2dRendererDestroySynchronization();
+void _vk2dRendererCreateGpuProfiling();
+void _vk2dRendererDestroyGpuProfiling();
 void _vk2dRendererCreateSampler();
 void _vk2dRendererDestroySampler();
 void _vk2dRendererCreateUnits();
@@ -84,9 +143,14 @@ void _vk2dRendererResetSwapchain();
 void _vk2dRendererDrawRaw(VkDescriptorSet *sets, uint32_t setCount, VK2DPolygon poly, VK2DPipeline pipe, float x, float y, float xscale, float yscale, float rot, float originX, float originY, float lineWidth, float xInTex, float yInTex, float texWidth, float texHeight, VK2DCameraIndex cam);
 void _vk2dRendererDrawRawInstanced(VkDescriptorSet *sets, uint32_t setCount, VK2DDrawInstance *instances, int count, VK2DCameraIndex cam);
 void _vk2dRendererDrawInstanced(VkDescriptorSet *sets, uint32_t setCount, VK2DDrawInstance *instances, int count);
+void _vk2dRendererDrawRawInstancedIndirect(VkDescriptorSet *sets, uint32_t setCount, VK2DBuffer instances, VK2DBuffer commands, VkDeviceSize commandOffset, uint32_t drawCount, VK2DCameraIndex cam);
+void _vk2dRendererDrawInstancedIndirect(VkDescriptorSet *sets, uint32_t setCount, VK2DBuffer instances, VK2DBuffer commands, VkDeviceSize commandOffset, uint32_t drawCount);
 void _vk2dRendererDraw(VkDescriptorSet *sets, uint32_t setCount, VK2DPolygon poly, VK2DPipeline pipe, float x, float y, float xscale, float yscale, float rot, float originX, float originY, float lineWidth, float xInTex, float yInTex, float texWidth, float texHeight);
 void _vk2dRendererDrawRaw3D(VkDescriptorSet *sets, uint32_t setCount, VK2DModel model, VK2DPipeline pipe, float x, float y, float z, float xscale, float yscale, float zscale, float rot, vec3 axis, float originX, float originY, float originZ, VK2DCameraIndex cam, float lineWidth);
 void _vk2dRendererDraw3D(VkDescriptorSet *sets, uint32_t setCount, VK2DModel model, VK2DPipeline pipe, float x, float y, float z, float xscale, float yscale, float zscale, float rot, vec3 axis, float originX, float originY, float originZ, float lineWidth);
+void _vk2dRendererDrawShapes(VK2DVertexColour *vertices, uint32_t count);
+void _vk2dRendererDrawRaw3DInstanced(VkDescriptorSet *sets, uint32_t setCount, VK2DModel model, VK2DPipeline pipe, mat4 *transforms, uint32_t count, VK2DCameraIndex cam);
+void _vk2dRendererDraw3DInstanced(VkDescriptorSet *sets, uint32_t setCount, VK2DModel model, VK2DPipeline pipe, mat4 *transforms, uint32_t count);
 
 #ifdef __cplusplus
 }
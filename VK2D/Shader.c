@@ -1,151 +1,238 @@
-/// \file Shader.c
-/// \author Paolo Mazzon
-#include "VK2D/Shader.h"
-#include "VK2D/Pipeline.h"
-#include "VK2D/Renderer.h"
-#include "VK2D/Buffer.h"
-#include "VK2D/LogicalDevice.h"
-#include "VK2D/Validation.h"
-#include "VK2D/DescriptorControl.h"
-#include "VK2D/Util.h"
-#include "VK2D/Opaque.h"
-#include <malloc.h>
-
-void _vk2dRendererAddShader(VK2DShader shader);
-void _vk2dRendererRemoveShader(VK2DShader shader);
-unsigned char* _vk2dLoadFile(const char *filename, uint32_t *size);
-VkPipelineVertexInputStateCreateInfo _vk2dGetTextureVertexInputState();
-
-void _vk2dShaderBuildPipe(VK2DShader shader) {
-	VK2DRenderer renderer = vk2dRendererGetPointer();
-	VkPipelineVertexInputStateCreateInfo textureVertexInfo = _vk2dGetTextureVertexInputState();
-
-	VkDescriptorSetLayout layout[] = {renderer->dslBufferVP, renderer->dslSampler, renderer->dslTexture, renderer->dslBufferUser};
-	uint32_t layoutCount;
-	if (shader->uniformSize != 0) {
-		layoutCount = 4;
-	} else {
-		layoutCount = 3;
-	}
-	shader->pipe = vk2dPipelineCreate(
-			renderer->ld,
-			renderer->renderPass,
-			renderer->surfaceWidth,
-			renderer->surfaceHeight,
-			shader->spvVert,
-			shader->spvVertSize,
-			shader->spvFrag,
-			shader->spvFragSize,
-			layout,
-			layoutCount,
-			&textureVertexInfo,
-			true,
-			renderer->config.msaa,
-			false);
-}
-
-VK2DShader vk2dShaderFrom(uint8_t *vertexShaderBuffer, int vertexShaderBufferSize, uint8_t *fragmentShaderBuffer, int fragmentShaderBufferSize, uint32_t uniformBufferSize) {
-	VK2DRenderer gRenderer = vk2dRendererGetPointer();
-	if (uniformBufferSize % 4 != 0) {
-		vk2dLogMessage("Uniform buffer size for shader is invalid, must be multiple of 4");
-		return NULL;
-	} else if (uniformBufferSize > gRenderer->limits.maxShaderBufferSize) {
-		vk2dLogMessage("Uniform buffer of size %i is greater than the maximum allowed uniform buffer size of %i from vk2dRendererGetLimits", uniformBufferSize, gRenderer->limits.maxShaderBufferSize);
-		return NULL;
-	}
-
-	VK2DShader out = malloc(sizeof(struct VK2DShader_t));
-	int i;
-	VK2DRenderer renderer = vk2dRendererGetPointer();
-	uint8_t *vertFile = _vk2dCopyBuffer(vertexShaderBuffer, vertexShaderBufferSize);
-	uint8_t *fragFile = _vk2dCopyBuffer(fragmentShaderBuffer, fragmentShaderBufferSize);
-	VK2DLogicalDevice dev = vk2dRendererGetDevice();
-
-	if (vk2dRendererGetPointer() != NULL) {
-		if (vk2dPointerCheck(out) && vk2dPointerCheck((void*)vertFile) && vk2dPointerCheck((void*)fragFile)) {
-			out->spvFrag = fragFile;
-			out->spvVert = vertFile;
-			out->spvVertSize = vertexShaderBufferSize;
-			out->spvFragSize = fragmentShaderBufferSize;
-			out->uniformSize = uniformBufferSize;
-			out->dev = dev;
-
-			if (uniformBufferSize != 0) {
-				for (i = 0; i < VK2D_MAX_FRAMES_IN_FLIGHT && uniformBufferSize > 0; i++) {
-					out->descCons[i] = vk2dDescConCreate(dev, renderer->dslBufferUser, 3, VK2D_NO_LOCATION, VK2D_NO_LOCATION);
-				}
-			}
-
-			SDL_LockMutex(dev->shaderMutex);
-			_vk2dRendererAddShader(out);
-			_vk2dShaderBuildPipe(out);
-			SDL_UnlockMutex(dev->shaderMutex);
-		}
-	} else {
-		free(out);
-		out = NULL;
-		vk2dLogMessage("Renderer is not initialized");
-	}
-
-	return out;
-}
-
-VK2DShader vk2dShaderLoad(const char *vertexShader, const char *fragmentShader, uint32_t uniformBufferSize) {
-	VK2DRenderer gRenderer = vk2dRendererGetPointer();
-	if (uniformBufferSize % 4 != 0) {
-		vk2dLogMessage("Uniform buffer size for shader \"%s\"/\"%s\" is invalid, must be multiple of 4", vertexShader, fragmentShader);
-		return NULL;
-	} else if (uniformBufferSize > gRenderer->limits.maxShaderBufferSize) {
-		vk2dLogMessage("Uniform buffer of size %i is greater than the maximum allowed uniform buffer size of %i from vk2dRendererGetLimits", uniformBufferSize, gRenderer->limits.maxShaderBufferSize);
-		return NULL;
-	}
-
-	VK2DShader out = malloc(sizeof(struct VK2DShader_t));
-	uint32_t vertFileSize, fragFileSize, i;
-	VK2DRenderer renderer = vk2dRendererGetPointer();
-	uint8_t *vertFile = _vk2dLoadFile(vertexShader, &vertFileSize);
-	uint8_t *fragFile = _vk2dLoadFile(fragmentShader, &fragFileSize);
-	VK2DLogicalDevice dev = vk2dRendererGetDevice();
-
-	if (vk2dRendererGetPointer() != NULL) {
-		if (vk2dPointerCheck(out) && vk2dPointerCheck((void*)vertFile) && vk2dPointerCheck((void*)fragFile)) {
-			out->spvFrag = fragFile;
-			out->spvVert = vertFile;
-			out->spvVertSize = vertFileSize;
-			out->spvFragSize = fragFileSize;
-			out->uniformSize = uniformBufferSize;
-			out->dev = dev;
-
-			if (uniformBufferSize != 0) {
-				for (i = 0; i < VK2D_MAX_FRAMES_IN_FLIGHT && uniformBufferSize > 0; i++) {
-					out->descCons[i] = vk2dDescConCreate(dev, renderer->dslBufferUser, 3, VK2D_NO_LOCATION, VK2D_NO_LOCATION);
-				}
-			}
-
-			SDL_LockMutex(dev->shaderMutex);
-			_vk2dRendererAddShader(out);
-			_vk2dShaderBuildPipe(out);
-			SDL_UnlockMutex(dev->shaderMutex);
-		}
-	} else {
-		free(out);
-		out = NULL;
-		vk2dLogMessage("Renderer is not initialized");
-	}
-
-	return out;
-}
-
-void vk2dShaderFree(VK2DShader shader) {
-	uint32_t i;
-	if (vk2dRendererGetPointer() != NULL)
-		_vk2dRendererRemoveShader(shader);
-	if (shader != NULL) {
-		vk2dPipelineFree(shader->pipe);
-
-		for (i = 0; i < VK2D_MAX_FRAMES_IN_FLIGHT && shader->uniformSize != 0; i++)
-			vk2dDescConFree(shader->descCons[i]);
-		free(shader->spvVert);
-		free(shader->spvFrag);
-	}
+/// \file Shader.c
+/// \author Paolo Mazzon
+#include "VK2D/Shader.h"
+#include "VK2D/Pipeline.h"
+#include "VK2D/Renderer.h"
+#include "VK2D/Buffer.h"
+#include "VK2D/LogicalDevice.h"
+#include "VK2D/Validation.h"
+#include "VK2D/DescriptorControl.h"
+#include "VK2D/Util.h"
+#include "VK2D/Opaque.h"
+#include <malloc.h>
+#include <string.h>
+#ifdef VK2D_ENABLE_SHADERC
+#include <shaderc/shaderc.h>
+#endif
+
+void _vk2dRendererAddShader(VK2DShader shader);
+void _vk2dRendererRemoveShader(VK2DShader shader);
+unsigned char* _vk2dLoadFile(const char *filename, uint32_t *size);
+VkPipelineVertexInputStateCreateInfo _vk2dGetTextureVertexInputState();
+
+void _vk2dShaderBuildPipe(VK2DShader shader) {
+	VK2DRenderer renderer = vk2dRendererGetPointer();
+	VkPipelineVertexInputStateCreateInfo textureVertexInfo = _vk2dGetTextureVertexInputState();
+
+	VkDescriptorSetLayout layout[] = {renderer->dslBufferVP, renderer->dslSampler, renderer->dslTexture, renderer->dslBufferUser, renderer->dslTextureArray};
+	uint32_t layoutCount;
+	if (renderer->limits.supportsTextureArray) {
+		// The bindless texture array always sits at set 4 so shader authors get a stable number
+		layoutCount = 5;
+	} else if (shader->uniformSize != 0) {
+		layoutCount = 4;
+	} else {
+		layoutCount = 3;
+	}
+	shader->pipe = vk2dPipelineCreate(
+			renderer->ld,
+			renderer->renderPass,
+			renderer->surfaceWidth,
+			renderer->surfaceHeight,
+			shader->spvVert,
+			shader->spvVertSize,
+			shader->spvFrag,
+			shader->spvFragSize,
+			layout,
+			layoutCount,
+			&textureVertexInfo,
+			true,
+			renderer->config.msaa,
+			false);
+}
+
+static int _vk2dShaderBuildThread(void *data) {
+	VK2DShader shader = data;
+	SDL_LockMutex(shader->dev->shaderMutex);
+	_vk2dShaderBuildPipe(shader);
+	SDL_UnlockMutex(shader->dev->shaderMutex);
+	shader->pipeReady = true;
+	return 0;
+}
+
+// Kicks the pipeline build onto a background thread so shader creation doesn't hitch the
+// frame, falling back to building inline if the thread can't be started
+static void _vk2dShaderStartBuild(VK2DShader shader) {
+	shader->pipe = NULL;
+	shader->pipeReady = false;
+	shader->buildThread = SDL_CreateThread(_vk2dShaderBuildThread, "VK2D_Shader", shader);
+	if (shader->buildThread == NULL) {
+		SDL_LockMutex(shader->dev->shaderMutex);
+		_vk2dShaderBuildPipe(shader);
+		SDL_UnlockMutex(shader->dev->shaderMutex);
+		shader->pipeReady = true;
+	}
+}
+
+void _vk2dShaderJoinBuild(VK2DShader shader) {
+	if (shader->buildThread != NULL) {
+		int status;
+		SDL_WaitThread(shader->buildThread, &status);
+		shader->buildThread = NULL;
+	}
+}
+
+VK2DShader vk2dShaderFrom(uint8_t *vertexShaderBuffer, int vertexShaderBufferSize, uint8_t *fragmentShaderBuffer, int fragmentShaderBufferSize, uint32_t uniformBufferSize) {
+	VK2DRenderer gRenderer = vk2dRendererGetPointer();
+	if (uniformBufferSize % 4 != 0) {
+		vk2dLogMessage("Uniform buffer size for shader is invalid, must be multiple of 4");
+		return NULL;
+	} else if (uniformBufferSize > gRenderer->limits.maxShaderBufferSize) {
+		vk2dLogMessage("Uniform buffer of size %i is greater than the maximum allowed uniform buffer size of %i from vk2dRendererGetLimits", uniformBufferSize, gRenderer->limits.maxShaderBufferSize);
+		return NULL;
+	}
+
+	VK2DShader out = malloc(sizeof(struct VK2DShader_t));
+	int i;
+	VK2DRenderer renderer = vk2dRendererGetPointer();
+	uint8_t *vertFile = _vk2dCopyBuffer(vertexShaderBuffer, vertexShaderBufferSize);
+	uint8_t *fragFile = _vk2dCopyBuffer(fragmentShaderBuffer, fragmentShaderBufferSize);
+	VK2DLogicalDevice dev = vk2dRendererGetDevice();
+
+	if (vk2dRendererGetPointer() != NULL) {
+		if (vk2dPointerCheck(out) && vk2dPointerCheck((void*)vertFile) && vk2dPointerCheck((void*)fragFile)) {
+			out->spvFrag = fragFile;
+			out->spvVert = vertFile;
+			out->spvVertSize = vertexShaderBufferSize;
+			out->spvFragSize = fragmentShaderBufferSize;
+			out->uniformSize = uniformBufferSize;
+			out->dev = dev;
+
+			// Bindless-capable hosts always get user sets so the texture array can bind contiguously at set 4
+			if (uniformBufferSize != 0 || renderer->limits.supportsTextureArray) {
+				for (i = 0; i < VK2D_MAX_FRAMES_IN_FLIGHT; i++) {
+					out->descCons[i] = i < renderer->framesInFlight ? vk2dDescConCreate(dev, renderer->dslBufferUser, 3, VK2D_NO_LOCATION, VK2D_NO_LOCATION) : NULL;
+				}
+			}
+
+			SDL_LockMutex(dev->shaderMutex);
+			_vk2dRendererAddShader(out);
+			SDL_UnlockMutex(dev->shaderMutex);
+			_vk2dShaderStartBuild(out);
+		}
+	} else {
+		free(out);
+		out = NULL;
+		vk2dLogMessage("Renderer is not initialized");
+	}
+
+	return out;
+}
+
+VK2DShader vk2dShaderLoad(const char *vertexShader, const char *fragmentShader, uint32_t uniformBufferSize) {
+	VK2DRenderer gRenderer = vk2dRendererGetPointer();
+	if (uniformBufferSize % 4 != 0) {
+		vk2dLogMessage("Uniform buffer size for shader \"%s\"/\"%s\" is invalid, must be multiple of 4", vertexShader, fragmentShader);
+		return NULL;
+	} else if (uniformBufferSize > gRenderer->limits.maxShaderBufferSize) {
+		vk2dLogMessage("Uniform buffer of size %i is greater than the maximum allowed uniform buffer size of %i from vk2dRendererGetLimits", uniformBufferSize, gRenderer->limits.maxShaderBufferSize);
+		return NULL;
+	}
+
+	VK2DShader out = malloc(sizeof(struct VK2DShader_t));
+	uint32_t vertFileSize, fragFileSize, i;
+	VK2DRenderer renderer = vk2dRendererGetPointer();
+	uint8_t *vertFile = _vk2dLoadFile(vertexShader, &vertFileSize);
+	uint8_t *fragFile = _vk2dLoadFile(fragmentShader, &fragFileSize);
+	VK2DLogicalDevice dev = vk2dRendererGetDevice();
+
+	if (vk2dRendererGetPointer() != NULL) {
+		if (vk2dPointerCheck(out) && vk2dPointerCheck((void*)vertFile) && vk2dPointerCheck((void*)fragFile)) {
+			out->spvFrag = fragFile;
+			out->spvVert = vertFile;
+			out->spvVertSize = vertFileSize;
+			out->spvFragSize = fragFileSize;
+			out->uniformSize = uniformBufferSize;
+			out->dev = dev;
+
+			// Bindless-capable hosts always get user sets so the texture array can bind contiguously at set 4
+			if (uniformBufferSize != 0 || renderer->limits.supportsTextureArray) {
+				for (i = 0; i < VK2D_MAX_FRAMES_IN_FLIGHT; i++) {
+					out->descCons[i] = i < renderer->framesInFlight ? vk2dDescConCreate(dev, renderer->dslBufferUser, 3, VK2D_NO_LOCATION, VK2D_NO_LOCATION) : NULL;
+				}
+			}
+
+			SDL_LockMutex(dev->shaderMutex);
+			_vk2dRendererAddShader(out);
+			SDL_UnlockMutex(dev->shaderMutex);
+			_vk2dShaderStartBuild(out);
+		}
+	} else {
+		free(out);
+		out = NULL;
+		vk2dLogMessage("Renderer is not initialized");
+	}
+
+	return out;
+}
+
+void vk2dShaderFree(VK2DShader shader) {
+	uint32_t i;
+	VK2DRenderer renderer = vk2dRendererGetPointer();
+	if (renderer != NULL)
+		_vk2dRendererRemoveShader(shader);
+	if (shader != NULL) {
+		_vk2dShaderJoinBuild(shader);
+		vk2dPipelineFree(shader->pipe);
+
+		bool hasDescCons = shader->uniformSize != 0 || (renderer != NULL && renderer->limits.supportsTextureArray);
+		for (i = 0; i < VK2D_MAX_FRAMES_IN_FLIGHT && hasDescCons; i++)
+			vk2dDescConFree(shader->descCons[i]);
+		free(shader->spvVert);
+		free(shader->spvFrag);
+	}
+}
+
+bool vk2dShaderIsReady(VK2DShader shader) {
+	if (shader != NULL)
+		return shader->pipeReady;
+	return false;
+}
+
+#ifdef VK2D_ENABLE_SHADERC
+static uint8_t *_vk2dCompileGLSL(const char *source, shaderc_shader_kind kind, const char *name, uint32_t *size) {
+	uint8_t *out = NULL;
+	shaderc_compiler_t compiler = shaderc_compiler_initialize();
+	shaderc_compile_options_t options = shaderc_compile_options_initialize();
+	shaderc_compile_options_set_optimization_level(options, shaderc_optimization_level_performance);
+	shaderc_compilation_result_t result = shaderc_compile_into_spv(compiler, source, strlen(source), kind, name, "main", options);
+	if (shaderc_result_get_compilation_status(result) == shaderc_compilation_status_success) {
+		*size = (uint32_t)shaderc_result_get_length(result);
+		out = _vk2dCopyBuffer((void*)shaderc_result_get_bytes(result), *size);
+	} else {
+		vk2dLogMessage("Failed to compile %s,\n%s", name, shaderc_result_get_error_message(result));
+	}
+	shaderc_result_release(result);
+	shaderc_compile_options_release(options);
+	shaderc_compiler_release(compiler);
+	return out;
+}
+#endif
+
+VK2DShader vk2dShaderCompile(const char *vertexGLSL, const char *fragmentGLSL, uint32_t uniformBufferSize) {
+#ifdef VK2D_ENABLE_SHADERC
+	uint32_t vertSize = 0;
+	uint32_t fragSize = 0;
+	uint8_t *vert = _vk2dCompileGLSL(vertexGLSL, shaderc_glsl_vertex_shader, "vertex shader", &vertSize);
+	uint8_t *frag = _vk2dCompileGLSL(fragmentGLSL, shaderc_glsl_fragment_shader, "fragment shader", &fragSize);
+	VK2DShader out = NULL;
+	if (vert != NULL && frag != NULL)
+		out = vk2dShaderFrom(vert, vertSize, frag, fragSize, uniformBufferSize);
+	free(vert);
+	free(frag);
+	return out;
+#else
+	vk2dLogMessage("VK2D was built without runtime shader compilation, define VK2D_ENABLE_SHADERC and link against shaderc to use vk2dShaderCompile");
+	return NULL;
+#endif
 }
\ No newline at end of file
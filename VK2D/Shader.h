@@ -55,6 +55,28 @@ VK2DShader vk2dShaderLoad(const char *vertexShader, const char *fragmentShader,
 /// At the top of both shaders.
 VK2DShader vk2dShaderFrom(uint8_t *vertexShaderBuffer, int vertexShaderBufferSize, uint8_t *fragmentShaderBuffer, int fragmentShaderBufferSize, uint32_t uniformBufferSize);
 
+/// \brief Creates a shader from GLSL source, compiling it to SPIR-V at runtime
+/// \param vertexGLSL Null-terminated string containing GLSL vertex shader source
+/// \param fragmentGLSL Null-terminated string containing GLSL fragment shader source
+/// \param uniformBufferSize Size of the shader's expected uniform buffer (0 is valid)
+/// \return Returns a new shader or NULL
+/// \warning Only available when VK2D is built with VK2D_ENABLE_SHADERC defined and linked
+/// against shaderc, otherwise this logs an error and returns NULL
+///
+/// The same layout requirements as vk2dShaderLoad apply. This is intended for hot-reload
+/// workflows during development; ship precompiled SPIR-V for release builds so players
+/// don't pay the compile cost (or need shaderc present).
+VK2DShader vk2dShaderCompile(const char *vertexGLSL, const char *fragmentGLSL, uint32_t uniformBufferSize);
+
+/// \brief Returns true once a shader's pipeline has finished building
+/// \param shader Shader to query (NULL is valid and returns false)
+/// \return Returns whether the shader is ready to draw with its own pipeline
+///
+/// Shader pipelines build on a background thread so creating a shader mid-game doesn't
+/// hitch the frame. Drawing with a shader that isn't ready yet is safe - it falls back
+/// to the stock texture pipeline (ignoring the uniform buffer) until the build finishes.
+bool vk2dShaderIsReady(VK2DShader shader);
+
 /// \brief Frees a shader from memory
 /// \param shader Shader to free
 void vk2dShaderFree(VK2DShader shader);
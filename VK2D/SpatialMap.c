@@ -0,0 +1,297 @@
+/// \file SpatialMap.c
+/// \author Paolo Mazzon
+#include "VK2D/SpatialMap.h"
+#include "VK2D/Renderer.h"
+#include "VK2D/Validation.h"
+#include "VK2D/Opaque.h"
+#include <malloc.h>
+#include <string.h>
+#include <math.h>
+
+// Visible entries are gathered into the renderer's per-frame bump arena
+void *vk2dFrameAlloc(uint32_t size);
+
+static const uint32_t VK2D_SPATIAL_STARTING_CELLS = 256;   // Cell hash capacity at creation, always a power of two
+static const uint32_t VK2D_SPATIAL_STARTING_SLOTS = 256;   // Handle table size at creation
+static const uint32_t VK2D_SPATIAL_STARTING_ENTRIES = 8;   // Entry list size when a cell first fills
+static const float VK2D_SPATIAL_DEFAULT_CELL_SIZE = 256;
+
+// Packs a cell's grid coordinates into one hashable key
+static inline int64_t _vk2dSpatialKey(float x, float y, float cellSize) {
+	int64_t cx = (int64_t)floorf(x / cellSize);
+	int64_t cy = (int64_t)floorf(y / cellSize);
+	return (cx << 32) | (cy & 0xFFFFFFFF);
+}
+
+static inline uint32_t _vk2dSpatialHash(int64_t key, uint32_t listSize) {
+	return (uint32_t)(((uint64_t)key * 0x9E3779B97F4A7C15) >> 32) & (listSize - 1);
+}
+
+// Finds a cell's hash slot, claiming an empty one for it when create is set - the table
+// grows before it can fill so the probe always terminates
+static _VK2DSpatialCell *_vk2dSpatialMapFindCell(VK2DSpatialMap map, int64_t key, bool create);
+
+// Doubles the cell hash and re-buckets every occupied cell
+static bool _vk2dSpatialMapGrowCells(VK2DSpatialMap map) {
+	_VK2DSpatialCell *oldCells = map->cells;
+	uint32_t oldListSize = map->cellListSize;
+	_VK2DSpatialCell *newCells = calloc(map->cellListSize * 2, sizeof(_VK2DSpatialCell));
+	if (!vk2dPointerCheck(newCells))
+		return false;
+	map->cells = newCells;
+	map->cellListSize *= 2;
+	for (uint32_t i = 0; i < oldListSize; i++) {
+		if (oldCells[i].used) {
+			_VK2DSpatialCell *cell = _vk2dSpatialMapFindCell(map, oldCells[i].key, true);
+			uint64_t stamp = cell->stamp;
+			*cell = oldCells[i];
+			cell->stamp = stamp;
+		}
+	}
+	free(oldCells);
+	return true;
+}
+
+static _VK2DSpatialCell *_vk2dSpatialMapFindCell(VK2DSpatialMap map, int64_t key, bool create) {
+	uint32_t index = _vk2dSpatialHash(key, map->cellListSize);
+	while (map->cells[index].used && map->cells[index].key != key)
+		index = (index + 1) & (map->cellListSize - 1);
+	if (!map->cells[index].used) {
+		if (!create)
+			return NULL;
+		// Keep the table under 3/4 full so probes stay short
+		if ((map->cellCount + 1) * 4 >= map->cellListSize * 3) {
+			if (!_vk2dSpatialMapGrowCells(map))
+				return NULL;
+			return _vk2dSpatialMapFindCell(map, key, true);
+		}
+		map->cells[index].used = true;
+		map->cells[index].key = key;
+		map->cellCount += 1;
+	}
+	return &map->cells[index];
+}
+
+// Appends an entry to a cell, growing its lists if need be, returning its index or -1
+static int32_t _vk2dSpatialMapCellAppend(_VK2DSpatialCell *cell, VK2DDrawInstance *instance, int32_t handle) {
+	if (cell->count == cell->listSize) {
+		uint32_t newSize = cell->listSize == 0 ? VK2D_SPATIAL_STARTING_ENTRIES : cell->listSize * 2;
+		VK2DDrawInstance *newInstances = realloc(cell->instances, sizeof(VK2DDrawInstance) * newSize);
+		int32_t *newHandles = realloc(cell->handles, sizeof(int32_t) * newSize);
+		if (!vk2dPointerCheck(newInstances) || !vk2dPointerCheck(newHandles))
+			return -1;
+		cell->instances = newInstances;
+		cell->handles = newHandles;
+		cell->listSize = newSize;
+	}
+	cell->instances[cell->count] = *instance;
+	cell->handles[cell->count] = handle;
+	return (int32_t)cell->count++;
+}
+
+// Swap-removes an entry from a cell, fixing the slot of whatever entry got moved
+static void _vk2dSpatialMapCellRemove(VK2DSpatialMap map, _VK2DSpatialCell *cell, uint32_t index) {
+	cell->count -= 1;
+	if (index != cell->count) {
+		cell->instances[index] = cell->instances[cell->count];
+		cell->handles[index] = cell->handles[cell->count];
+		map->slots[cell->handles[index]].index = index;
+	}
+}
+
+VK2DSpatialMap vk2dSpatialMapCreate(VK2DTexture tex, float cellSize) {
+	VK2DSpatialMap map = NULL;
+
+	if (vk2dRendererGetPointer() != NULL) {
+		map = calloc(1, sizeof(struct VK2DSpatialMap_t));
+		if (vk2dPointerCheck(map)) {
+			map->tex = tex;
+			map->cellSize = cellSize > 0 ? cellSize : VK2D_SPATIAL_DEFAULT_CELL_SIZE;
+			map->cells = calloc(VK2D_SPATIAL_STARTING_CELLS, sizeof(_VK2DSpatialCell));
+			map->cellListSize = VK2D_SPATIAL_STARTING_CELLS;
+			map->slots = calloc(VK2D_SPATIAL_STARTING_SLOTS, sizeof(_VK2DSpatialSlot));
+			map->freeSlots = malloc(sizeof(int32_t) * VK2D_SPATIAL_STARTING_SLOTS);
+			map->slotListSize = VK2D_SPATIAL_STARTING_SLOTS;
+			if (!vk2dPointerCheck(map->cells) || !vk2dPointerCheck(map->slots) || !vk2dPointerCheck(map->freeSlots)) {
+				free(map->cells);
+				free(map->slots);
+				free(map->freeSlots);
+				free(map);
+				map = NULL;
+			} else {
+				// Every slot starts on the free stack, highest first so low handles go out first
+				for (int32_t i = 0; i < map->slotListSize; i++)
+					map->freeSlots[i] = map->slotListSize - 1 - i;
+				map->freeSlotCount = map->slotListSize;
+			}
+		}
+	} else {
+		vk2dLogMessage("Renderer is not initialized");
+	}
+
+	return map;
+}
+
+int32_t vk2dSpatialMapAdd(VK2DSpatialMap map, float x, float y, float xscale, float yscale, float rot, float originX, float originY, float xInTex, float yInTex, float texWidth, float texHeight) {
+	if (map == NULL)
+		return -1;
+
+	// Grow the handle table if the free stack is empty
+	if (map->freeSlotCount == 0) {
+		int32_t newSize = map->slotListSize * 2;
+		_VK2DSpatialSlot *newSlots = realloc(map->slots, sizeof(_VK2DSpatialSlot) * newSize);
+		int32_t *newFree = realloc(map->freeSlots, sizeof(int32_t) * newSize);
+		if (!vk2dPointerCheck(newSlots) || !vk2dPointerCheck(newFree))
+			return -1;
+		map->slots = newSlots;
+		map->freeSlots = newFree;
+		for (int32_t i = newSize - 1; i >= map->slotListSize; i--)
+			map->freeSlots[map->freeSlotCount++] = i;
+		map->slotListSize = newSize;
+	}
+
+	VK2DDrawInstance instance;
+	vec4 colour;
+	vk2dRendererGetColourMod(colour);
+	if (rot != 0 || xscale != 1 || yscale != 1)
+		vk2dInstanceSet(&instance, x, y, xscale, yscale, rot, originX, originY, xInTex, yInTex, texWidth, texHeight, colour);
+	else
+		vk2dInstanceSetFast(&instance, x, y, xInTex, yInTex, texWidth, texHeight, colour);
+
+	int32_t handle = map->freeSlots[map->freeSlotCount - 1];
+	int64_t key = _vk2dSpatialKey(x, y, map->cellSize);
+	_VK2DSpatialCell *cell = _vk2dSpatialMapFindCell(map, key, true);
+	if (cell == NULL)
+		return -1;
+	int32_t index = _vk2dSpatialMapCellAppend(cell, &instance, handle);
+	if (index == -1)
+		return -1;
+	map->freeSlotCount -= 1;
+	map->slots[handle].used = true;
+	map->slots[handle].key = key;
+	map->slots[handle].index = index;
+	map->slots[handle].x = x;
+	map->slots[handle].y = y;
+	map->totalCount += 1;
+	return handle;
+}
+
+void vk2dSpatialMapUpdate(VK2DSpatialMap map, int32_t handle, float x, float y) {
+	if (map == NULL || handle < 0 || handle >= map->slotListSize || !map->slots[handle].used)
+		return;
+	_VK2DSpatialSlot *slot = &map->slots[handle];
+	_VK2DSpatialCell *cell = _vk2dSpatialMapFindCell(map, slot->key, false);
+
+	// Translation always rides the pos vector regardless of how the matrix was built
+	VK2DDrawInstance *instance = &cell->instances[slot->index];
+	instance->pos[0] += x - slot->x;
+	instance->pos[1] += y - slot->y;
+
+	int64_t key = _vk2dSpatialKey(x, y, map->cellSize);
+	if (key != slot->key) {
+		// Crossed a grid line, migrate the entry to its new cell
+		VK2DDrawInstance moved = *instance;
+		_vk2dSpatialMapCellRemove(map, cell, slot->index);
+		_VK2DSpatialCell *newCell = _vk2dSpatialMapFindCell(map, key, true);
+		if (newCell == NULL)
+			return;
+		int32_t index = _vk2dSpatialMapCellAppend(newCell, &moved, handle);
+		if (index == -1)
+			return;
+		slot->key = key;
+		slot->index = index;
+	}
+	slot->x = x;
+	slot->y = y;
+}
+
+void vk2dSpatialMapRemove(VK2DSpatialMap map, int32_t handle) {
+	if (map == NULL || handle < 0 || handle >= map->slotListSize || !map->slots[handle].used)
+		return;
+	_VK2DSpatialSlot *slot = &map->slots[handle];
+	_VK2DSpatialCell *cell = _vk2dSpatialMapFindCell(map, slot->key, false);
+	_vk2dSpatialMapCellRemove(map, cell, slot->index);
+	slot->used = false;
+	map->freeSlots[map->freeSlotCount++] = handle;
+	map->totalCount -= 1;
+}
+
+// Copies a cell's entries into the gather list once per pass
+static uint32_t _vk2dSpatialMapGatherCell(VK2DSpatialMap map, _VK2DSpatialCell *cell, VK2DDrawInstance *list, uint32_t count) {
+	if (cell != NULL && cell->stamp != map->stamp && cell->count > 0) {
+		cell->stamp = map->stamp;
+		memcpy(&list[count], cell->instances, sizeof(VK2DDrawInstance) * cell->count);
+		count += cell->count;
+	}
+	return count;
+}
+
+void vk2dSpatialMapDraw(VK2DSpatialMap map) {
+	VK2DRenderer gRenderer = vk2dRendererGetPointer();
+	if (gRenderer == NULL) {
+		vk2dLogMessage("Renderer is not initialized");
+		return;
+	}
+	if (map == NULL || map->totalCount == 0)
+		return;
+
+	VK2DDrawInstance *list = vk2dFrameAlloc(sizeof(VK2DDrawInstance) * map->totalCount);
+	if (!vk2dPointerCheck(list))
+		return;
+	uint32_t count = 0;
+	map->stamp += 1;
+
+	if (gRenderer->target != VK2D_TARGET_SCREEN && !gRenderer->enableTextureCameraUBO) {
+		// Texture targets have no camera bounds, the whole map draws like any instance list
+		for (uint32_t i = 0; i < map->cellListSize; i++)
+			if (map->cells[i].used)
+				count = _vk2dSpatialMapGatherCell(map, &map->cells[i], list, count);
+	} else {
+		for (int i = 0; i < VK2D_MAX_CAMERAS; i++) {
+			if (gRenderer->cameras[i].state != VK2D_CAMERA_STATE_NORMAL || gRenderer->cameras[i].spec.type != VK2D_CAMERA_TYPE_DEFAULT || (i != gRenderer->cameraLocked && gRenderer->cameraLocked != VK2D_INVALID_CAMERA))
+				continue;
+
+			// Conservative world bounds matching the renderer's own culling - the view is
+			// bounded by its diagonal so rotation and zoom can never cull a visible cell
+			VK2DCameraSpec *spec = &gRenderer->cameras[i].spec;
+			float zoom = spec->zoom > 0 ? spec->zoom : 1;
+			float cameraRadius = 0.5f * sqrtf((spec->w * spec->w) + (spec->h * spec->h)) / zoom;
+			float cameraX = spec->x + (spec->w * 0.5f);
+			float cameraY = spec->y + (spec->h * 0.5f);
+			int64_t minCellX = (int64_t)floorf((cameraX - cameraRadius) / map->cellSize);
+			int64_t maxCellX = (int64_t)floorf((cameraX + cameraRadius) / map->cellSize);
+			int64_t minCellY = (int64_t)floorf((cameraY - cameraRadius) / map->cellSize);
+			int64_t maxCellY = (int64_t)floorf((cameraY + cameraRadius) / map->cellSize);
+
+			// A camera spanning more cells than exist scans the hash directly instead
+			uint64_t cellSpan = (uint64_t)(maxCellX - minCellX + 1) * (uint64_t)(maxCellY - minCellY + 1);
+			if (cellSpan >= map->cellListSize) {
+				for (uint32_t j = 0; j < map->cellListSize; j++)
+					if (map->cells[j].used)
+						count = _vk2dSpatialMapGatherCell(map, &map->cells[j], list, count);
+			} else {
+				for (int64_t cy = minCellY; cy <= maxCellY; cy++)
+					for (int64_t cx = minCellX; cx <= maxCellX; cx++)
+						count = _vk2dSpatialMapGatherCell(map, _vk2dSpatialMapFindCell(map, (cx << 32) | (cy & 0xFFFFFFFF), false), list, count);
+			}
+		}
+	}
+
+	if (count > 0)
+		vk2dRendererDrawInstanced(map->tex, list, count);
+}
+
+void vk2dSpatialMapFree(VK2DSpatialMap map) {
+	if (map != NULL) {
+		for (uint32_t i = 0; i < map->cellListSize; i++) {
+			if (map->cells[i].used) {
+				free(map->cells[i].instances);
+				free(map->cells[i].handles);
+			}
+		}
+		free(map->cells);
+		free(map->slots);
+		free(map->freeSlots);
+		free(map);
+	}
+}
@@ -0,0 +1,74 @@
+/// \file SpatialMap.h
+/// \author Paolo Mazzon
+/// \brief Retained world-space sprites in a uniform grid so only visible cells are drawn
+#pragma once
+#include "VK2D/Structs.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// \brief Creates an empty spatial map
+/// \param tex Texture every entry samples from (use an atlas to cover many sprites)
+/// \param cellSize World-space width/height of a grid cell, 0 to default to 256
+/// \return Returns a new spatial map or NULL if it failed
+///
+/// A spatial map holds a large retained set of world-space sprites bucketed into a
+/// uniform grid. Drawing it only walks the cells a camera can see and feeds the
+/// survivors straight into the instanced path through the frame arena, so hundreds of
+/// thousands of mostly-offscreen entries cost nothing per frame instead of a full
+/// CPU rebuild. Pick a cell size in the neighbourhood of your camera's view so a
+/// screen covers a handful of cells - far smaller cells waste time walking the grid,
+/// far larger ones cull nothing.
+VK2DSpatialMap vk2dSpatialMapCreate(VK2DTexture tex, float cellSize);
+
+/// \brief Adds an entry to the map, parameters are the same as vk2dRendererDrawTexture
+/// \param map Map to add to
+/// \param x X position in the game world
+/// \param y Y position in the game world
+/// \param xscale Horizontal scale of the draw
+/// \param yscale Vertical scale of the draw
+/// \param rot Rotation of the draw in radians
+/// \param originX X origin to rotate about
+/// \param originY Y origin to rotate about
+/// \param xInTex X position in the texture to draw from
+/// \param yInTex Y position in the texture to draw from
+/// \param texWidth Width of the texture region to draw
+/// \param texHeight Height of the texture region to draw
+/// \return Returns a handle for later updates/removal, or -1 if it failed
+///
+/// The renderer's current colour mod is recorded with the entry.
+int32_t vk2dSpatialMapAdd(VK2DSpatialMap map, float x, float y, float xscale, float yscale, float rot, float originX, float originY, float xInTex, float yInTex, float texWidth, float texHeight);
+
+/// \brief Moves an entry to a new world position
+/// \param map Map the entry lives in
+/// \param handle Handle returned by vk2dSpatialMapAdd
+/// \param x New world x position
+/// \param y New world y position
+///
+/// This is cheap - the entry only changes cells when it actually crosses a grid line,
+/// so a few thousand moving entries among hundreds of thousands of static ones don't
+/// bring back the per-frame rebuild this container exists to avoid.
+void vk2dSpatialMapUpdate(VK2DSpatialMap map, int32_t handle, float x, float y);
+
+/// \brief Removes an entry from the map
+/// \param map Map the entry lives in
+/// \param handle Handle returned by vk2dSpatialMapAdd, invalid after this call
+void vk2dSpatialMapRemove(VK2DSpatialMap map, int32_t handle);
+
+/// \brief Draws every entry a camera could see in one instanced draw
+/// \param map Map to draw
+///
+/// Gathers the cells overlapping each active 2D camera (honouring camera locking) into
+/// a frame-arena list and submits it through vk2dRendererDrawInstanced, so per-entry
+/// culling against each camera still applies downstream when culling is enabled. When
+/// a texture target is bound the whole map draws, matching other instanced draws.
+void vk2dSpatialMapDraw(VK2DSpatialMap map);
+
+/// \brief Frees a spatial map from memory, does not free the texture
+/// \param map Map to free
+void vk2dSpatialMapFree(VK2DSpatialMap map);
+
+#ifdef __cplusplus
+};
+#endif
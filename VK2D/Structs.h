@@ -121,6 +121,9 @@ typedef enum {
 	VK2D_ASSET_TYPE_MODEL_MEMORY = 4,   ///< Load a model from a binary blob
 	VK2D_ASSET_TYPE_SHADER_FILE = 5,    ///< Load a shader from a filename
 	VK2D_ASSET_TYPE_SHADER_MEMORY = 6,  ///< Load a shader from a binary blob
+	VK2D_ASSET_TYPE_TEXTURE_BUNDLE = 7, ///< Load a texture from an entry in an open bundle
+	VK2D_ASSET_TYPE_MODEL_BUNDLE = 8,   ///< Load a model from an entry in an open bundle
+	VK2D_ASSET_TYPE_SHADER_BUNDLE = 9,  ///< Load a shader from entries in an open bundle
 } VK2DAssetType;
 
 /// \brief State an asset may be in
@@ -130,6 +133,14 @@ typedef enum {
 	VK2D_ASSET_TYPE_NONE = 2,    ///< This slot is empty
 } VK2DAssetState;
 
+/// \brief How much of a streamed texture currently lives in video memory
+typedef enum {
+	VK2D_TEXTURE_RESIDENCY_PLACEHOLDER = 0, ///< Only the tiny placeholder is resident, draws show a flat colour
+	VK2D_TEXTURE_RESIDENCY_LOADING = 1,     ///< The full image is decoding/uploading in the background
+	VK2D_TEXTURE_RESIDENCY_RESIDENT = 2,    ///< The full image is resident and draws sample it
+	VK2D_TEXTURE_RESIDENCY_MAX = 3          ///< Total number of residency states
+} VK2DTextureResidency;
+
 // VK2D pointers
 VK2D_OPAQUE_POINTER(VK2DRenderer)
 VK2D_OPAQUE_POINTER(VK2DImage)
@@ -141,8 +152,17 @@ VK2D_OPAQUE_POINTER(VK2DTexture)
 VK2D_OPAQUE_POINTER(VK2DDescCon)
 VK2D_OPAQUE_POINTER(VK2DPolygon)
 VK2D_OPAQUE_POINTER(VK2DShader)
+VK2D_OPAQUE_POINTER(VK2DComputeShader)
 VK2D_OPAQUE_POINTER(VK2DModel)
 VK2D_OPAQUE_POINTER(VK2DDescriptorBuffer)
+VK2D_OPAQUE_POINTER(VK2DAtlas)
+VK2D_OPAQUE_POINTER(VK2DParticleSystem)
+VK2D_OPAQUE_POINTER(VK2DDrawList)
+VK2D_OPAQUE_POINTER(VK2DTilemap)
+VK2D_OPAQUE_POINTER(VK2DBundle)
+VK2D_OPAQUE_POINTER(VK2DReadback)
+VK2D_OPAQUE_POINTER(VK2DFont)
+VK2D_OPAQUE_POINTER(VK2DSpatialMap)
 
 /// \brief 2D vector of floats
 typedef float vec2[2];
@@ -211,6 +231,18 @@ struct VK2DStartupOptions {
 	/// may draw in one call. By default this is ~250kb and you may leave it as 0
 	/// to default it to that value.
 	uint64_t vramPageSize;
+
+	/// File the renderer's pipeline cache is loaded from at startup and saved to at
+	/// shutdown, or NULL to keep the cache in memory only. Warm startups with a valid
+	/// cache file skip most of the pipeline compilation cost. Stale caches (for example
+	/// from another GPU or driver version) are detected and simply rebuilt.
+	const char *pipelineCacheFile;
+
+	/// How many frames may be recorded while earlier ones are still on the GPU, 1-3.
+	/// 1 minimizes input-to-photon latency at the cost of throughput, 3 is the
+	/// opposite. Leave as 0 to default to 3. See VK2DFrameStats for the latency
+	/// numbers to tune this against.
+	uint32_t maxFramesInFlight;
 };
 
 /// \brief User configurable settings
@@ -219,6 +251,8 @@ struct VK2DRendererConfig {
 	VK2DMSAA msaa;             ///< Current MSAA
 	VK2DScreenMode screenMode; ///< Current screen mode
 	VK2DFilterType filterMode; ///< How to filter textures -- Not change-able after renderer creation
+	bool enableMipmaps;        ///< Generate mip chains at texture load, sampled by 3D drawing -- Not change-able after renderer creation
+	float anisotropy;          ///< Max anisotropy for 3D sampling, values above 1 enable anisotropic filtering (clamped to device limits) -- Not change-able after renderer creation
 };
 
 /// \brief Camera information
@@ -256,8 +290,56 @@ struct VK2DRendererLimits {
 	float maxLineWidth;           ///< Maximum line width supported on the platform, if you specify a line width greater than this value, your requested line width will be clamped to this number
 	uint64_t maxInstancedDraws;   ///< Maximum amount of instances you may draw at once, if you request to draw more instances than this it will simply be capped to this number
 	uint64_t maxShaderBufferSize; ///< Maximum size of a shader's uniform buffer in bytes, if you attempt to create a shader with a uniform buffer size greater than this value NULL will be returned
+	bool supportsTextureArray;    ///< Whether or not the host supports the bindless texture array custom shaders can sample from, see vk2dTextureGetArrayIndex
 };
 
+/// \brief Pipelines the GPU profiler can attribute time to
+typedef enum {
+	VK2D_PIPELINE_TIME_NONE = 0,      ///< Time not spent in any user-facing pipeline (clears, copies, idle)
+	VK2D_PIPELINE_TIME_TEXTURE = 1,   ///< Single texture draws
+	VK2D_PIPELINE_TIME_INSTANCED = 2, ///< Instanced and batched texture draws
+	VK2D_PIPELINE_TIME_PRIMITIVE = 3, ///< Filled and outlined shapes
+	VK2D_PIPELINE_TIME_MODEL = 4,     ///< 3D models and wireframes
+	VK2D_PIPELINE_TIME_SHADER = 5,    ///< User shader draws
+	VK2D_PIPELINE_TIME_MAX = 6,       ///< Total number of pipeline time categories
+} VK2DPipelineTime;
+
+/// \brief GPU timing of a fully retired frame, see vk2dRendererGetGpuProfile
+struct VK2DGpuProfile {
+	double frameTimeMS;                            ///< Total GPU time the frame took in milliseconds
+	double pipelineTimeMS[VK2D_PIPELINE_TIME_MAX]; ///< GPU time attributed to each pipeline, indexed with VK2DPipelineTime
+};
+
+/// \brief CPU-side counters for a completed frame, see vk2dRendererGetFrameStats
+struct VK2DFrameStats {
+	uint32_t drawCalls;             ///< Draw commands recorded into the frame
+	uint32_t instancedDraws;        ///< How many of those draws were instanced
+	uint32_t instancesDrawn;        ///< Total instances across all instanced draws
+	uint32_t pipelineBindsTaken;    ///< Pipeline binds actually recorded
+	uint32_t pipelineBindsAvoided;  ///< Pipeline binds skipped because the right pipeline was already bound
+	uint64_t descriptorBufferBytes; ///< Bytes written through the frame's descriptor buffer
+	uint32_t descriptorBufferPages; ///< Pages the frame's descriptor buffer holds in total
+	double fenceWaitTimeMS;         ///< CPU time the frame spent blocked waiting on in-flight fences, in milliseconds
+	double acquireToPresentMS;      ///< Time from acquiring the frame's image to submitting its present, in milliseconds
+	double pacingTargetMS;          ///< Frame time the pacer was holding this frame to, 0 when pacing was off
+	double pacingSleepMS;           ///< CPU time the pacer slept after present to land on the frame's deadline
+	double pacingMissMS;            ///< How far past its deadline the frame finished, 0 when it made it
+};
+
+/// \brief Point-in-time snapshot of video memory usage, see vk2dRendererGetMemoryStats
+struct VK2DMemoryStats {
+	uint64_t allocationCount;                 ///< Live allocations (buffers and images) the renderer's allocator tracks
+	uint64_t allocationBytes;                 ///< Bytes occupied by those allocations
+	uint64_t blockBytes;                      ///< Bytes reserved in memory blocks, including block space not yet suballocated
+	uint64_t descriptorBufferBytes;           ///< Bytes reserved by the per-frame descriptor buffer pages across every frame slot
+	uint32_t heapCount;                       ///< Number of memory heaps on the device, the valid portion of the arrays below
+	uint64_t heapUsage[VK_MAX_MEMORY_HEAPS];  ///< Estimated bytes in use per heap, including usage outside this allocator
+	uint64_t heapBudget[VK_MAX_MEMORY_HEAPS]; ///< Bytes the driver estimates each heap can hold before allocations degrade or fail
+};
+
+/// \brief Called at the start of a frame for each memory heap whose usage exceeds its budget, see vk2dRendererSetMemoryBudgetCallback
+typedef void (*VK2DMemoryBudgetCallback)(uint32_t heapIndex, uint64_t usage, uint64_t budget, void *context);
+
 /// \brief Represents the data you need for each element in an instanced draw
 struct VK2DDrawInstance {
 	vec4 texturePos; ///< x in tex, y in tex, w in tex, and h in tex
@@ -266,6 +348,43 @@ struct VK2DDrawInstance {
 	mat4 model;      ///< Model for this instance, generally shouldn't contain translations
 };
 
+/// \brief Compact description of an instance, expanded to a full VK2DDrawInstance at draw time
+///
+/// This is a bit under half the size of VK2DDrawInstance because it stores the raw
+/// transform parameters instead of a model matrix, which makes large CPU-side instance
+/// arrays much cheaper to store and stream. Use it with vk2dRendererDrawInstancedCompact.
+struct VK2DDrawInstanceCompact {
+	vec4 texturePos; ///< x in tex, y in tex, w in tex, and h in tex
+	vec4 colour;     ///< Colour mod of this draw
+	vec2 pos;        ///< X/Y in game world for this instance
+	vec2 scale;      ///< X/Y scale of this instance
+	vec2 origin;     ///< X/Y origin the instance rotates about
+	float rotation;  ///< Rotation of this instance in radians
+};
+
+/// \brief Draw parameters for indirect draws, laid out exactly like VkDrawIndirectCommand
+///
+/// Bake these into a device buffer with vk2dBufferCreateStorage (or write them from a
+/// compute shader) and hand the buffer to vk2dRendererDrawInstancedIndirect.
+struct VK2DDrawCommand {
+	uint32_t vertexCount;   ///< Vertices per instance, always 6 for the instancing pipeline's quad
+	uint32_t instanceCount; ///< Number of instances to draw
+	uint32_t firstVertex;   ///< First vertex to draw, keep 0 for the instancing pipeline
+	uint32_t firstInstance; ///< Index into the instance buffer of the first instance to draw
+};
+
+/// \brief A sub-image's location inside a texture atlas
+///
+/// The four fields plug straight into the UV parameters of vk2dRendererDrawTexture
+/// (or the `texturePos` of an instance) so atlas draws go through the exact same
+/// paths as normal texture draws.
+struct VK2DAtlasEntry {
+	float xInTex;    ///< X position of the sub-image in the atlas texture in pixels
+	float yInTex;    ///< Y position of the sub-image in the atlas texture in pixels
+	float texWidth;  ///< Width of the sub-image in pixels
+	float texHeight; ///< Height of the sub-image in pixels
+};
+
 /// \brief Information needed to queue an asset loading off-thread
 struct VK2DAssetLoad {
 	VK2DAssetType type;   ///< Type of asset this is
@@ -281,6 +400,11 @@ struct VK2DAssetLoad {
 			int fragmentSize;   ///< Fragment shader's size
 			void *fragmentData; ///< Fragment shader's data
 		};
+		struct {
+			VK2DBundle bundle;             ///< Bundle to pull the entry from, must stay open until the load completes
+			const char *entryName;         ///< Entry name, or the vertex shader's entry name
+			const char *fragmentEntryName; ///< Fragment shader's entry name
+		};
 	} Load; ///< Information needed to create the asset
 
 	union {
@@ -309,7 +433,13 @@ VK2D_USER_STRUCT(VK2DStartupOptions)
 VK2D_USER_STRUCT(VK2DRendererConfig)
 VK2D_USER_STRUCT(VK2DCameraSpec)
 VK2D_USER_STRUCT(VK2DRendererLimits)
+VK2D_USER_STRUCT(VK2DGpuProfile)
+VK2D_USER_STRUCT(VK2DFrameStats)
+VK2D_USER_STRUCT(VK2DMemoryStats)
 VK2D_USER_STRUCT(VK2DDrawInstance)
+VK2D_USER_STRUCT(VK2DDrawInstanceCompact)
+VK2D_USER_STRUCT(VK2DDrawCommand)
+VK2D_USER_STRUCT(VK2DAtlasEntry)
 VK2D_USER_STRUCT(VK2DAssetLoad)
 
 #ifdef __cplusplus
@@ -10,16 +10,35 @@
 #include "VK2D/Buffer.h"
 #include "VK2D/DescriptorControl.h"
 #include "VK2D/stb_image.h"
+#include "VK2D/Constants.h"
 #include "VK2D/Opaque.h"
 #include "VK2D/Util.h"
 #include <malloc.h>
+#include <string.h>
+#include <stdio.h>
+
+void _vk2dRendererAddTextureToArray(VK2DTexture tex);
+void _vk2dRendererRemoveTextureFromArray(VK2DTexture tex);
+void _vk2dRendererUpdateTextureArraySlot(VK2DTexture tex);
+bool _vk2dImageCompressedDims(const void *data, uint32_t size, uint32_t *width, uint32_t *height);
+bool _vk2dRendererDeferFree(void (*freeFunc)(void*), void *resource);
+
+// Where a streamed texture's full image is in the pipeline, lives in VK2DTexture_t.streamState
+#define VK2D_STREAM_STATE_PLACEHOLDER 0 ///< Nothing in flight, draws sample the placeholder
+#define VK2D_STREAM_STATE_QUEUED 1      ///< Waiting in the device's stream list for a worker
+#define VK2D_STREAM_STATE_DECODING 2    ///< A worker claimed it and is decoding/uploading
+#define VK2D_STREAM_STATE_READY 3       ///< The full image is uploaded, waiting for the frame swap
+#define VK2D_STREAM_STATE_RESIDENT 4    ///< Draws sample the full image
 
 static void _vk2dTextureCreateDescriptor(VK2DTexture tex, VK2DRenderer renderer, bool mainThread) {
 	if (tex->img->set == NULL) {
-		if (mainThread)
+		if (mainThread) {
 			tex->img->set = vk2dDescConGetSamplerSet(renderer->descConSamplers, tex);
-		else
+			tex->img->setOwner = renderer->descConSamplers;
+		} else {
 			tex->img->set = vk2dDescConGetSamplerSet(renderer->descConSamplersOff, tex);
+			tex->img->setOwner = renderer->descConSamplersOff;
+		}
 	}
 }
 
@@ -30,6 +49,7 @@ VK2DTexture _vk2dTextureLoadFromImageInternal(VK2DImage image, bool mainThread)
 	if (vk2dPointerCheck(out)) {
 		out->img = image;
 		_vk2dTextureCreateDescriptor(out, renderer, mainThread);
+		_vk2dRendererAddTextureToArray(out);
 	} else {
 		free(out);
 		out = NULL;
@@ -42,10 +62,23 @@ VK2DTexture vk2dTextureLoadFromImage(VK2DImage image) {
 	return _vk2dTextureLoadFromImageInternal(image, true);
 }
 
+VK2DImage _vk2dImageFromCompressed(VK2DLogicalDevice dev, const void *data, uint32_t size, bool mainThread);
+
 VK2DTexture _vk2dTextureFromInternal(void *data, int size, bool mainThread) {
 	VK2DImage image;
 	VK2DTexture out = NULL;
 
+	// DDS/KTX2 blobs with BC payloads upload as-is, everything else decodes through stb_image
+	image = _vk2dImageFromCompressed(vk2dRendererGetDevice(), data, size, mainThread);
+	if (image != NULL) {
+		out = _vk2dTextureLoadFromImageInternal(image, mainThread);
+		if (out != NULL)
+			out->imgHandled = true;
+		else
+			vk2dImageFree(image);
+		return out;
+	}
+
 	int x, y, channels;
 	void *pixels = stbi_load_from_memory(data, size, &x, &y, &channels, 4);
 	if (pixels != NULL) {
@@ -75,18 +108,269 @@ VK2DTexture vk2dTextureFrom(void *data, int size) {
 
 VK2DTexture vk2dTextureLoad(const char *filename) {
 	uint32_t size;
-	void *data = _vk2dLoadFile(filename, &size);
+	void *mapping;
+	// Mapped so big images decode straight from the page cache instead of a heap copy
+	void *data = _vk2dMapFile(filename, &size, &mapping);
 	VK2DTexture tex = _vk2dTextureFromInternal(data, size, true);
 	if (tex == NULL)
 		vk2dLogMessage("Failed to load texture from file \"%s\".", filename);
-	free(data);
+	_vk2dUnmapFile(data, mapping);
 	return tex;
 }
 
+// Pushes a streamed texture into the waiting list for the workers to pick up
+static void _vk2dTextureStreamQueue(VK2DTexture tex) {
+	VK2DLogicalDevice dev = vk2dRendererGetDevice();
+
+	SDL_LockMutex(dev->streamListMutex);
+	if (dev->streamCount == dev->streamListSize) {
+		VK2DTexture *newList = realloc(dev->streamList, sizeof(VK2DTexture) * (dev->streamListSize + VK2D_DEFAULT_ARRAY_EXTENSION));
+		if (vk2dPointerCheck(newList)) {
+			dev->streamList = newList;
+			dev->streamListSize += VK2D_DEFAULT_ARRAY_EXTENSION;
+		}
+	}
+	if (dev->streamCount < dev->streamListSize) {
+		tex->streamState = VK2D_STREAM_STATE_QUEUED;
+		dev->streamList[dev->streamCount++] = tex;
+	}
+	SDL_UnlockMutex(dev->streamListMutex);
+}
+
+VK2DTexture vk2dTextureStream(const char *filename) {
+	VK2DRenderer renderer = vk2dRendererGetPointer();
+	if (renderer == NULL) {
+		vk2dLogMessage("Renderer is not initialized");
+		return NULL;
+	}
+	VK2DLogicalDevice dev = vk2dRendererGetDevice();
+
+	VK2DTexture out = calloc(1, sizeof(struct VK2DTexture_t));
+	char *filenameCopy = malloc(strlen(filename) + 1);
+	if (!vk2dPointerCheck(out) || !vk2dPointerCheck(filenameCopy)) {
+		free(out);
+		free(filenameCopy);
+		return NULL;
+	}
+	strcpy(filenameCopy, filename);
+
+	// A solid stand-in is correct under the 2D sampler's unnormalized coordinates - any
+	// texel region a draw asks for clamps to the same flat colour until the real pixels land
+	uint8_t pixels[4 * 4 * 4];
+	for (int i = 0; i < 4 * 4; i++) {
+		pixels[i * 4] = 128;
+		pixels[i * 4 + 1] = 128;
+		pixels[i * 4 + 2] = 128;
+		pixels[i * 4 + 3] = 255;
+	}
+	out->img = vk2dImageFromPixels(dev, pixels, 4, 4, true);
+	if (out->img == NULL) {
+		vk2dLogMessage("Failed to create placeholder for texture \"%s\".", filename);
+		free(filenameCopy);
+		free(out);
+		return NULL;
+	}
+	out->placeholderImg = out->img;
+	out->streamed = true;
+	out->streamFilename = filenameCopy;
+	out->streamState = VK2D_STREAM_STATE_PLACEHOLDER;
+
+	// The file header hands over the real dimensions without decoding any pixels
+	int w = 0, h = 0, channels;
+	if (stbi_info(filename, &w, &h, &channels)) {
+		out->streamWidth = w;
+		out->streamHeight = h;
+	} else {
+		uint8_t header[192];
+		uint32_t cw, ch;
+		FILE *file = fopen(filename, "rb");
+		size_t headerSize = file != NULL ? fread(header, 1, sizeof(header), file) : 0;
+		if (file != NULL)
+			fclose(file);
+		if (_vk2dImageCompressedDims(header, headerSize, &cw, &ch)) {
+			out->streamWidth = cw;
+			out->streamHeight = ch;
+		}
+	}
+
+	_vk2dTextureCreateDescriptor(out, renderer, true);
+	_vk2dRendererAddTextureToArray(out);
+	_vk2dTextureStreamQueue(out);
+	return out;
+}
+
+// Called from the worker threads - claims the most recently requested stream, decodes and
+// uploads the full image, then publishes it for the main thread to swap in at the next frame
+void _vk2dTextureStreamNext(VK2DLogicalDevice dev) {
+	VK2DRenderer renderer = vk2dRendererGetPointer();
+	VK2DTexture tex = NULL;
+
+	SDL_LockMutex(dev->streamListMutex);
+	if (dev->streamCount > 0) {
+		tex = dev->streamList[--dev->streamCount];
+		tex->streamState = VK2D_STREAM_STATE_DECODING;
+	}
+	SDL_UnlockMutex(dev->streamListMutex);
+	if (tex == NULL)
+		return;
+
+	uint32_t size;
+	void *mapping;
+	uint8_t *fileData = _vk2dMapFile(tex->streamFilename, &size, &mapping);
+	VK2DImage img = _vk2dImageFromCompressed(dev, fileData, size, false);
+	if (img == NULL) {
+		int x, y, channels;
+		void *pixels = stbi_load_from_memory(fileData, size, &x, &y, &channels, 4);
+		if (pixels != NULL) {
+			img = vk2dImageFromPixels(dev, pixels, x, y, false);
+			stbi_image_free(pixels);
+		}
+	}
+	_vk2dUnmapFile(fileData, mapping);
+	if (img != NULL) {
+		img->set = vk2dDescConGetSamplerSetFromImage(renderer->descConSamplersOff, img);
+		img->setOwner = renderer->descConSamplersOff;
+	} else
+		vk2dLogMessage("Failed to stream texture \"%s\".", tex->streamFilename);
+	tex->pendingImg = img;
+
+	// Publish under the mutex so the frame swap and a concurrent free both see a settled state
+	SDL_LockMutex(dev->streamListMutex);
+	if (dev->streamDoneCount == dev->streamDoneListSize) {
+		VK2DTexture *newList = realloc(dev->streamDoneList, sizeof(VK2DTexture) * (dev->streamDoneListSize + VK2D_DEFAULT_ARRAY_EXTENSION));
+		if (vk2dPointerCheck(newList)) {
+			dev->streamDoneList = newList;
+			dev->streamDoneListSize += VK2D_DEFAULT_ARRAY_EXTENSION;
+		}
+	}
+	if (dev->streamDoneCount < dev->streamDoneListSize)
+		dev->streamDoneList[dev->streamDoneCount++] = tex;
+	tex->streamState = VK2D_STREAM_STATE_READY;
+	SDL_UnlockMutex(dev->streamListMutex);
+}
+
+// Called at the start of each frame - swaps finished full images in so only draws recorded
+// from here on sample them, in-flight frames keep the placeholder set which never goes away
+void _vk2dTextureResolveStreams() {
+	VK2DRenderer renderer = vk2dRendererGetPointer();
+	VK2DLogicalDevice dev = renderer->ld;
+
+	SDL_LockMutex(dev->streamListMutex);
+	for (int i = 0; i < dev->streamDoneCount; i++) {
+		VK2DTexture tex = dev->streamDoneList[i];
+		if (tex->pendingImg != NULL) {
+			tex->img = tex->pendingImg;
+			tex->pendingImg = NULL;
+			tex->streamWidth = tex->img->width;
+			tex->streamHeight = tex->img->height;
+			_vk2dRendererUpdateTextureArraySlot(tex);
+			tex->streamState = VK2D_STREAM_STATE_RESIDENT;
+		} else {
+			tex->streamState = VK2D_STREAM_STATE_PLACEHOLDER;
+		}
+	}
+	dev->streamDoneCount = 0;
+	SDL_UnlockMutex(dev->streamListMutex);
+}
+
+// Frees an evicted full image once no in-flight frame references it
+static void _vk2dTextureStreamImageDestroy(void *image) {
+	VK2DImage img = image;
+	vk2dDescConFreeSet(img->setOwner, img->set);
+	vk2dImageFree(img);
+}
+
+void vk2dTextureEvict(VK2DTexture tex) {
+	VK2DRenderer renderer = vk2dRendererGetPointer();
+	if (renderer == NULL) {
+		vk2dLogMessage("Renderer is not initialized");
+		return;
+	}
+	if (tex == NULL)
+		return;
+	if (!tex->streamed || tex->streamState != VK2D_STREAM_STATE_RESIDENT) {
+		vk2dLogMessage("Texture is not a resident streamed texture, cannot evict it.");
+		return;
+	}
+
+	VK2DImage full = tex->img;
+	tex->img = tex->placeholderImg;
+	_vk2dRendererUpdateTextureArraySlot(tex);
+	tex->streamState = VK2D_STREAM_STATE_PLACEHOLDER;
+
+	// In-flight frames may still sample the full image, so it rides the frame fence out
+	if (!_vk2dRendererDeferFree(_vk2dTextureStreamImageDestroy, full))
+		_vk2dTextureStreamImageDestroy(full);
+}
+
+void vk2dTextureMakeResident(VK2DTexture tex) {
+	VK2DRenderer renderer = vk2dRendererGetPointer();
+	if (renderer == NULL) {
+		vk2dLogMessage("Renderer is not initialized");
+		return;
+	}
+	if (tex == NULL)
+		return;
+	if (!tex->streamed) {
+		vk2dLogMessage("Texture is not streamed, cannot make it resident.");
+		return;
+	}
+
+	// Already queued, decoding, or resident - nothing to do
+	if (tex->streamState != VK2D_STREAM_STATE_PLACEHOLDER)
+		return;
+	_vk2dTextureStreamQueue(tex);
+}
+
+VK2DTextureResidency vk2dTextureGetResidency(VK2DTexture tex) {
+	// Non-streamed textures always have their pixels where draws can reach them
+	if (tex == NULL || !tex->streamed)
+		return VK2D_TEXTURE_RESIDENCY_RESIDENT;
+	int state = tex->streamState;
+	if (state == VK2D_STREAM_STATE_RESIDENT)
+		return VK2D_TEXTURE_RESIDENCY_RESIDENT;
+	if (state == VK2D_STREAM_STATE_PLACEHOLDER)
+		return VK2D_TEXTURE_RESIDENCY_PLACEHOLDER;
+	return VK2D_TEXTURE_RESIDENCY_LOADING;
+}
+
+// Takes a streamed texture out of the workers' hands so it can be freed safely
+static void _vk2dTextureStreamDetach(VK2DTexture tex) {
+	VK2DLogicalDevice dev = vk2dRendererGetDevice();
+
+	// Pull it out of the waiting list before a worker can claim it
+	SDL_LockMutex(dev->streamListMutex);
+	for (int i = 0; i < dev->streamCount; i++) {
+		if (dev->streamList[i] == tex) {
+			dev->streamList[i] = dev->streamList[--dev->streamCount];
+			tex->streamState = VK2D_STREAM_STATE_PLACEHOLDER;
+			break;
+		}
+	}
+	SDL_UnlockMutex(dev->streamListMutex);
+
+	// A worker already claimed it - wait the decode out, same spin vk2dAssetsWait uses
+	while (tex->streamState == VK2D_STREAM_STATE_DECODING) {
+		volatile int i = 0;
+	}
+
+	// And keep the frame swap from ever touching freed memory
+	SDL_LockMutex(dev->streamListMutex);
+	for (int i = 0; i < dev->streamDoneCount; i++) {
+		if (dev->streamDoneList[i] == tex) {
+			dev->streamDoneList[i] = dev->streamDoneList[--dev->streamDoneCount];
+			break;
+		}
+	}
+	SDL_UnlockMutex(dev->streamListMutex);
+}
+
 void _vk2dCameraUpdateUBO(VK2DUniformBufferObject *ubo, VK2DCameraSpec *camera);
 void _vk2dImageTransitionImageLayout(VK2DLogicalDevice dev, VkImage image, VkImageLayout oldLayout, VkImageLayout newLayout, bool mainThread);
 void _vk2dRendererAddTarget(VK2DTexture tex);
 void _vk2dRendererRemoveTarget(VK2DTexture tex);
+VK2DImage _vk2dRendererGetSharedDepthBuffer(uint32_t w, uint32_t h);
+void _vk2dRendererReleaseSharedDepthBuffer(VK2DImage img);
 VK2DTexture vk2dTextureCreate(float w, float h) {
 	VK2DTexture out = malloc(sizeof(struct VK2DTexture_t));
 	VK2DRenderer renderer = vk2dRendererGetPointer();
@@ -110,9 +394,9 @@ VK2DTexture vk2dTextureCreate(float w, float h) {
 	_vk2dCameraUpdateUBO(&ubo, &cam);
 
 	if (vk2dPointerCheck(out)) {
-		out->img = vk2dImageCreate(dev, w, h, VK_FORMAT_B8G8R8A8_SRGB, VK_IMAGE_ASPECT_COLOR_BIT, VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT, 1);
+		out->img = vk2dImageCreate(dev, w, h, VK_FORMAT_B8G8R8A8_SRGB, VK_IMAGE_ASPECT_COLOR_BIT, VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_SAMPLED_BIT, 1);
 		out->sampledImg = vk2dImageCreate(dev, w, h, VK_FORMAT_B8G8R8A8_SRGB, VK_IMAGE_ASPECT_COLOR_BIT, VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT, (VkSampleCountFlagBits)renderer->config.msaa);
-		out->depthBuffer = vk2dImageCreate(dev, w, h, renderer->depthBufferFormat, VK_IMAGE_ASPECT_DEPTH_BIT, VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT, (VkSampleCountFlagBits)renderer->config.msaa);
+		out->depthBuffer = _vk2dRendererGetSharedDepthBuffer(w, h);
 		_vk2dImageTransitionImageLayout(dev, out->img->img, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, true);
 		_vk2dImageTransitionImageLayout(dev, out->sampledImg->img, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, true);
 		//_vk2dImageTransitionImageLayout(dev, out->depthBuffer->img, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL);
@@ -138,6 +422,7 @@ VK2DTexture vk2dTextureCreate(float w, float h) {
 
 		_vk2dRendererAddTarget(out);
 		_vk2dTextureCreateDescriptor(out, renderer, true);
+		_vk2dRendererAddTextureToArray(out);
 	} else {
 		free(out);
 		out = NULL;
@@ -146,12 +431,58 @@ VK2DTexture vk2dTextureCreate(float w, float h) {
 	return out;
 }
 
+VK2DTexture vk2dTextureRent(float w, float h) {
+	VK2DRenderer renderer = vk2dRendererGetPointer();
+	if (renderer == NULL) {
+		vk2dLogMessage("Renderer is not initialized");
+		return NULL;
+	}
+
+	// Returned targets of the same size are handed back out instead of allocating new ones
+	for (uint32_t i = 0; i < renderer->targetPoolCount; i++) {
+		VK2DTexture tex = renderer->targetPool[i];
+		if (tex->img->width == (uint32_t)w && tex->img->height == (uint32_t)h) {
+			renderer->targetPool[i] = renderer->targetPool[renderer->targetPoolCount - 1];
+			renderer->targetPoolCount--;
+			return tex;
+		}
+	}
+
+	return vk2dTextureCreate(w, h);
+}
+
+void vk2dTextureReturn(VK2DTexture tex) {
+	VK2DRenderer renderer = vk2dRendererGetPointer();
+	if (renderer == NULL) {
+		vk2dLogMessage("Renderer is not initialized");
+		return;
+	}
+	if (tex == NULL)
+		return;
+	if (tex->fbo == VK_NULL_HANDLE) {
+		vk2dLogMessage("Texture is not a target, cannot return it to the target pool.");
+		return;
+	}
+
+	if (renderer->targetPoolCount == renderer->targetPoolListSize) {
+		VK2DTexture *newList = realloc(renderer->targetPool, sizeof(VK2DTexture) * (renderer->targetPoolListSize + VK2D_DEFAULT_ARRAY_EXTENSION));
+		if (!vk2dPointerCheck(newList)) {
+			vk2dTextureFree(tex);
+			return;
+		}
+		renderer->targetPool = newList;
+		renderer->targetPoolListSize += VK2D_DEFAULT_ARRAY_EXTENSION;
+	}
+	renderer->targetPool[renderer->targetPoolCount++] = tex;
+}
+
 float vk2dTextureWidth(VK2DTexture tex) {
-	return tex->img->width;
+	// Streamed textures report the full image's size even while the placeholder is up
+	return tex->streamed ? tex->streamWidth : tex->img->width;
 }
 
 float vk2dTextureHeight(VK2DTexture tex) {
-	return tex->img->height;
+	return tex->streamed ? tex->streamHeight : tex->img->height;
 }
 
 bool vk2dTextureIsTarget(VK2DTexture tex) {
@@ -162,18 +493,77 @@ VK2DImage vk2dTextureGetImage(VK2DTexture tex) {
 	return tex->img;
 }
 
-void vk2dTextureFree(VK2DTexture tex) {
-	if (tex != NULL) {
-		if (tex->fbo != VK_NULL_HANDLE) {
-			vkDestroyFramebuffer(tex->img->dev->dev, tex->fbo, VK_NULL_HANDLE);
-			vk2dImageFree(tex->img);
-			vk2dBufferFree(tex->ubo);
-			vk2dImageFree(tex->sampledImg);
-			vk2dImageFree(tex->depthBuffer);
-			_vk2dRendererRemoveTarget(tex);
-		} else if (tex->imgHandled) {
+uint32_t vk2dTextureGetArrayIndex(VK2DTexture tex) {
+	return tex->arrayIndex;
+}
+
+void _vk2dImageGetPixels(VK2DImage img, void *pixels);
+bool vk2dTextureGetPixels(VK2DTexture tex, void *pixels) {
+	if (!vk2dTextureIsTarget(tex)) {
+		vk2dLogMessage("Texture is not a target, cannot read its pixels.");
+		return false;
+	}
+
+	// Any frame still rendering into the texture has to land before the copy
+	vk2dRendererWait();
+	_vk2dImageGetPixels(tex->img, pixels);
+	return true;
+}
+
+// Destroys the texture's Vulkan resources for real, only safe once no in-flight frame references them
+static void _vk2dTextureDestroy(void *texture) {
+	VK2DTexture tex = texture;
+	VK2DRenderer renderer = vk2dRendererGetPointer();
+
+	// Streamed textures own their placeholder and possibly a full or pending image
+	// outright, each set going back to the controller that issued it
+	if (tex->streamed) {
+		if (tex->pendingImg != NULL) {
+			vk2dDescConFreeSet(tex->pendingImg->setOwner, tex->pendingImg->set);
+			vk2dImageFree(tex->pendingImg);
+		}
+		if (tex->img != tex->placeholderImg) {
+			vk2dDescConFreeSet(tex->img->setOwner, tex->img->set);
 			vk2dImageFree(tex->img);
 		}
+		vk2dDescConFreeSet(tex->placeholderImg->setOwner, tex->placeholderImg->set);
+		vk2dImageFree(tex->placeholderImg);
+		free(tex->streamFilename);
 		free(tex);
+		return;
+	}
+
+	// The sets outlive the texture in their pools, so they go back for reuse instead of
+	// leaking - but only when the texture owns its image, a user-owned image keeps its
+	// set. Worker-loaded textures got theirs from the off-thread controller, so the set
+	// returns to whichever controller actually issued it
+	if (tex->imgHandled || tex->fbo != VK_NULL_HANDLE)
+		vk2dDescConFreeSet(tex->img->setOwner, tex->img->set);
+
+	if (tex->fbo != VK_NULL_HANDLE) {
+		vk2dDescConFreeSet(renderer->descConVP, tex->uboSet);
+		vkDestroyFramebuffer(tex->img->dev->dev, tex->fbo, VK_NULL_HANDLE);
+		vk2dImageFree(tex->img);
+		vk2dBufferFree(tex->ubo);
+		vk2dImageFree(tex->sampledImg);
+		_vk2dRendererReleaseSharedDepthBuffer(tex->depthBuffer);
+	} else if (tex->imgHandled) {
+		vk2dImageFree(tex->img);
+	}
+	free(tex);
+}
+
+void vk2dTextureFree(VK2DTexture tex) {
+	if (tex != NULL) {
+		// A worker may still be decoding this texture, settle that before anything is freed
+		if (tex->streamed)
+			_vk2dTextureStreamDetach(tex);
+		// The renderer has to stop tracking targets right away, but the Vulkan resources
+		// wait on the current frame's fence so no device-wide stall is needed
+		_vk2dRendererRemoveTextureFromArray(tex);
+		if (tex->fbo != VK_NULL_HANDLE)
+			_vk2dRendererRemoveTarget(tex);
+		if (!_vk2dRendererDeferFree(_vk2dTextureDestroy, tex))
+			_vk2dTextureDestroy(tex);
 	}
 }
\ No newline at end of file
@@ -15,14 +15,50 @@ extern "C" {
 /// \warning Textures created with this function are NOT valid render targets
 VK2DTexture vk2dTextureLoadFromImage(VK2DImage image);
 
-/// \brief Loads a texture from a file (png, bmp, jpg, tiff)
+/// \brief Loads a texture from a file (png, bmp, jpg, tiff, or dds/ktx2 with a BC1/BC3/BC7 payload)
 /// \param filename File to load
 /// \return Returns a new texture or NULL if it failed
 /// \warning Textures created with this function are NOT valid render targets
+///
+/// dds and ktx2 files upload their compressed blocks directly with no CPU decode, which
+/// also leaves the texture compressed in video memory - prefer them for large atlases.
 VK2DTexture vk2dTextureLoad(const char *filename);
 
+/// \brief Loads a texture in the background, returning a placeholder immediately
+/// \param filename File to load, same formats as vk2dTextureLoad
+/// \return Returns a texture that is immediately valid to draw, or NULL if it failed
+/// \warning Textures created with this function are NOT valid render targets
+///
+/// The texture comes back right away showing a small flat-colour placeholder while the
+/// worker threads decode and upload the real image, which draws automatically switch to
+/// once it lands - check vk2dTextureGetResidency to know when. Width/height report the
+/// full image's size from the start (read from the file header) so layout code doesn't
+/// have to care, and the bindless array index stays stable across the swap. Combined
+/// with vk2dTextureEvict and vk2dRendererSetMemoryBudgetCallback this lets a world with
+/// far more textures than video memory load zones without hitching the frame.
+VK2DTexture vk2dTextureStream(const char *filename);
+
+/// \brief Demotes a streamed texture back to its placeholder, freeing the full image
+/// \param tex Texture to evict, must be streamed and currently resident
+///
+/// Draws keep working and show the placeholder until vk2dTextureMakeResident brings the
+/// full image back. Typically called from the memory budget callback to get back under
+/// budget without destroying any texture handles the game is holding.
+void vk2dTextureEvict(VK2DTexture tex);
+
+/// \brief Queues an evicted streamed texture's full image to be loaded again
+/// \param tex Texture to bring back, must have come from vk2dTextureStream
+///
+/// Does nothing if the full image is already loading or resident.
+void vk2dTextureMakeResident(VK2DTexture tex);
+
+/// \brief Reports how much of a texture is actually in video memory
+/// \param tex Texture to check
+/// \return Returns the current residency, textures that aren't streamed are always resident
+VK2DTextureResidency vk2dTextureGetResidency(VK2DTexture tex);
+
 /// \brief Same as vk2dTextureLoad but it uses a byte buffer instead of pulling from a file
-/// \param data Pointer to the image data, either png, bmp, jpg, or tiff
+/// \param data Pointer to the image data, either png, bmp, jpg, tiff, or dds/ktx2 with a BC1/BC3/BC7 payload
 /// \param size Size in bytes of the data buffer
 /// \return Returns a new texture or NULL if it failed
 /// \warning Textures created with this function are NOT valid render targets
@@ -34,6 +70,22 @@ VK2DTexture vk2dTextureFrom(void *data, int size);
 /// \return Returns a new texture or NULL if it failed
 VK2DTexture vk2dTextureCreate(float w, float h);
 
+/// \brief Borrows a temporary drawing target from the renderer's pool
+/// \param w Width of the texture
+/// \param h Height of the texture
+/// \return Returns a target texture or NULL if it failed
+///
+/// Identical to vk2dTextureCreate except that same-size targets previously handed to
+/// vk2dTextureReturn are reused instead of allocating new VRAM, which makes rented
+/// targets cheap enough to grab for a single post-processing step. The contents are
+/// whatever the previous renter left in it, so clear it before use.
+VK2DTexture vk2dTextureRent(float w, float h);
+
+/// \brief Hands a rented target back to the pool so a later vk2dTextureRent can reuse it
+/// \param tex Target to return, may be NULL
+/// \warning Don't use the texture after returning it, the next renter owns it now
+void vk2dTextureReturn(VK2DTexture tex);
+
 /// \brief Gets the width in pixels of a texture
 /// \param tex Texture to get the width from
 /// \return Returns the width in pixels
@@ -54,6 +106,30 @@ bool vk2dTextureIsTarget(VK2DTexture tex);
 /// \return Returns the texture's image
 VK2DImage vk2dTextureGetImage(VK2DTexture tex);
 
+/// \brief Returns a texture's slot in the bindless texture array
+/// \param tex Texture to check
+/// \return Returns the texture's index, or UINT32_MAX if the host doesn't support the array (or it was full)
+///
+/// Only available if the `supportsTextureArray` field of vk2dRendererGetLimits is true. Custom
+/// shaders can declare the array as `layout(set = 4, binding = 0) uniform texture2D textures[];`
+/// and sample any loaded texture with this index (pass it in through the shader's uniform
+/// buffer), combining it with the sampler from `layout(set = 1, binding = 1)`. This lets a
+/// single shader draw source from many textures without any descriptor-set rebinds.
+uint32_t vk2dTextureGetArrayIndex(VK2DTexture tex);
+
+/// \brief Copies a target texture's pixels into host memory
+/// \param tex Texture to read back, must have been created with vk2dTextureCreate
+/// \param pixels Buffer to copy into, must be at least width * height * 4 bytes
+/// \return Returns true on success, false if the texture is not a target
+/// \warning This waits for the GPU to finish all queued work so it is very slow, don't call it every frame
+/// \warning Pixels come back as 8-bit BGRA, the same layout the texture is stored in
+///
+/// Call this between frames (or after switching the render target away from `tex`) so the
+/// readback sees the last completed frame. This is primarily intended for headless rendering
+/// where vk2dRendererInitHeadless is used and the results must leave the GPU some other way
+/// than a window.
+bool vk2dTextureGetPixels(VK2DTexture tex, void *pixels);
+
 /// \brief Frees a texture from memory
 /// \param tex Texture to free
 void vk2dTextureFree(VK2DTexture tex);
@@ -0,0 +1,137 @@
+/// \file Tilemap.c
+/// \author Paolo Mazzon
+#include "VK2D/Tilemap.h"
+#include "VK2D/DrawList.h"
+#include "VK2D/Texture.h"
+#include "VK2D/Renderer.h"
+#include "VK2D/Validation.h"
+#include "VK2D/Constants.h"
+#include "VK2D/Opaque.h"
+#include <malloc.h>
+#include <string.h>
+
+VK2DTilemap vk2dTilemapCreate(VK2DTexture tex, float tileWidth, float tileHeight, uint32_t width, uint32_t height, uint32_t *tiles) {
+	VK2DTilemap out = NULL;
+
+	if (vk2dRendererGetPointer() != NULL) {
+		out = malloc(sizeof(struct VK2DTilemap_t));
+
+		if (vk2dPointerCheck(out)) {
+			out->tex = tex;
+			out->tileWidth = tileWidth;
+			out->tileHeight = tileHeight;
+			out->width = width;
+			out->height = height;
+			out->chunksAcross = (width + VK2D_TILEMAP_CHUNK_SIZE - 1) / VK2D_TILEMAP_CHUNK_SIZE;
+			out->chunksDown = (height + VK2D_TILEMAP_CHUNK_SIZE - 1) / VK2D_TILEMAP_CHUNK_SIZE;
+			out->tiles = calloc((size_t)width * height, sizeof(uint32_t));
+			uint32_t chunkCount = out->chunksAcross * out->chunksDown;
+			out->chunks = calloc(chunkCount, sizeof(VK2DDrawList));
+			out->chunkDirty = malloc(chunkCount * sizeof(bool));
+
+			if (vk2dPointerCheck(out->tiles) && vk2dPointerCheck(out->chunks) && vk2dPointerCheck(out->chunkDirty)) {
+				if (tiles != NULL)
+					memcpy(out->tiles, tiles, (size_t)width * height * sizeof(uint32_t));
+				bool chunksCreated = true;
+				for (uint32_t i = 0; i < chunkCount; i++) {
+					out->chunks[i] = vk2dDrawListCreate(tex);
+					out->chunkDirty[i] = true;
+					chunksCreated = chunksCreated && out->chunks[i] != NULL;
+				}
+				if (!chunksCreated) {
+					vk2dTilemapFree(out);
+					out = NULL;
+				}
+			} else {
+				free(out->tiles);
+				free(out->chunks);
+				free(out->chunkDirty);
+				free(out);
+				out = NULL;
+			}
+		}
+	} else {
+		vk2dLogMessage("Renderer is not initialized");
+	}
+
+	return out;
+}
+
+void vk2dTilemapSet(VK2DTilemap map, uint32_t x, uint32_t y, uint32_t tile) {
+	if (map != NULL && x < map->width && y < map->height) {
+		if (map->tiles[(y * map->width) + x] != tile) {
+			map->tiles[(y * map->width) + x] = tile;
+			map->chunkDirty[((y / VK2D_TILEMAP_CHUNK_SIZE) * map->chunksAcross) + (x / VK2D_TILEMAP_CHUNK_SIZE)] = true;
+		}
+	}
+}
+
+uint32_t vk2dTilemapGet(VK2DTilemap map, uint32_t x, uint32_t y) {
+	if (map != NULL && x < map->width && y < map->height)
+		return map->tiles[(y * map->width) + x];
+	return 0;
+}
+
+// Re-records a chunk's draw list from the tile grid, one draw per non-empty tile
+static void _vk2dTilemapBakeChunk(VK2DTilemap map, uint32_t chunkX, uint32_t chunkY) {
+	VK2DDrawList list = map->chunks[(chunkY * map->chunksAcross) + chunkX];
+	uint32_t tilesPerRow = (uint32_t)(vk2dTextureWidth(map->tex) / map->tileWidth);
+	uint32_t x2 = (chunkX + 1) * VK2D_TILEMAP_CHUNK_SIZE < map->width ? (chunkX + 1) * VK2D_TILEMAP_CHUNK_SIZE : map->width;
+	uint32_t y2 = (chunkY + 1) * VK2D_TILEMAP_CHUNK_SIZE < map->height ? (chunkY + 1) * VK2D_TILEMAP_CHUNK_SIZE : map->height;
+
+	vk2dDrawListClear(list);
+	for (uint32_t y = chunkY * VK2D_TILEMAP_CHUNK_SIZE; y < y2; y++) {
+		for (uint32_t x = chunkX * VK2D_TILEMAP_CHUNK_SIZE; x < x2; x++) {
+			uint32_t tile = map->tiles[(y * map->width) + x];
+			if (tile != 0) {
+				uint32_t cell = tile - 1;
+				vk2dDrawListAppend(list, x * map->tileWidth, y * map->tileHeight, 1, 1, 0, 0, 0,
+								   (cell % tilesPerRow) * map->tileWidth, (cell / tilesPerRow) * map->tileHeight,
+								   map->tileWidth, map->tileHeight);
+			}
+		}
+	}
+	map->chunkDirty[(chunkY * map->chunksAcross) + chunkX] = false;
+}
+
+void vk2dTilemapDraw(VK2DTilemap map, float visX, float visY, float visW, float visH) {
+	if (vk2dRendererGetPointer() != NULL) {
+		if (map != NULL) {
+			// Clamp the visible rectangle to the chunk grid
+			float chunkPixelsX = map->tileWidth * VK2D_TILEMAP_CHUNK_SIZE;
+			float chunkPixelsY = map->tileHeight * VK2D_TILEMAP_CHUNK_SIZE;
+			int32_t x1 = (int32_t)(visX / chunkPixelsX);
+			int32_t y1 = (int32_t)(visY / chunkPixelsY);
+			int32_t x2 = (int32_t)((visX + visW) / chunkPixelsX);
+			int32_t y2 = (int32_t)((visY + visH) / chunkPixelsY);
+			x1 = x1 < 0 ? 0 : x1;
+			y1 = y1 < 0 ? 0 : y1;
+			x2 = x2 >= (int32_t)map->chunksAcross ? (int32_t)map->chunksAcross - 1 : x2;
+			y2 = y2 >= (int32_t)map->chunksDown ? (int32_t)map->chunksDown - 1 : y2;
+
+			for (int32_t y = y1; y <= y2; y++) {
+				for (int32_t x = x1; x <= x2; x++) {
+					if (map->chunkDirty[(y * map->chunksAcross) + x])
+						_vk2dTilemapBakeChunk(map, x, y);
+					vk2dRendererDrawList(map->chunks[(y * map->chunksAcross) + x]);
+				}
+			}
+		} else {
+			vk2dLogMessage("Tilemap does not exist");
+		}
+	} else {
+		vk2dLogMessage("Renderer is not initialized");
+	}
+}
+
+void vk2dTilemapFree(VK2DTilemap map) {
+	if (map != NULL) {
+		if (map->chunks != NULL)
+			for (uint32_t i = 0; i < map->chunksAcross * map->chunksDown; i++)
+				vk2dDrawListFree(map->chunks[i]);
+		free(map->chunks);
+		free(map->chunkDirty);
+		free(map->tiles);
+		free(map);
+	}
+}
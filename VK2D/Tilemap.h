@@ -0,0 +1,58 @@
+/// \file Tilemap.h
+/// \author Paolo Mazzon
+/// \brief Draws tile worlds a chunk at a time instead of a call per tile
+#pragma once
+#include "VK2D/Structs.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// \brief Creates a tilemap
+/// \param tex Texture holding the tile graphics in a grid of tileWidth x tileHeight cells
+/// \param tileWidth Width of a tile in pixels
+/// \param tileHeight Height of a tile in pixels
+/// \param width Width of the map in tiles
+/// \param height Height of the map in tiles
+/// \param tiles Initial tile ids in row-major order (width * height of them), or NULL for an empty map
+/// \return Returns a new tilemap or NULL if it failed
+///
+/// Tile id 0 is empty; id `n` draws the `n - 1`th cell of the texture's grid counting
+/// left-to-right, top-to-bottom. Internally the map is split into chunks of
+/// VK2D_TILEMAP_CHUNK_SIZE x VK2D_TILEMAP_CHUNK_SIZE tiles, each baked into its own
+/// retained draw list, so drawing costs one indirect draw per visible chunk and an
+/// edit only re-bakes the chunk it lands in.
+VK2DTilemap vk2dTilemapCreate(VK2DTexture tex, float tileWidth, float tileHeight, uint32_t width, uint32_t height, uint32_t *tiles);
+
+/// \brief Sets the tile at a position in the map
+/// \param map Map to edit
+/// \param x X position in tiles
+/// \param y Y position in tiles
+/// \param tile Tile id to place, 0 to clear the tile
+void vk2dTilemapSet(VK2DTilemap map, uint32_t x, uint32_t y, uint32_t tile);
+
+/// \brief Gets the tile at a position in the map
+/// \param map Map to check
+/// \param x X position in tiles
+/// \param y Y position in tiles
+/// \return Returns the tile id at that position, 0 if its empty or out of range
+uint32_t vk2dTilemapGet(VK2DTilemap map, uint32_t x, uint32_t y);
+
+/// \brief Draws every chunk of the map that touches a rectangle of the game world
+/// \param map Map to draw
+/// \param visX X of the visible region in the game world (typically the camera's x)
+/// \param visY Y of the visible region in the game world
+/// \param visW Width of the visible region
+/// \param visH Height of the visible region
+///
+/// The map draws at the world origin, tile (x, y) lands at (x * tileWidth, y * tileHeight).
+/// Chunks that were edited since their last draw are re-baked on the way through.
+void vk2dTilemapDraw(VK2DTilemap map, float visX, float visY, float visW, float visH);
+
+/// \brief Frees a tilemap and its chunks from memory
+/// \param map Map to free
+void vk2dTilemapFree(VK2DTilemap map);
+
+#ifdef __cplusplus
+};
+#endif
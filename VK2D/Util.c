@@ -5,6 +5,14 @@
 #include <malloc.h>
 #include <string.h>
 #include <math.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 #include "VK2D/Initializers.h"
 #include "VK2D/Validation.h"
 #include "VK2D/Structs.h"
@@ -13,8 +21,10 @@
 #include "VK2D/Texture.h"
 #include "VK2D/Shader.h"
 #include "VK2D/Model.h"
+#include "VK2D/Bundle.h"
 
 static float gLoadStatus = 0;
+static _Atomic(int) gAssetsLoaded = 0;
 
 // Gets the vertex input information for VK2DVertexTexture (Uses static variables to persist attached descriptions)
 VkPipelineVertexInputStateCreateInfo _vk2dGetTextureVertexInputState() {
@@ -123,6 +133,93 @@ unsigned char* _vk2dLoadFile(const char *filename, uint32_t *size) {
 	return buffer;
 }
 
+// Opaque bookkeeping for _vk2dMapFile, a NULL handle means the data is just a heap buffer
+typedef struct VK2DFileMapping {
+#ifdef _WIN32
+	HANDLE file;    ///< File the view was created from
+	HANDLE mapping; ///< File mapping object backing the view
+#else
+	size_t length;  ///< Length of the mapping for munmap
+#endif
+} VK2DFileMapping;
+
+unsigned char* _vk2dMapFile(const char *filename, uint32_t *size, void **mapping) {
+	unsigned char *data = NULL;
+	*mapping = NULL;
+	*size = 0;
+
+#ifdef _WIN32
+	HANDLE file = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (file != INVALID_HANDLE_VALUE) {
+		LARGE_INTEGER fileSize;
+		HANDLE map = GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0 ?
+				CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL) : NULL;
+		if (map != NULL) {
+			data = MapViewOfFile(map, FILE_MAP_READ, 0, 0, 0);
+			if (data != NULL) {
+				VK2DFileMapping *handle = malloc(sizeof(VK2DFileMapping));
+				if (handle != NULL) {
+					handle->file = file;
+					handle->mapping = map;
+					*mapping = handle;
+					*size = fileSize.QuadPart;
+				} else {
+					UnmapViewOfFile(data);
+					data = NULL;
+				}
+			}
+			if (*mapping == NULL)
+				CloseHandle(map);
+		}
+		if (*mapping == NULL)
+			CloseHandle(file);
+	}
+#else
+	int file = open(filename, O_RDONLY);
+	if (file != -1) {
+		struct stat info;
+		if (fstat(file, &info) == 0 && info.st_size > 0) {
+			void *view = mmap(NULL, info.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+			if (view != MAP_FAILED) {
+				VK2DFileMapping *handle = malloc(sizeof(VK2DFileMapping));
+				if (handle != NULL) {
+					handle->length = info.st_size;
+					data = view;
+					*mapping = handle;
+					*size = info.st_size;
+				} else {
+					munmap(view, info.st_size);
+				}
+			}
+		}
+		// The mapping stays alive without the descriptor
+		close(file);
+	}
+#endif
+
+	// Whatever went wrong above, the heap path still works
+	if (data == NULL)
+		data = _vk2dLoadFile(filename, size);
+
+	return data;
+}
+
+void _vk2dUnmapFile(unsigned char *data, void *mapping) {
+	VK2DFileMapping *handle = mapping;
+	if (handle != NULL) {
+#ifdef _WIN32
+		UnmapViewOfFile(data);
+		CloseHandle(handle->mapping);
+		CloseHandle(handle->file);
+#else
+		munmap(data, handle->length);
+#endif
+		free(handle);
+	} else {
+		free(data);
+	}
+}
+
 unsigned char *_vk2dCopyBuffer(void *buffer, int size) {
 	unsigned char *new = NULL;
 	if (buffer != NULL && size != 0) {
@@ -135,57 +232,71 @@ unsigned char *_vk2dCopyBuffer(void *buffer, int size) {
 }
 
 extern VK2DLogicalDevice gDeviceFromMainThread;
+void _vk2dTextureStreamNext(VK2DLogicalDevice dev);
 int _vk2dWorkerThread(void *data) {
-	// Data is the logical device
+	// Data is this worker's index into the pool
 	VK2DLogicalDevice dev = gDeviceFromMainThread;
-	int loaded = 0;
+	int threadIndex = (int)(intptr_t)data;
 
-	// Setup the command pool
+	// Setup this worker's command pool, pools can't take allocations from several threads
 	VkCommandPoolCreateInfo commandPoolCreateInfo2 = vk2dInitCommandPoolCreateInfo(dev->pd->QueueFamily.graphicsFamily, VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT);
-	vk2dErrorCheck(vkCreateCommandPool(dev->dev, &commandPoolCreateInfo2, VK_NULL_HANDLE, &dev->loadPool));
+	vk2dErrorCheck(vkCreateCommandPool(dev->dev, &commandPoolCreateInfo2, VK_NULL_HANDLE, &dev->loadPools[threadIndex]));
+	SDL_TLSSet(dev->loadPoolTLS, &dev->loadPools[threadIndex], NULL);
 
 	while (!dev->quitThread) {
 		if (dev->loads > 0) {
 			// Find an asset to load
 			VK2DAssetLoad asset = {0};
 			int spot = -1;
-			bool found = false;
 			SDL_LockMutex(dev->loadListMutex);
-			for (int i = 0; i < dev->loadListSize && !found; i++) {
+
+			// Models can only start once every texture is done because they reference them
+			bool texturesRemain = false;
+			for (int i = 0; i < dev->loadListSize; i++)
+				if (dev->loadList[i].state != VK2D_ASSET_TYPE_NONE && dev->loadList[i].type != VK2D_ASSET_TYPE_MODEL_FILE && dev->loadList[i].type != VK2D_ASSET_TYPE_MODEL_MEMORY)
+					texturesRemain = true;
+			for (int i = 0; i < dev->loadListSize && spot == -1; i++) {
 				if (dev->loadList[i].state == VK2D_ASSET_TYPE_ASSET) {
-					spot = i;
-					// This ensures that models will always be prioritized last
-					if (dev->loadList[i].type != VK2D_ASSET_TYPE_MODEL_FILE && dev->loadList[i].type != VK2D_ASSET_TYPE_MODEL_MEMORY)
-						found = true;
+					bool isModel = dev->loadList[i].type == VK2D_ASSET_TYPE_MODEL_FILE || dev->loadList[i].type == VK2D_ASSET_TYPE_MODEL_MEMORY;
+					if (!isModel || !texturesRemain)
+						spot = i;
 				}
 			}
 
 			// Remove this asset from the list kinda
-			dev->loadList[spot].state = VK2D_ASSET_TYPE_PENDING;
-			memcpy(&asset, &dev->loadList[spot], sizeof(VK2DAssetLoad));
-
-			dev->loads -= 1;
+			if (spot != -1) {
+				dev->loadList[spot].state = VK2D_ASSET_TYPE_PENDING;
+				memcpy(&asset, &dev->loadList[spot], sizeof(VK2DAssetLoad));
+				dev->loads -= 1;
+				dev->loadsInProgress += 1;
+			}
 			SDL_UnlockMutex(dev->loadListMutex);
 
+			// Only models are left and other workers are still on their textures
+			if (spot == -1)
+				continue;
+
 			// Now we load the asset based on its type
 			if (asset.type == VK2D_ASSET_TYPE_TEXTURE_FILE) {
 				uint32_t size;
-				uint8_t *fileData = _vk2dLoadFile(asset.Load.filename, &size);
+				void *mapping;
+				uint8_t *fileData = _vk2dMapFile(asset.Load.filename, &size, &mapping);
 				*asset.Output.texture = _vk2dTextureFromInternal(fileData, size, false);
 				if (*asset.Output.texture == NULL)
 					vk2dLogMessage("Failed to load texture \"%s\".", asset.Load.filename);
-				free(data);
+				_vk2dUnmapFile(fileData, mapping);
 			} else if (asset.type == VK2D_ASSET_TYPE_TEXTURE_MEMORY) {
 				*asset.Output.texture = _vk2dTextureFromInternal(asset.Load.data, asset.Load.size, false);
 				if (*asset.Output.texture == NULL)
 					vk2dLogMessage("Failed to load texture from buffer.");
 			} else if (asset.type == VK2D_ASSET_TYPE_MODEL_FILE) {
 				uint32_t size;
-				uint8_t *fileData = _vk2dLoadFile(asset.Load.filename, &size);
+				void *mapping;
+				uint8_t *fileData = _vk2dMapFile(asset.Load.filename, &size, &mapping);
 				*asset.Output.model = _vk2dModelFromInternal(fileData, size, *asset.Data.Model.tex, false);
 				if (*asset.Output.model == NULL)
 					vk2dLogMessage("Failed to load model \"%s\".", asset.Load.filename);
-				free(data);
+				_vk2dUnmapFile(fileData, mapping);
 			} else if (asset.type == VK2D_ASSET_TYPE_MODEL_MEMORY) {
 				*asset.Output.model = _vk2dModelFromInternal(asset.Load.data, asset.Load.size, *asset.Data.Model.tex, false);
 				if (*asset.Output.model == NULL)
@@ -196,24 +307,49 @@ int _vk2dWorkerThread(void *data) {
 			} else if (asset.type == VK2D_ASSET_TYPE_SHADER_MEMORY) {
 				// Shaders are internally synchronized
 				*asset.Output.shader = vk2dShaderFrom(asset.Load.data, asset.Load.size, asset.Load.fragmentData, asset.Load.fragmentSize, asset.Data.Shader.uniformBufferSize);
+			} else if (asset.type == VK2D_ASSET_TYPE_TEXTURE_BUNDLE) {
+				uint32_t size;
+				const void *data = vk2dBundleGet(asset.Load.bundle, asset.Load.entryName, &size);
+				*asset.Output.texture = _vk2dTextureFromInternal((void*)data, size, false);
+				if (*asset.Output.texture == NULL)
+					vk2dLogMessage("Failed to load texture \"%s\" from bundle.", asset.Load.entryName);
+			} else if (asset.type == VK2D_ASSET_TYPE_MODEL_BUNDLE) {
+				uint32_t size;
+				const void *data = vk2dBundleGet(asset.Load.bundle, asset.Load.entryName, &size);
+				*asset.Output.model = _vk2dModelFromInternal(data, size, *asset.Data.Model.tex, false);
+				if (*asset.Output.model == NULL)
+					vk2dLogMessage("Failed to load model \"%s\" from bundle.", asset.Load.entryName);
+			} else if (asset.type == VK2D_ASSET_TYPE_SHADER_BUNDLE) {
+				// Shaders are internally synchronized, and vk2dShaderFrom copies the blobs
+				uint32_t vertSize, fragSize;
+				const void *vertData = vk2dBundleGet(asset.Load.bundle, asset.Load.entryName, &vertSize);
+				const void *fragData = vk2dBundleGet(asset.Load.bundle, asset.Load.fragmentEntryName, &fragSize);
+				*asset.Output.shader = vk2dShaderFrom((void*)vertData, vertSize, (void*)fragData, fragSize, asset.Data.Shader.uniformBufferSize);
+				if (*asset.Output.shader == NULL)
+					vk2dLogMessage("Failed to load shader \"%s\"/\"%s\" from bundle.", asset.Load.entryName, asset.Load.fragmentEntryName);
 			}
 
-			loaded++;
-			gLoadStatus = (float)loaded / (float)dev->loadListSize;
-		}
-
-		// Signify the end of loading
-		if (dev->loads == 0 && loaded > 0) {
+			// Mark the asset done - the last worker out closes the list
 			SDL_LockMutex(dev->loadListMutex);
-
-			dev->doneLoading = true;
-
-			// We now don't need the list anymore so we can delete it
-			free(dev->loadList);
-			dev->loadList = NULL;
-			dev->loads = 0;
-			dev->loadListSize = 0;
+			if (dev->loadList != NULL)
+				dev->loadList[spot].state = VK2D_ASSET_TYPE_NONE;
+			dev->loadsInProgress -= 1;
+			gAssetsLoaded += 1;
+			gLoadStatus = (float)gAssetsLoaded / (float)dev->loadListSize;
+
+			// Signify the end of loading
+			if (dev->loads == 0 && dev->loadsInProgress == 0) {
+				dev->doneLoading = true;
+
+				// We now don't need the list anymore so we can delete it
+				free(dev->loadList);
+				dev->loadList = NULL;
+				dev->loadListSize = 0;
+			}
 			SDL_UnlockMutex(dev->loadListMutex);
+		} else if (dev->streamCount > 0) {
+			// Streamed textures ride the same workers, batch loads keep priority
+			_vk2dTextureStreamNext(dev);
 		}
 	}
 
@@ -228,6 +364,8 @@ void vk2dAssetsLoad(VK2DAssetLoad *assets, uint32_t count) {
 		return;
 
 	dev->doneLoading = false;
+	gAssetsLoaded = 0;
+	gLoadStatus = 0;
 	SDL_LockMutex(dev->loadListMutex);
 	dev->loadListSize = count;
 	dev->loads = count;
@@ -255,11 +393,11 @@ float vk2dAssetsLoadStatus() {
 void vk2dAssetsFree(VK2DAssetLoad *assets, uint32_t count) {
 	vk2dRendererWait();
 	for (int i = 0; i < count; i++) {
-		if (assets[i].type == VK2D_ASSET_TYPE_TEXTURE_FILE || assets[i].type == VK2D_ASSET_TYPE_TEXTURE_MEMORY)
+		if (assets[i].type == VK2D_ASSET_TYPE_TEXTURE_FILE || assets[i].type == VK2D_ASSET_TYPE_TEXTURE_MEMORY || assets[i].type == VK2D_ASSET_TYPE_TEXTURE_BUNDLE)
 			vk2dTextureFree(*assets[i].Output.texture);
-		else if (assets[i].type == VK2D_ASSET_TYPE_SHADER_FILE || assets[i].type == VK2D_ASSET_TYPE_SHADER_MEMORY)
+		else if (assets[i].type == VK2D_ASSET_TYPE_SHADER_FILE || assets[i].type == VK2D_ASSET_TYPE_SHADER_MEMORY || assets[i].type == VK2D_ASSET_TYPE_SHADER_BUNDLE)
 			vk2dShaderFree(*assets[i].Output.shader);
-		else if (assets[i].type == VK2D_ASSET_TYPE_MODEL_FILE || assets[i].type == VK2D_ASSET_TYPE_MODEL_MEMORY)
+		else if (assets[i].type == VK2D_ASSET_TYPE_MODEL_FILE || assets[i].type == VK2D_ASSET_TYPE_MODEL_MEMORY || assets[i].type == VK2D_ASSET_TYPE_MODEL_BUNDLE)
 			vk2dModelFree(*assets[i].Output.model);
 	}
 }
\ No newline at end of file
@@ -30,6 +30,14 @@ bool _vk2dFileExists(const char *filename);
 /// \brief Loads a file into a buffer and returns it (as well as its size)
 unsigned char* _vk2dLoadFile(const char *filename, uint32_t *size);
 
+/// \brief Maps a file into memory read-only so large assets stream from the page cache
+/// without a heap copy, falling back to _vk2dLoadFile when mapping is unavailable -
+/// `mapping` receives an opaque handle that must be given back to _vk2dUnmapFile
+unsigned char* _vk2dMapFile(const char *filename, uint32_t *size, void **mapping);
+
+/// \brief Releases a file returned from _vk2dMapFile
+void _vk2dUnmapFile(unsigned char *data, void *mapping);
+
 /// \brief Copies a string
 unsigned char *_vk2dCopyBuffer(void *buffer, int size);
 
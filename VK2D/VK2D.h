@@ -6,7 +6,15 @@
 #include "VK2D/Renderer.h"
 #include "VK2D/Polygon.h"
 #include "VK2D/Texture.h"
+#include "VK2D/Atlas.h"
+#include "VK2D/Bundle.h"
 #include "VK2D/Image.h"
 #include "VK2D/Shader.h"
+#include "VK2D/Compute.h"
+#include "VK2D/Particles.h"
+#include "VK2D/DrawList.h"
+#include "VK2D/Tilemap.h"
+#include "VK2D/Font.h"
+#include "VK2D/SpatialMap.h"
 #include "VK2D/Model.h"
 #include "VK2D/Camera.h"
\ No newline at end of file
@@ -1,96 +1,203 @@
-/// \file Validation.c
-/// \author Paolo Mazzon
-#include "VK2D/Validation.h"
-#include <stdio.h>
-#include <inttypes.h>
-#include <stdarg.h>
-#include <assert.h>
-#include "VK2D/Renderer.h"
-#include "VK2D/Opaque.h"
-
-static SDL_mutex *gLogMutex = NULL;
-
-void vk2dValidationBegin() {
-	gLogMutex = SDL_CreateMutex();
-}
-
-void vk2dValidationEnd() {
-	SDL_DestroyMutex(gLogMutex);
-}
-
-bool _vk2dErrorRaise(VkResult result, const char* function, int line, const char* varname) {
-	VK2DRenderer gRenderer = vk2dRendererGetPointer();
-	fprintf(stderr, "[VK2D]: Error %i occurred in function \"%s\" line %i: %s\n", result, function, line, varname);
-	fflush(stderr);
-	if (gRenderer->options.errorFile != NULL) {
-		FILE *file = fopen(gRenderer->options.errorFile, "a");
-		fprintf(file, "[VK2D]: Error %i occurred in function \"%s\" line %i: %s\n", result, function, line, varname);
-		fclose(file);
-	}
-	if (gRenderer->options.quitOnError)
-		abort();
-	return false;
-}
-
-bool _vk2dPointerCheck(void* ptr, const char* function, int line, const char* varname) {
-	VK2DRenderer gRenderer = vk2dRendererGetPointer();
-	if (ptr == NULL) {
-		fprintf(stderr, "[VK2D]: Pointer check failed for \"%s\" in function \"%s\" on line %i\n", varname, function, line);
-		fflush(stderr);
-		if (gRenderer->options.errorFile != NULL) {
-			FILE *file = fopen(gRenderer->options.errorFile, "a");
-			fprintf(file, "[VK2D]: Pointer check failed for \"%s\" in function \"%s\" on line %i\n", varname, function,
-					line);
-			fclose(file);
-		}
-		if (gRenderer->options.quitOnError)
-			abort();
-	}
-	return 1;
-}
-
-void vk2dLogMessage(const char* fmt, ...) {
-	VK2DRenderer gRenderer = vk2dRendererGetPointer();
-	if (gRenderer->options.stdoutLogging) {
-		va_list list;
-		va_start(list, fmt);
-		SDL_LockMutex(gLogMutex);
-		vprintf(fmt, list);
-		printf("\n");
-		fflush(stdout);
-		SDL_UnlockMutex(gLogMutex);
-		va_end(list);
-	} else {
-		va_list list;
-		va_start(list, fmt);
-		va_end(list);
-	}
-}
-
-VKAPI_ATTR VkBool32 VKAPI_CALL _vk2dDebugCallback(VkDebugReportFlagsEXT flags, VkDebugReportObjectTypeEXT objectType, uint64_t sourceObject, size_t location, int32_t messageCode, const char* layerPrefix, const char* message, void* data) {
-	VK2DRenderer gRenderer = vk2dRendererGetPointer();
-	char firstHalf[1000];
-	FILE* output;
-	if (flags & VK_DEBUG_REPORT_ERROR_BIT_EXT)
-		output = stderr;
-	else
-		output = stdout;
-	snprintf(firstHalf, 999, "%s", layerPrefix);
-	fprintf(output, "%s\n", firstHalf);
-	for (int i = 0; i < strlen(firstHalf); i++)
-		fprintf(output, "-");
-	fprintf(output, "\n%s\n", message);
-	fflush(output);
-	if (gRenderer->options.errorFile != NULL) {
-		FILE *file = fopen(gRenderer->options.errorFile, "a");
-		fprintf(file, "%s\n", firstHalf);
-		for (int i = 0; i < strlen(firstHalf); i++)
-			fprintf(file, "-");
-		fprintf(file, "\n%s\n", message);
-		fclose(file);
-	}
-	if (gRenderer->options.quitOnError)
-		if (flags & VK_DEBUG_REPORT_ERROR_BIT_EXT)
-			abort();
-	return false;
-}
\ No newline at end of file
+/// \file Validation.c
+/// \author Paolo Mazzon
+#include "VK2D/Validation.h"
+#include <stdio.h>
+#include <inttypes.h>
+#include <stdarg.h>
+#include <assert.h>
+#include "VK2D/Renderer.h"
+#include "VK2D/Opaque.h"
+
+// Log messages are preformatted into fixed ring slots by whichever thread produces them
+// and a background thread drains the ring to stdout/the error file, so the hot path of
+// vk2dLogMessage is a vsnprintf and a couple of atomic operations instead of blocking on
+// console and file I/O. Error paths stay synchronous - they flush the ring first so
+// everything appears in order, and they must not lose output before a potential abort.
+#define VK2D_LOG_RING_SIZE 256
+#define VK2D_LOG_RECORD_SIZE 512
+
+typedef struct VK2DLogRecord {
+	char text[VK2D_LOG_RECORD_SIZE]; ///< Preformatted message, newline included
+	bool toFile;                     ///< Mirror this record to the error file as well
+	_Atomic(bool) ready;             ///< Producer sets this last, the drain thread clears it
+} VK2DLogRecord;
+
+static VK2DLogRecord gLogRing[VK2D_LOG_RING_SIZE];
+static _Atomic(uint64_t) gLogHead = 0; ///< Next slot producers will claim
+static _Atomic(uint64_t) gLogTail = 0; ///< Next slot the drain thread will read, only it advances this
+static _Atomic(bool) gLogQuit = false;
+static SDL_Thread *gLogThread = NULL;
+static SDL_mutex *gLogMutex = NULL; ///< Serializes the synchronous error writes
+
+// Writes a drained record to its destinations
+static void _vk2dLogWriteRecord(VK2DLogRecord *record) {
+	VK2DRenderer gRenderer = vk2dRendererGetPointer();
+	fputs(record->text, stdout);
+	if (record->toFile && gRenderer != NULL && gRenderer->options.errorFile != NULL) {
+		FILE *file = fopen(gRenderer->options.errorFile, "a");
+		if (file != NULL) {
+			fputs(record->text, file);
+			fclose(file);
+		}
+	}
+}
+
+static int _vk2dLogThread(void *data) {
+	while (true) {
+		if (gLogTail != gLogHead) {
+			VK2DLogRecord *record = &gLogRing[gLogTail % VK2D_LOG_RING_SIZE];
+			if (!record->ready) {
+				// Claimed but not yet written, give the producer a moment
+				SDL_Delay(1);
+				continue;
+			}
+			_vk2dLogWriteRecord(record);
+			record->ready = false;
+			gLogTail += 1;
+		} else if (gLogQuit) {
+			break;
+		} else {
+			SDL_Delay(1);
+		}
+	}
+	fflush(stdout);
+	return 0;
+}
+
+// Claims a ring slot and publishes a preformatted message into it
+static void _vk2dLogEnqueue(const char *text, bool toFile) {
+	uint64_t slot = gLogHead++;
+	VK2DLogRecord *record = &gLogRing[slot % VK2D_LOG_RING_SIZE];
+
+	// If producers have lapped the drain thread wait for the slot to free up
+	while (record->ready)
+		SDL_Delay(1);
+
+	snprintf(record->text, VK2D_LOG_RECORD_SIZE, "%s", text);
+	record->toFile = toFile;
+	record->ready = true;
+}
+
+// Blocks until the drain thread has caught up, used before synchronous error output so
+// records never appear out of order (and nothing is lost if the error aborts)
+static void _vk2dLogDrain() {
+	while (gLogThread != NULL && gLogTail != gLogHead)
+		SDL_Delay(1);
+	fflush(stdout);
+}
+
+void vk2dValidationBegin() {
+	gLogMutex = SDL_CreateMutex();
+	gLogQuit = false;
+	gLogThread = SDL_CreateThread(_vk2dLogThread, "VK2D_Log", NULL);
+}
+
+void vk2dValidationEnd() {
+	if (gLogThread != NULL) {
+		gLogQuit = true;
+		SDL_WaitThread(gLogThread, NULL);
+		gLogThread = NULL;
+	}
+	SDL_DestroyMutex(gLogMutex);
+	gLogMutex = NULL;
+}
+
+bool _vk2dErrorRaise(VkResult result, const char* function, int line, const char* varname) {
+	VK2DRenderer gRenderer = vk2dRendererGetPointer();
+	_vk2dLogDrain();
+	SDL_LockMutex(gLogMutex);
+	fprintf(stderr, "[VK2D]: Error %i occurred in function \"%s\" line %i: %s\n", result, function, line, varname);
+	fflush(stderr);
+	if (gRenderer->options.errorFile != NULL) {
+		FILE *file = fopen(gRenderer->options.errorFile, "a");
+		fprintf(file, "[VK2D]: Error %i occurred in function \"%s\" line %i: %s\n", result, function, line, varname);
+		fclose(file);
+	}
+	SDL_UnlockMutex(gLogMutex);
+	if (gRenderer->options.quitOnError)
+		abort();
+	return false;
+}
+
+bool _vk2dPointerCheck(void* ptr, const char* function, int line, const char* varname) {
+	VK2DRenderer gRenderer = vk2dRendererGetPointer();
+	if (ptr == NULL) {
+		_vk2dLogDrain();
+		SDL_LockMutex(gLogMutex);
+		fprintf(stderr, "[VK2D]: Pointer check failed for \"%s\" in function \"%s\" on line %i\n", varname, function, line);
+		fflush(stderr);
+		if (gRenderer->options.errorFile != NULL) {
+			FILE *file = fopen(gRenderer->options.errorFile, "a");
+			fprintf(file, "[VK2D]: Pointer check failed for \"%s\" in function \"%s\" on line %i\n", varname, function,
+					line);
+			fclose(file);
+		}
+		SDL_UnlockMutex(gLogMutex);
+		if (gRenderer->options.quitOnError)
+			abort();
+	}
+	return 1;
+}
+
+void vk2dLogMessage(const char* fmt, ...) {
+	VK2DRenderer gRenderer = vk2dRendererGetPointer();
+	if (gRenderer != NULL && gRenderer->options.stdoutLogging) {
+		char buffer[VK2D_LOG_RECORD_SIZE];
+		va_list list;
+		va_start(list, fmt);
+		int length = vsnprintf(buffer, VK2D_LOG_RECORD_SIZE - 2, fmt, list);
+		va_end(list);
+		if (length < 0)
+			return;
+		if (length > VK2D_LOG_RECORD_SIZE - 2)
+			length = VK2D_LOG_RECORD_SIZE - 2;
+		buffer[length] = '\n';
+		buffer[length + 1] = 0;
+		_vk2dLogEnqueue(buffer, false);
+	} else {
+		va_list list;
+		va_start(list, fmt);
+		va_end(list);
+	}
+}
+
+VKAPI_ATTR VkBool32 VKAPI_CALL _vk2dDebugCallback(VkDebugReportFlagsEXT flags, VkDebugReportObjectTypeEXT objectType, uint64_t sourceObject, size_t location, int32_t messageCode, const char* layerPrefix, const char* message, void* data) {
+	VK2DRenderer gRenderer = vk2dRendererGetPointer();
+	char firstHalf[1000];
+	snprintf(firstHalf, 999, "%s", layerPrefix);
+
+	if (flags & VK_DEBUG_REPORT_ERROR_BIT_EXT) {
+		// Errors write synchronously so nothing is lost if quitOnError aborts below
+		_vk2dLogDrain();
+		SDL_LockMutex(gLogMutex);
+		fprintf(stderr, "%s\n", firstHalf);
+		for (int i = 0; i < strlen(firstHalf); i++)
+			fprintf(stderr, "-");
+		fprintf(stderr, "\n%s\n", message);
+		fflush(stderr);
+		if (gRenderer->options.errorFile != NULL) {
+			FILE *file = fopen(gRenderer->options.errorFile, "a");
+			fprintf(file, "%s\n", firstHalf);
+			for (int i = 0; i < strlen(firstHalf); i++)
+				fprintf(file, "-");
+			fprintf(file, "\n%s\n", message);
+			fclose(file);
+		}
+		SDL_UnlockMutex(gLogMutex);
+		if (gRenderer->options.quitOnError)
+			abort();
+	} else {
+		// Informational validation output can fire mid-frame, it rides the ring instead of
+		// stalling the frame on console I/O
+		char buffer[VK2D_LOG_RECORD_SIZE];
+		char dashes[sizeof(firstHalf)];
+		size_t prefixLength = strlen(firstHalf);
+		if (prefixLength > sizeof(dashes) - 1)
+			prefixLength = sizeof(dashes) - 1;
+		memset(dashes, '-', prefixLength);
+		dashes[prefixLength] = 0;
+		snprintf(buffer, VK2D_LOG_RECORD_SIZE, "%s\n%s\n%s\n", firstHalf, dashes, message);
+		_vk2dLogEnqueue(buffer, gRenderer->options.errorFile != NULL);
+	}
+	return false;
+}
@@ -64,7 +64,8 @@ uint32_t vk2dVulkanGetSwapchainImageCount() {
 }
 
 uint32_t vk2dVulkanGetMaxFramesInFlight() {
-	return VK2D_MAX_FRAMES_IN_FLIGHT;
+	VK2DRenderer gRenderer = vk2dRendererGetPointer();
+	return gRenderer->framesInFlight;
 }
 
 VmaAllocator vk2dVulkanGetVMA() {
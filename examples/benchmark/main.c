@@ -0,0 +1,213 @@
+#define SDL_MAIN_HANDLED
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+#include "VK2D/VK2D.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/************************ Constants ************************/
+const int SURFACE_WIDTH = 1280;
+const int SURFACE_HEIGHT = 720;
+const int DEFAULT_FRAMES = 500;
+const int TEXTURE_DRAWS = 2000;  // Single-texture draws per frame
+const int INSTANCE_COUNT = 10000; // Instances per instanced draw
+const int SHAPE_COUNT = 1000;     // Each of rectangles/circles/lines per frame
+const int TARGET_SWITCHES = 20;   // Target round trips per frame
+const int LOADS_PER_FRAME = 4;    // Texture loads per frame in the asset scene
+const char *CAVEGUY = "assets/caveguy.png";
+
+/************************ Scenes ************************/
+
+// Assets shared between a scene's setup/frame/cleanup
+static VK2DTexture gTexture = NULL;
+static VK2DTexture gTarget = NULL;
+static VK2DDrawInstance *gInstances = NULL;
+
+// Deterministic positions so every run draws the same frames
+static uint32_t gSeed = 1;
+static float benchRandom(float min, float max) {
+	gSeed = gSeed * 1103515245 + 12345;
+	return min + ((max - min) * ((gSeed >> 16) & 0x7fff) / 32767.0f);
+}
+
+static void textureSetup() {
+	gSeed = 1;
+	gTexture = vk2dTextureLoad(CAVEGUY);
+}
+
+static void textureFrame(int frameIndex) {
+	for (int i = 0; i < TEXTURE_DRAWS; i++)
+		vk2dDrawTexture(gTexture, benchRandom(0, SURFACE_WIDTH), benchRandom(0, SURFACE_HEIGHT));
+}
+
+static void textureCleanup() {
+	vk2dTextureFree(gTexture);
+	gTexture = NULL;
+}
+
+static void instancedSetup() {
+	gSeed = 1;
+	gTexture = vk2dTextureLoad(CAVEGUY);
+	gInstances = malloc(sizeof(VK2DDrawInstance) * INSTANCE_COUNT);
+	vec4 colour = {1, 1, 1, 1};
+	for (int i = 0; i < INSTANCE_COUNT; i++)
+		vk2dInstanceSetFast(&gInstances[i], benchRandom(0, SURFACE_WIDTH), benchRandom(0, SURFACE_HEIGHT), 0, 0,
+							vk2dTextureWidth(gTexture), vk2dTextureHeight(gTexture), colour);
+}
+
+static void instancedFrame(int frameIndex) {
+	vk2dRendererDrawInstanced(gTexture, gInstances, INSTANCE_COUNT);
+}
+
+static void instancedCleanup() {
+	vk2dTextureFree(gTexture);
+	free(gInstances);
+	gTexture = NULL;
+	gInstances = NULL;
+}
+
+static void targetsSetup() {
+	gSeed = 1;
+	gTexture = vk2dTextureLoad(CAVEGUY);
+	gTarget = vk2dTextureCreate(256, 256);
+}
+
+static void targetsFrame(int frameIndex) {
+	vec4 clear = {0, 0, 0, 1};
+	for (int i = 0; i < TARGET_SWITCHES; i++) {
+		vk2dRendererSetTarget(gTarget);
+		vk2dRendererSetColourMod(clear);
+		vk2dRendererClear();
+		vk2dRendererSetColourMod(VK2D_DEFAULT_COLOUR_MOD);
+		for (int j = 0; j < 10; j++)
+			vk2dDrawTexture(gTexture, benchRandom(0, 256), benchRandom(0, 256));
+		vk2dRendererSetTarget(VK2D_TARGET_SCREEN);
+		vk2dDrawTexture(gTarget, benchRandom(0, SURFACE_WIDTH), benchRandom(0, SURFACE_HEIGHT));
+	}
+}
+
+static void targetsCleanup() {
+	vk2dTextureFree(gTexture);
+	vk2dTextureFree(gTarget);
+	gTexture = NULL;
+	gTarget = NULL;
+}
+
+static void shapesSetup() {
+	gSeed = 1;
+}
+
+static void shapesFrame(int frameIndex) {
+	for (int i = 0; i < SHAPE_COUNT; i++)
+		vk2dRendererDrawRectangle(benchRandom(0, SURFACE_WIDTH), benchRandom(0, SURFACE_HEIGHT), 32, 32, 0, 0, 0);
+	for (int i = 0; i < SHAPE_COUNT; i++)
+		vk2dRendererDrawCircle(benchRandom(0, SURFACE_WIDTH), benchRandom(0, SURFACE_HEIGHT), 16);
+	for (int i = 0; i < SHAPE_COUNT; i++)
+		vk2dRendererDrawLine(benchRandom(0, SURFACE_WIDTH), benchRandom(0, SURFACE_HEIGHT),
+							 benchRandom(0, SURFACE_WIDTH), benchRandom(0, SURFACE_HEIGHT));
+}
+
+static void shapesCleanup() {}
+
+static void assetLoadSetup() {}
+
+static void assetLoadFrame(int frameIndex) {
+	// Decode + upload + deferred free, the cost a streaming system pays mid-game
+	VK2DTexture textures[LOADS_PER_FRAME];
+	for (int i = 0; i < LOADS_PER_FRAME; i++)
+		textures[i] = vk2dTextureLoad(CAVEGUY);
+	for (int i = 0; i < LOADS_PER_FRAME; i++) {
+		vk2dDrawTexture(textures[i], i * 32.0f, 0);
+		vk2dTextureFree(textures[i]);
+	}
+}
+
+static void assetLoadCleanup() {}
+
+typedef struct Scene {
+	const char *name;
+	void (*setup)();
+	void (*frame)(int frameIndex);
+	void (*cleanup)();
+} Scene;
+
+static const Scene SCENES[] = {
+		{"texture", textureSetup, textureFrame, textureCleanup},
+		{"instanced", instancedSetup, instancedFrame, instancedCleanup},
+		{"targets", targetsSetup, targetsFrame, targetsCleanup},
+		{"shapes", shapesSetup, shapesFrame, shapesCleanup},
+		{"assetload", assetLoadSetup, assetLoadFrame, assetLoadCleanup},
+};
+static const int SCENE_COUNT = sizeof(SCENES) / sizeof(Scene);
+
+/************************ Runner ************************/
+
+// Usage: vk2d-bench [frames] [output.csv]
+// Runs every scene headless for a fixed frame count and emits one CSV row per scene,
+// to stdout unless an output file is given.
+int main(int argc, const char *argv[]) {
+	int frames = argc > 1 ? atoi(argv[1]) : DEFAULT_FRAMES;
+	if (frames <= 0)
+		frames = DEFAULT_FRAMES;
+	FILE *out = argc > 2 ? fopen(argv[2], "w") : stdout;
+	if (out == NULL) {
+		fprintf(stderr, "Failed to open %s\n", argv[2]);
+		return -1;
+	}
+
+	// Initialize vk2d without a window, MSAA off so numbers compare across devices
+	VK2DRendererConfig config = {VK2D_MSAA_1X, VK2D_SCREEN_MODE_IMMEDIATE, VK2D_FILTER_TYPE_NEAREST};
+	VK2DStartupOptions options = {false, false, true, "vk2derror.txt", false};
+	if (vk2dRendererInitHeadless(config, &options, SURFACE_WIDTH, SURFACE_HEIGHT) < 0)
+		return -1;
+
+	VK2DCameraSpec defcam = {VK2D_CAMERA_TYPE_DEFAULT, 0, 0, SURFACE_WIDTH, SURFACE_HEIGHT, 1, 0};
+	vk2dRendererSetCamera(defcam);
+	vec4 clear = {0, 0, 0, 1};
+
+	fprintf(out, "scene,frames,cpu_avg_ms,cpu_min_ms,cpu_max_ms,avg_draw_calls,gpu_avg_ms\n");
+
+	for (int s = 0; s < SCENE_COUNT; s++) {
+		const Scene *scene = &SCENES[s];
+		scene->setup();
+
+		double cpuTotal = 0;
+		double cpuMin = 0;
+		double cpuMax = 0;
+		uint64_t drawCalls = 0;
+		double gpuTotal = 0;
+		int gpuSamples = 0;
+
+		for (int f = 0; f < frames; f++) {
+			double start = (double)SDL_GetPerformanceCounter();
+			vk2dRendererStartFrame(clear);
+			scene->frame(f);
+			vk2dRendererEndFrame();
+			double ms = ((double)SDL_GetPerformanceCounter() - start) * 1000 / (double)SDL_GetPerformanceFrequency();
+
+			cpuTotal += ms;
+			if (f == 0 || ms < cpuMin)
+				cpuMin = ms;
+			if (ms > cpuMax)
+				cpuMax = ms;
+			drawCalls += vk2dRendererGetFrameStats().drawCalls;
+
+			// GPU timings lag a few frames behind and are zero until the first one retires
+			VK2DGpuProfile gpu = vk2dRendererGetGpuProfile();
+			if (gpu.frameTimeMS > 0) {
+				gpuTotal += gpu.frameTimeMS;
+				gpuSamples++;
+			}
+		}
+
+		scene->cleanup();
+		fprintf(out, "%s,%i,%.4f,%.4f,%.4f,%.1f,%.4f\n", scene->name, frames, cpuTotal / frames, cpuMin, cpuMax,
+				(double)drawCalls / frames, gpuSamples > 0 ? gpuTotal / gpuSamples : 0);
+	}
+
+	if (out != stdout)
+		fclose(out);
+	vk2dRendererQuit();
+	return 0;
+}